@@ -0,0 +1,190 @@
+#include "OmniCaptureCubemapKernels.h"
+
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    // Guards zero-length directions against a division by zero.
+    constexpr float MinMajorAxis = 1.e-8f;
+
+    struct FSeamTransform
+    {
+        float Scale = 1.0f;
+        float Bias = 0.0f;
+        float TexelScale = 0.0f;
+    };
+
+    FSeamTransform MakeSeamTransform(int32 FaceResolution, float SeamStrength)
+    {
+        const float Resolution = static_cast<float>(FMath::Max(1, FaceResolution));
+
+        FSeamTransform Transform;
+        Transform.Scale = FMath::Lerp(1.0f, (Resolution - 1.0f) / Resolution, SeamStrength);
+        Transform.Bias = (0.5f / Resolution) * SeamStrength;
+        Transform.TexelScale = Resolution - 1.0f;
+        return Transform;
+    }
+
+    // Major-axis selection. X wins ties against Y and Z, Y wins ties against Z.
+    FORCEINLINE uint32 SelectFace(float X, float Y, float Z, float& OutU, float& OutV, float& OutMajorAxis)
+    {
+        const float AbsX = FMath::Abs(X);
+        const float AbsY = FMath::Abs(Y);
+        const float AbsZ = FMath::Abs(Z);
+
+        uint32 FaceIndex = 0;
+        if (AbsX >= AbsY && AbsX >= AbsZ)
+        {
+            OutMajorAxis = AbsX;
+            FaceIndex = X > 0.0f ? 0 : 1;
+            OutU = X > 0.0f ? -Z : Z;
+            OutV = Y;
+        }
+        else if (AbsY >= AbsZ)
+        {
+            OutMajorAxis = AbsY;
+            FaceIndex = Y > 0.0f ? 2 : 3;
+            OutU = X;
+            OutV = Y > 0.0f ? -Z : Z;
+        }
+        else
+        {
+            OutMajorAxis = AbsZ;
+            FaceIndex = Z > 0.0f ? 4 : 5;
+            OutU = Z > 0.0f ? X : -X;
+            OutV = Y;
+        }
+
+        OutMajorAxis = FMath::Max(OutMajorAxis, MinMajorAxis);
+        return FaceIndex;
+    }
+
+    // The UV remap is split into separate statements so the compiler cannot contract
+    // it into FMAs that the vector path would not use.
+    FORCEINLINE float ResolveFaceCoordinate(float Coordinate, float MajorAxis, const FSeamTransform& Seam)
+    {
+        float UV = Coordinate / MajorAxis;
+        UV = (UV + 1.0f) * 0.5f;
+        UV = UV * Seam.Scale;
+        UV = UV + Seam.Bias;
+        return FMath::Clamp(UV, 0.0f, 1.0f);
+    }
+
+    FORCEINLINE uint32 ResolveTexelCoordinate(float Coordinate, float MajorAxis, const FSeamTransform& Seam)
+    {
+        return static_cast<uint32>(static_cast<int32>(ResolveFaceCoordinate(Coordinate, MajorAxis, Seam) * Seam.TexelScale));
+    }
+}
+
+bool FOmniCaptureCubemapKernels::SupportsFaceResolution(int32 FaceResolution)
+{
+    return FaceResolution > 0 && static_cast<int64>(FaceResolution) * FaceResolution <= static_cast<int64>(TexelMask) + 1;
+}
+
+uint32 FOmniCaptureCubemapKernels::LookupTexelScalar(float X, float Y, float Z, int32 FaceResolution, float SeamStrength)
+{
+    const FSeamTransform Seam = MakeSeamTransform(FaceResolution, SeamStrength);
+
+    float U = 0.0f;
+    float V = 0.0f;
+    float MajorAxis = 0.0f;
+    const uint32 FaceIndex = SelectFace(X, Y, Z, U, V, MajorAxis);
+
+    const uint32 TexelX = ResolveTexelCoordinate(U, MajorAxis, Seam);
+    const uint32 TexelY = ResolveTexelCoordinate(V, MajorAxis, Seam);
+    return PackSample(FaceIndex, TexelY * static_cast<uint32>(FaceResolution) + TexelX);
+}
+
+uint32 FOmniCaptureCubemapKernels::ProjectToFaceScalar(float X, float Y, float Z, int32 FaceResolution, float SeamStrength, float& OutU, float& OutV)
+{
+    const FSeamTransform Seam = MakeSeamTransform(FaceResolution, SeamStrength);
+
+    float U = 0.0f;
+    float V = 0.0f;
+    float MajorAxis = 0.0f;
+    const uint32 FaceIndex = SelectFace(X, Y, Z, U, V, MajorAxis);
+
+    OutU = ResolveFaceCoordinate(U, MajorAxis, Seam);
+    OutV = ResolveFaceCoordinate(V, MajorAxis, Seam);
+    return FaceIndex;
+}
+
+void FOmniCaptureCubemapKernels::LookupTexels(const float* DirX, const float* DirY, const float* DirZ, int32 Count, int32 FaceResolution, float SeamStrength, uint32* OutSamples)
+{
+    const FSeamTransform Seam = MakeSeamTransform(FaceResolution, SeamStrength);
+
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+    const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+    const VectorRegister4Float SeamScale = VectorSetFloat1(Seam.Scale);
+    const VectorRegister4Float SeamBias = VectorSetFloat1(Seam.Bias);
+    const VectorRegister4Float TexelScale = VectorSetFloat1(Seam.TexelScale);
+    const VectorRegister4Float MinAxis = VectorSetFloat1(MinMajorAxis);
+
+    int32 Index = 0;
+    for (; Index + 4 <= Count; Index += 4)
+    {
+        const VectorRegister4Float X = VectorLoad(DirX + Index);
+        const VectorRegister4Float Y = VectorLoad(DirY + Index);
+        const VectorRegister4Float Z = VectorLoad(DirZ + Index);
+        const VectorRegister4Float NegX = VectorNegate(X);
+        const VectorRegister4Float NegZ = VectorNegate(Z);
+
+        const VectorRegister4Float AbsX = VectorAbs(X);
+        const VectorRegister4Float AbsY = VectorAbs(Y);
+        const VectorRegister4Float AbsZ = VectorAbs(Z);
+
+        // Branchless major-axis selection with the same tie-breaking as the scalar path:
+        // X wins ties against Y and Z, Y wins ties against Z.
+        const VectorRegister4Float XMajor = VectorBitwiseAnd(VectorCompareGE(AbsX, AbsY), VectorCompareGE(AbsX, AbsZ));
+        const VectorRegister4Float YMajor = VectorCompareGE(AbsY, AbsZ);
+
+        const VectorRegister4Float XPositive = VectorCompareGT(X, Zero);
+        const VectorRegister4Float YPositive = VectorCompareGT(Y, Zero);
+        const VectorRegister4Float ZPositive = VectorCompareGT(Z, Zero);
+
+        const VectorRegister4Float FaceX = VectorSelect(XPositive, VectorSetFloat1(0.0f), VectorSetFloat1(1.0f));
+        const VectorRegister4Float FaceY = VectorSelect(YPositive, VectorSetFloat1(2.0f), VectorSetFloat1(3.0f));
+        const VectorRegister4Float FaceZ = VectorSelect(ZPositive, VectorSetFloat1(4.0f), VectorSetFloat1(5.0f));
+
+        const VectorRegister4Float UFaceX = VectorSelect(XPositive, NegZ, Z);
+        const VectorRegister4Float VFaceY = VectorSelect(YPositive, NegZ, Z);
+        const VectorRegister4Float UFaceZ = VectorSelect(ZPositive, X, NegX);
+
+        VectorRegister4Float U = VectorSelect(XMajor, UFaceX, VectorSelect(YMajor, X, UFaceZ));
+        VectorRegister4Float V = VectorSelect(XMajor, Y, VectorSelect(YMajor, VFaceY, Y));
+        VectorRegister4Float MajorAxis = VectorSelect(XMajor, AbsX, VectorSelect(YMajor, AbsY, AbsZ));
+        const VectorRegister4Float Face = VectorSelect(XMajor, FaceX, VectorSelect(YMajor, FaceY, FaceZ));
+
+        MajorAxis = VectorMax(MajorAxis, MinAxis);
+
+        U = VectorDivide(U, MajorAxis);
+        V = VectorDivide(V, MajorAxis);
+        U = VectorMultiply(VectorAdd(U, One), Half);
+        V = VectorMultiply(VectorAdd(V, One), Half);
+        U = VectorAdd(VectorMultiply(U, SeamScale), SeamBias);
+        V = VectorAdd(VectorMultiply(V, SeamScale), SeamBias);
+        U = VectorMin(VectorMax(U, Zero), One);
+        V = VectorMin(VectorMax(V, Zero), One);
+
+        // UV is clamped to [0, 1], so truncating UV * (Resolution - 1) already yields a valid texel.
+        int32 FaceLanes[4];
+        int32 TexelXLanes[4];
+        int32 TexelYLanes[4];
+        VectorIntStore(VectorFloatToInt(Face), FaceLanes);
+        VectorIntStore(VectorFloatToInt(VectorMultiply(U, TexelScale)), TexelXLanes);
+        VectorIntStore(VectorFloatToInt(VectorMultiply(V, TexelScale)), TexelYLanes);
+
+        for (int32 Lane = 0; Lane < 4; ++Lane)
+        {
+            OutSamples[Index + Lane] = PackSample(
+                static_cast<uint32>(FaceLanes[Lane]),
+                static_cast<uint32>(TexelYLanes[Lane]) * static_cast<uint32>(FaceResolution) + static_cast<uint32>(TexelXLanes[Lane]));
+        }
+    }
+
+    for (; Index < Count; ++Index)
+    {
+        OutSamples[Index] = LookupTexelScalar(DirX[Index], DirY[Index], DirZ[Index], FaceResolution, SeamStrength);
+    }
+}
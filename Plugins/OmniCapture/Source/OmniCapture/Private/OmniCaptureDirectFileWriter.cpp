@@ -0,0 +1,327 @@
+#include "OmniCaptureDirectFileWriter.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "Windows/PreWindowsApi.h"
+#include <windows.h>
+#include "Windows/PostWindowsApi.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+FOmniCaptureDirectFileWriter::FOmniCaptureDirectFileWriter()
+{
+    SetIsSaving(true);
+    SetIsPersistent(true);
+}
+
+FOmniCaptureDirectFileWriter::~FOmniCaptureDirectFileWriter()
+{
+    Close();
+    FMemory::Free(Block);
+    Block = nullptr;
+}
+
+bool FOmniCaptureDirectFileWriter::Open(const FString& InFilePath, int64 EstimatedSize, bool bUnbuffered)
+{
+    Close();
+    ClearError();
+    FilePath = InFilePath;
+    BlockUsed = 0;
+    FileOffset = 0;
+    TotalBytes = 0;
+
+    if (!OpenHandle(bUnbuffered, true))
+    {
+        SetError();
+        return false;
+    }
+
+    // Small files get a block their own size rather than the full staging block.
+    const int64 DesiredBlockBytes = EstimatedSize > 0
+        ? FMath::Clamp(Align(EstimatedSize, Alignment), Alignment, MaxBlockBytes)
+        : MaxBlockBytes;
+    if (!Block || BlockBytes != DesiredBlockBytes)
+    {
+        FMemory::Free(Block);
+        BlockBytes = DesiredBlockBytes;
+        Block = static_cast<uint8*>(FMemory::Malloc(BlockBytes, Alignment));
+    }
+
+    if (EstimatedSize > 0)
+    {
+        // Best effort: the file still grows with the writes if the volume cannot reserve space.
+        Preallocate(Align(EstimatedSize, Alignment));
+    }
+
+    bOpen = true;
+    return true;
+}
+
+bool FOmniCaptureDirectFileWriter::WriteFile(const FString& FilePath, const TArray64<uint8>& Data, bool bUnbuffered)
+{
+    FOmniCaptureDirectFileWriter Writer;
+    if (!Writer.Open(FilePath, Data.Num(), bUnbuffered))
+    {
+        return false;
+    }
+
+    Writer.Serialize(const_cast<uint8*>(Data.GetData()), Data.Num());
+    return Writer.Close();
+}
+
+void FOmniCaptureDirectFileWriter::Serialize(void* Data, int64 Length)
+{
+    if (!bOpen || IsError())
+    {
+        SetError();
+        return;
+    }
+
+    const uint8* Source = static_cast<const uint8*>(Data);
+    while (Length > 0)
+    {
+        const int64 CopyBytes = FMath::Min(Length, BlockBytes - BlockUsed);
+        FMemory::Memcpy(Block + BlockUsed, Source, CopyBytes);
+        BlockUsed += CopyBytes;
+        TotalBytes += CopyBytes;
+        Source += CopyBytes;
+        Length -= CopyBytes;
+
+        if (BlockUsed == BlockBytes)
+        {
+            if (!WriteBlock(BlockUsed))
+            {
+                SetError();
+                return;
+            }
+            BlockUsed = 0;
+        }
+    }
+}
+
+bool FOmniCaptureDirectFileWriter::Close()
+{
+    if (!bOpen)
+    {
+        return !IsError();
+    }
+
+    bool bResult = !IsError();
+    if (bResult && BlockUsed > 0)
+    {
+        bResult = WriteBlock(BlockUsed);
+    }
+    BlockUsed = 0;
+
+    // Drops the preallocated space and the padding of the last unbuffered block.
+    bResult = Truncate(TotalBytes) && bResult;
+    CloseHandle();
+    bOpen = false;
+
+    if (!bResult)
+    {
+        SetError();
+    }
+    return bResult;
+}
+
+bool FOmniCaptureDirectFileWriter::WriteBlock(int64 Bytes)
+{
+    // Unbuffered writes must cover whole sectors; the padding is trimmed on Close.
+    int64 WriteBytes = Bytes;
+    if (bDirect)
+    {
+        WriteBytes = Align(Bytes, Alignment);
+        FMemory::Memzero(Block + Bytes, WriteBytes - Bytes);
+    }
+
+    bool bAlignmentRejected = false;
+    if (WriteToHandle(Block, WriteBytes, bAlignmentRejected))
+    {
+        FileOffset += Bytes;
+        return true;
+    }
+
+    if (!bAlignmentRejected)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to write %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("The volume holding %s rejected unbuffered writes; continuing buffered."), *FilePath);
+    CloseHandle();
+    if (!OpenHandle(false, false) || !WriteToHandle(Block, Bytes, bAlignmentRejected))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to write %s"), *FilePath);
+        return false;
+    }
+
+    FileOffset += Bytes;
+    return true;
+}
+
+#if PLATFORM_WINDOWS
+
+bool FOmniCaptureDirectFileWriter::OpenHandle(bool bUnbuffered, bool bTruncate)
+{
+    const DWORD Flags = FILE_ATTRIBUTE_NORMAL | (bUnbuffered ? FILE_FLAG_NO_BUFFERING : FILE_FLAG_SEQUENTIAL_SCAN);
+    HANDLE Handle = ::CreateFileW(*FilePath, GENERIC_WRITE, FILE_SHARE_READ, nullptr, bTruncate ? CREATE_ALWAYS : OPEN_EXISTING, Flags, nullptr);
+    if (Handle == INVALID_HANDLE_VALUE)
+    {
+        return bUnbuffered && OpenHandle(false, bTruncate);
+    }
+
+    if (bUnbuffered)
+    {
+        // Sectors larger than the block alignment cannot be written unbuffered.
+        FILE_STORAGE_INFO StorageInfo = {};
+        if (!::GetFileInformationByHandleEx(Handle, FileStorageInfo, &StorageInfo, sizeof(StorageInfo))
+            || StorageInfo.LogicalBytesPerSector == 0
+            || Alignment % StorageInfo.LogicalBytesPerSector != 0)
+        {
+            ::CloseHandle(Handle);
+            return OpenHandle(false, bTruncate);
+        }
+    }
+
+    FileHandle = Handle;
+    bDirect = bUnbuffered;
+    return true;
+}
+
+void FOmniCaptureDirectFileWriter::CloseHandle()
+{
+    if (FileHandle)
+    {
+        ::CloseHandle(static_cast<HANDLE>(FileHandle));
+        FileHandle = nullptr;
+    }
+}
+
+bool FOmniCaptureDirectFileWriter::Preallocate(int64 Size)
+{
+    LARGE_INTEGER End;
+    End.QuadPart = Size;
+    return ::SetFilePointerEx(static_cast<HANDLE>(FileHandle), End, nullptr, FILE_BEGIN) && ::SetEndOfFile(static_cast<HANDLE>(FileHandle));
+}
+
+bool FOmniCaptureDirectFileWriter::WriteToHandle(const uint8* Data, int64 Bytes, bool& bOutAlignmentRejected)
+{
+    // Positional writes, so the file pointer left by preallocation does not matter.
+    int64 Offset = FileOffset;
+    while (Bytes > 0)
+    {
+        const DWORD ChunkBytes = static_cast<DWORD>(FMath::Min<int64>(Bytes, 1ll << 30));
+        OVERLAPPED Overlapped = {};
+        Overlapped.Offset = static_cast<DWORD>(Offset & 0xffffffffll);
+        Overlapped.OffsetHigh = static_cast<DWORD>(Offset >> 32);
+
+        DWORD Written = 0;
+        if (!::WriteFile(static_cast<HANDLE>(FileHandle), Data, ChunkBytes, &Written, &Overlapped) || Written == 0)
+        {
+            bOutAlignmentRejected = bDirect && ::GetLastError() == ERROR_INVALID_PARAMETER;
+            return false;
+        }
+
+        Data += Written;
+        Bytes -= Written;
+        Offset += Written;
+    }
+    return true;
+}
+
+bool FOmniCaptureDirectFileWriter::Truncate(int64 Size)
+{
+    return FileHandle && Preallocate(Size);
+}
+
+#else
+
+bool FOmniCaptureDirectFileWriter::OpenHandle(bool bUnbuffered, bool bTruncate)
+{
+#if !PLATFORM_LINUX && !PLATFORM_MAC
+    bUnbuffered = false;
+#endif
+
+    int Flags = O_WRONLY | O_CLOEXEC | (bTruncate ? O_CREAT | O_TRUNC : 0);
+#if PLATFORM_LINUX
+    if (bUnbuffered)
+    {
+        Flags |= O_DIRECT;
+    }
+#endif
+
+    const int Descriptor = ::open(TCHAR_TO_UTF8(*FilePath), Flags, 0644);
+    if (Descriptor < 0)
+    {
+        // tmpfs and some network file systems refuse O_DIRECT outright.
+        return bUnbuffered && OpenHandle(false, bTruncate);
+    }
+
+#if PLATFORM_MAC
+    if (bUnbuffered)
+    {
+        ::fcntl(Descriptor, F_NOCACHE, 1);
+    }
+#endif
+
+    FileDescriptor = Descriptor;
+    bDirect = bUnbuffered;
+    return true;
+}
+
+void FOmniCaptureDirectFileWriter::CloseHandle()
+{
+    if (FileDescriptor >= 0)
+    {
+        ::close(FileDescriptor);
+        FileDescriptor = -1;
+    }
+}
+
+bool FOmniCaptureDirectFileWriter::Preallocate(int64 Size)
+{
+#if PLATFORM_LINUX
+    // Reserve the extents without moving end of file.
+    return ::fallocate(FileDescriptor, FALLOC_FL_KEEP_SIZE, 0, Size) == 0;
+#elif PLATFORM_MAC
+    fstore_t Store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, Size, 0 };
+    return ::fcntl(FileDescriptor, F_PREALLOCATE, &Store) != -1;
+#else
+    return false;
+#endif
+}
+
+bool FOmniCaptureDirectFileWriter::WriteToHandle(const uint8* Data, int64 Bytes, bool& bOutAlignmentRejected)
+{
+    int64 Offset = FileOffset;
+    while (Bytes > 0)
+    {
+        const ssize_t Written = ::pwrite(FileDescriptor, Data, static_cast<size_t>(Bytes), Offset);
+        if (Written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (Written <= 0)
+        {
+            bOutAlignmentRejected = bDirect && Written < 0 && errno == EINVAL;
+            return false;
+        }
+
+        Data += Written;
+        Bytes -= Written;
+        Offset += Written;
+    }
+    return true;
+}
+
+bool FOmniCaptureDirectFileWriter::Truncate(int64 Size)
+{
+    return FileDescriptor >= 0 && ::ftruncate(FileDescriptor, Size) == 0;
+}
+
+#endif
@@ -1,6 +1,9 @@
 #include "OmniCaptureEquirectConverter.h"
 
+#include "OmniCaptureCubemapKernels.h"
 #include "OmniCaptureIncludeFixes.h" // 统一兼容：TRT2D + TRTResource
+#include "OmniCapturePixelBufferPool.h"
+#include "OmniCapturePixelKernels.h"
 #include "OmniCaptureTypes.h"
 
 #include "GlobalShader.h"
@@ -19,38 +22,69 @@
 #include "ComputeShaderUtils.h"
 #endif
 #include "RHICommandList.h"
+#include "Async/ParallelFor.h"
 #include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+#include "Math/VectorRegister.h"
 
 namespace
 {
+    // Face texels stay in the render target's native format (half or full float)
+    // and are widened per sample, which halves the footprint of half-float rigs.
     struct FCPUFaceData
     {
         int32 Resolution = 0;
         EOmniCapturePixelPrecision Precision = EOmniCapturePixelPrecision::Unknown;
-        TArray<FLinearColor> Pixels;
+        TArray<FFloat16Color> HalfPixels;
+        TArray<FLinearColor> FloatPixels;
+
+        // Box-filtered levels 1..N, only built for the prefiltered sampling mode.
+        TArray<TArray<FLinearColor>> Mips;
+
+        template <typename TexelType>
+        const TArray<TexelType>& GetTexels() const;
+
+        int32 NumTexels() const
+        {
+            return Precision == EOmniCapturePixelPrecision::FullFloat ? FloatPixels.Num() : HalfPixels.Num();
+        }
 
         bool IsValid() const
         {
-            return Resolution > 0 && Pixels.Num() == Resolution * Resolution;
+            return Resolution > 0 && NumTexels() == Resolution * Resolution;
         }
     };
 
+    template <>
+    const TArray<FFloat16Color>& FCPUFaceData::GetTexels<FFloat16Color>() const
+    {
+        return HalfPixels;
+    }
+
+    template <>
+    const TArray<FLinearColor>& FCPUFaceData::GetTexels<FLinearColor>() const
+    {
+        return FloatPixels;
+    }
+
     struct FCPUCubemap
     {
         FCPUFaceData Faces[6];
         EOmniCapturePixelPrecision Precision = EOmniCapturePixelPrecision::Unknown;
+        int32 Resolution = 0;
+        uint8 FaceMask = 0;
 
         bool IsValid() const
         {
             for (int32 Index = 0; Index < 6; ++Index)
             {
-                if (!Faces[Index].IsValid())
+                if ((FaceMask & (1u << Index)) != 0 && !Faces[Index].IsValid())
                 {
                     return false;
                 }
             }
 
-            return Precision != EOmniCapturePixelPrecision::Unknown;
+            return FaceMask != 0 && Precision != EOmniCapturePixelPrecision::Unknown;
         }
     };
 
@@ -236,7 +270,60 @@ namespace
 
     IMPLEMENT_GLOBAL_SHADER(FOmniConvertToBGRACS, "/Plugin/OmniCapture/Private/OmniColorConvertCS.usf", "ConvertBGRA", SF_Compute);
 
-    bool ReadFaceData(UTextureRenderTarget2D* RenderTarget, FCPUFaceData& OutFace)
+    bool ReadSurfaceTexels(FTextureRenderTargetResource* Resource, TArray<FLinearColor>& OutTexels, FReadSurfaceDataFlags Flags, const FIntRect& Rect)
+    {
+        return Resource->ReadLinearColorPixels(OutTexels, Flags, Rect);
+    }
+
+    bool ReadSurfaceTexels(FTextureRenderTargetResource* Resource, TArray<FFloat16Color>& OutTexels, FReadSurfaceDataFlags Flags, const FIntRect& Rect)
+    {
+        return Resource->ReadFloat16Pixels(OutTexels, Flags, Rect);
+    }
+
+    // Staging for partial face readbacks, only touched under GCPUCubemapCS.
+    struct FFaceReadbackScratch
+    {
+        TArray<FFloat16Color> HalfPixels;
+        TArray<FLinearColor> FloatPixels;
+    };
+
+    FFaceReadbackScratch GFaceReadbackScratch;
+
+    // Reads ReadRect into a full-face buffer. Texels outside the rectangle are
+    // never sampled; a freshly sized buffer zeroes them so the mip filter does
+    // not pick up garbage.
+    template <typename TexelType>
+    bool ReadFaceTexels(FTextureRenderTargetResource* Resource, const FReadSurfaceDataFlags& Flags, const FIntRect& ReadRect, int32 Resolution, TArray<TexelType>& RectTexels, TArray<TexelType>& OutTexels)
+    {
+        if (ReadRect.Min == FIntPoint::ZeroValue && ReadRect.Max == FIntPoint(Resolution, Resolution))
+        {
+            return ReadSurfaceTexels(Resource, OutTexels, Flags, FIntRect());
+        }
+
+        if (OutTexels.Num() != Resolution * Resolution)
+        {
+            OutTexels.Reset();
+            OutTexels.SetNumZeroed(Resolution * Resolution);
+        }
+
+        if (!ReadSurfaceTexels(Resource, RectTexels, Flags, ReadRect) || RectTexels.Num() != ReadRect.Area())
+        {
+            return false;
+        }
+
+        const int32 RectWidth = ReadRect.Width();
+        for (int32 Row = 0; Row < ReadRect.Height(); ++Row)
+        {
+            FMemory::Memcpy(
+                OutTexels.GetData() + (ReadRect.Min.Y + Row) * Resolution + ReadRect.Min.X,
+                RectTexels.GetData() + Row * RectWidth,
+                RectWidth * sizeof(TexelType));
+        }
+
+        return true;
+    }
+
+    bool ReadFaceData(UTextureRenderTarget2D* RenderTarget, const FIntRect& UsedRect, FCPUFaceData& OutFace)
     {
         if (!RenderTarget)
         {
@@ -256,7 +343,16 @@ namespace
             return false;
         }
 
-        OutFace.Pixels.Reset();
+        FIntRect ReadRect(0, 0, SizeX, SizeY);
+        if (UsedRect.Area() > 0)
+        {
+            ReadRect.Clip(UsedRect);
+            if (ReadRect.Area() <= 0)
+            {
+                return false;
+            }
+        }
+
         OutFace.Precision = PixelPrecisionFromFormat(RenderTarget->GetFormat());
 
         // Use the standard UNorm readback mode instead of the Min/Max resolve
@@ -268,26 +364,23 @@ namespace
         FReadSurfaceDataFlags Flags(RCM_UNorm);
         Flags.SetLinearToGamma(false);
 
+        // The readback reuses the existing allocation when the face size is
+        // unchanged; only the buffer for the other precision is released.
         if (OutFace.Precision == EOmniCapturePixelPrecision::FullFloat)
         {
-            if (!Resource->ReadLinearColorPixels(OutFace.Pixels, Flags, FIntRect()))
+            OutFace.HalfPixels.Empty();
+            if (!ReadFaceTexels(Resource, Flags, ReadRect, SizeX, GFaceReadbackScratch.FloatPixels, OutFace.FloatPixels))
             {
                 return false;
             }
         }
         else
         {
-            TArray<FFloat16Color> HalfPixels;
-            if (!Resource->ReadFloat16Pixels(HalfPixels, Flags, FIntRect()))
-            {
-                return false;
-            }
-
             OutFace.Precision = EOmniCapturePixelPrecision::HalfFloat;
-            OutFace.Pixels.SetNum(HalfPixels.Num());
-            for (int32 Index = 0; Index < HalfPixels.Num(); ++Index)
+            OutFace.FloatPixels.Empty();
+            if (!ReadFaceTexels(Resource, Flags, ReadRect, SizeX, GFaceReadbackScratch.HalfPixels, OutFace.HalfPixels))
             {
-                OutFace.Pixels[Index] = FLinearColor(HalfPixels[Index]);
+                return false;
             }
         }
 
@@ -298,19 +391,38 @@ namespace
     bool BuildCPUCubemap(const FOmniEyeCapture& Eye, FCPUCubemap& OutCubemap)
     {
         OutCubemap.Precision = EOmniCapturePixelPrecision::Unknown;
+        OutCubemap.Resolution = 0;
+        OutCubemap.FaceMask = Eye.Coverage.FaceMask;
 
         for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
         {
-            if (!ReadFaceData(Eye.Faces[FaceIndex].RenderTarget, OutCubemap.Faces[FaceIndex]))
+            FCPUFaceData& Face = OutCubemap.Faces[FaceIndex];
+            if (!Eye.Coverage.IsFaceUsed(FaceIndex))
+            {
+                // Culled faces are not rendered, so there is nothing to read back.
+                Face = FCPUFaceData();
+                continue;
+            }
+
+            if (!ReadFaceData(Eye.Faces[FaceIndex].RenderTarget, Eye.Coverage.FaceRects[FaceIndex], Face))
+            {
+                return false;
+            }
+
+            if (OutCubemap.Resolution == 0)
+            {
+                OutCubemap.Resolution = Face.Resolution;
+            }
+            else if (Face.Resolution != OutCubemap.Resolution)
             {
                 return false;
             }
 
             if (OutCubemap.Precision == EOmniCapturePixelPrecision::Unknown)
             {
-                OutCubemap.Precision = OutCubemap.Faces[FaceIndex].Precision;
+                OutCubemap.Precision = Face.Precision;
             }
-            else if (OutCubemap.Precision != OutCubemap.Faces[FaceIndex].Precision)
+            else if (OutCubemap.Precision != Face.Precision)
             {
                 OutCubemap.Precision = EOmniCapturePixelPrecision::Unknown;
                 return false;
@@ -320,26 +432,53 @@ namespace
         return OutCubemap.IsValid();
     }
 
-    FVector DirectionFromEquirectPixelCPU(const FIntPoint& Pixel, const FIntPoint& EyeResolution, double LongitudeSpan, double LatitudeSpan, float& OutLatitude)
+    // Longitude only depends on the column and latitude only on the row, so the
+    // equirect directions factor into per-column and per-row sin/cos tables.
+    struct FEquirectTrigTables
     {
-        const FVector2D UV((static_cast<double>(Pixel.X) + 0.5) / EyeResolution.X, (static_cast<double>(Pixel.Y) + 0.5) / EyeResolution.Y);
-        const double Longitude = (UV.X * 2.0 - 1.0) * LongitudeSpan;
-        const double Latitude = (0.5 - UV.Y) * LatitudeSpan * 2.0;
-        OutLatitude = static_cast<float>(Latitude);
+        TArray<double> SinLongitude;
+        TArray<double> CosLongitude;
+        TArray<double> SinLatitude;
+        TArray<double> CosLatitude;
+        TArray<float> Latitude;
 
-        const double CosLat = FMath::Cos(Latitude);
-        const double SinLat = FMath::Sin(Latitude);
-        const double CosLon = FMath::Cos(Longitude);
-        const double SinLon = FMath::Sin(Longitude);
+        void Build(const FIntPoint& EyeResolution, double LongitudeSpan, double LatitudeSpan, const FVector2D& SampleOffset = FVector2D::ZeroVector)
+        {
+            SinLongitude.SetNumUninitialized(EyeResolution.X);
+            CosLongitude.SetNumUninitialized(EyeResolution.X);
+            for (int32 X = 0; X < EyeResolution.X; ++X)
+            {
+                const double U = (static_cast<double>(X) + 0.5 + SampleOffset.X) / EyeResolution.X;
+                const double Longitude = (U * 2.0 - 1.0) * LongitudeSpan;
+                SinLongitude[X] = FMath::Sin(Longitude);
+                CosLongitude[X] = FMath::Cos(Longitude);
+            }
 
-        FVector Direction;
-        Direction.X = CosLat * CosLon;
-        Direction.Y = CosLat * SinLon;
-        Direction.Z = SinLat;
-        return Direction.GetSafeNormal();
-    }
+            SinLatitude.SetNumUninitialized(EyeResolution.Y);
+            CosLatitude.SetNumUninitialized(EyeResolution.Y);
+            Latitude.SetNumUninitialized(EyeResolution.Y);
+            for (int32 Y = 0; Y < EyeResolution.Y; ++Y)
+            {
+                const double V = (static_cast<double>(Y) + 0.5 + SampleOffset.Y) / EyeResolution.Y;
+                const double RowLatitude = (0.5 - V) * LatitudeSpan * 2.0;
+                SinLatitude[Y] = FMath::Sin(RowLatitude);
+                CosLatitude[Y] = FMath::Cos(RowLatitude);
+                Latitude[Y] = static_cast<float>(RowLatitude);
+            }
+        }
+
+        FORCEINLINE FVector GetDirection(int32 X, int32 Y) const
+        {
+            FVector Direction;
+            Direction.X = CosLatitude[Y] * CosLongitude[X];
+            Direction.Y = CosLatitude[Y] * SinLongitude[X];
+            Direction.Z = SinLatitude[Y];
+            return Direction.GetSafeNormal();
+        }
+    };
 
-    FVector DirectionFromFisheyePixelCPU(const FIntPoint& Pixel, const FIntPoint& EyeResolution, double FovRadians, bool& bOutValid)
+    // PixelPosition is in pixel units, so (X + 0.5, Y + 0.5) is the centre of pixel (X, Y).
+    FVector DirectionFromFisheyePixelCPU(const FVector2D& PixelPosition, const FIntPoint& EyeResolution, double FovRadians, bool& bOutValid)
     {
         if (EyeResolution.X <= 0 || EyeResolution.Y <= 0)
         {
@@ -347,7 +486,7 @@ namespace
             return FVector::ZeroVector;
         }
 
-        const FVector2D UV((static_cast<double>(Pixel.X) + 0.5) / EyeResolution.X, (static_cast<double>(Pixel.Y) + 0.5) / EyeResolution.Y);
+        const FVector2D UV(PixelPosition.X / EyeResolution.X, PixelPosition.Y / EyeResolution.Y);
         FVector2D Normalized = FVector2D(UV.X * 2.0 - 1.0, 1.0 - UV.Y * 2.0);
 
         const double Radius = Normalized.Size();
@@ -371,76 +510,6 @@ namespace
         return Direction.GetSafeNormal();
     }
 
-    void DirectionToFaceUVCPU(const FVector& Direction, uint32& OutFaceIndex, FVector2D& OutUV, int32 FaceResolution, float SeamStrength)
-    {
-        const FVector AbsDir = Direction.GetAbs();
-
-        if (AbsDir.X >= AbsDir.Y && AbsDir.X >= AbsDir.Z)
-        {
-            if (Direction.X > 0.0f)
-            {
-                OutFaceIndex = 0;
-                OutUV = FVector2D(-Direction.Z, Direction.Y) / AbsDir.X;
-            }
-            else
-            {
-                OutFaceIndex = 1;
-                OutUV = FVector2D(Direction.Z, Direction.Y) / AbsDir.X;
-            }
-        }
-        else if (AbsDir.Y >= AbsDir.X && AbsDir.Y >= AbsDir.Z)
-        {
-            if (Direction.Y > 0.0f)
-            {
-                OutFaceIndex = 2;
-                OutUV = FVector2D(Direction.X, -Direction.Z) / AbsDir.Y;
-            }
-            else
-            {
-                OutFaceIndex = 3;
-                OutUV = FVector2D(Direction.X, Direction.Z) / AbsDir.Y;
-            }
-        }
-        else
-        {
-            if (Direction.Z > 0.0f)
-            {
-                OutFaceIndex = 4;
-                OutUV = FVector2D(Direction.X, Direction.Y) / AbsDir.Z;
-            }
-            else
-            {
-                OutFaceIndex = 5;
-                OutUV = FVector2D(-Direction.X, Direction.Y) / AbsDir.Z;
-            }
-        }
-
-        OutUV = (OutUV + FVector2D(1.0, 1.0)) * 0.5f;
-
-        const double Resolution = static_cast<double>(FMath::Max(1, FaceResolution));
-        const double Scale = FMath::Lerp(1.0, (Resolution - 1.0) / Resolution, SeamStrength);
-        const double Bias = (0.5 / Resolution) * SeamStrength;
-        OutUV = FVector2D(OutUV.X * Scale + Bias, OutUV.Y * Scale + Bias);
-        OutUV.X = FMath::Clamp(OutUV.X, 0.0f, 1.0f);
-        OutUV.Y = FMath::Clamp(OutUV.Y, 0.0f, 1.0f);
-    }
-
-    FLinearColor SampleCubemapCPU(const FCPUCubemap& Cubemap, const FVector& Direction, int32 FaceResolution, float SeamStrength)
-    {
-        uint32 FaceIndex = 0;
-        FVector2D FaceUV = FVector2D::ZeroVector;
-        DirectionToFaceUVCPU(Direction, FaceIndex, FaceUV, FaceResolution, SeamStrength);
-
-        const FCPUFaceData& Face = Cubemap.Faces[FaceIndex];
-        const int32 SampleX = FMath::Clamp(static_cast<int32>(FaceUV.X * (Face.Resolution - 1)), 0, Face.Resolution - 1);
-        const int32 SampleY = FMath::Clamp(static_cast<int32>(FaceUV.Y * (Face.Resolution - 1)), 0, Face.Resolution - 1);
-        const int32 SampleIndex = SampleY * Face.Resolution + SampleX;
-
-        return Face.Pixels.IsValidIndex(SampleIndex)
-            ? FLinearColor(Face.Pixels[SampleIndex])
-            : FLinearColor::Black;
-    }
-
     void ApplyPolarMitigation(float PolarStrength, float Latitude, FVector& Direction)
     {
         if (PolarStrength <= 0.0f)
@@ -463,149 +532,748 @@ namespace
         Direction.Normalize();
     }
 
-    void AddYUVConversionPasses(
-        FRDGBuilder& GraphBuilder,
-        const FOmniCaptureSettings& Settings,
-        bool bSourceLinear,
-        int32 OutputWidth,
-        int32 OutputHeight,
-        FRDGTextureRef SourceTexture,
-        FRDGTextureRef& OutLuma,
-        FRDGTextureRef& OutChroma)
+    // Direct evaluation at an arbitrary position in pixel units; the row and
+    // column tables only cover pixel centres.
+    FVector DirectionFromEquirectPositionCPU(const FVector2D& PixelPosition, const FIntPoint& EyeResolution, double LongitudeSpan, double LatitudeSpan, float PolarStrength)
     {
-        if (!SourceTexture)
+        const double Longitude = (PixelPosition.X / EyeResolution.X * 2.0 - 1.0) * LongitudeSpan;
+        const double Latitude = (0.5 - PixelPosition.Y / EyeResolution.Y) * LatitudeSpan * 2.0;
+        const double CosLatitude = FMath::Cos(Latitude);
+
+        FVector Direction(CosLatitude * FMath::Cos(Longitude), CosLatitude * FMath::Sin(Longitude), FMath::Sin(Latitude));
+        Direction.Normalize();
+        ApplyPolarMitigation(PolarStrength, static_cast<float>(Latitude), Direction);
+        return Direction;
+    }
+
+    // Face-plane coordinates in [-1, 1] of a direction projected onto a given
+    // face, oriented like the lookup kernels. Fails for directions pointing
+    // away from the face.
+    bool ProjectOntoCubeFace(int32 FaceIndex, const FVector& Direction, double& OutMajorAxis, double& OutU, double& OutV)
+    {
+        double U = 0.0;
+        double V = 0.0;
+        switch (FaceIndex)
         {
-            return;
+        case 0: OutMajorAxis = Direction.X; U = -Direction.Z; V = Direction.Y; break;
+        case 1: OutMajorAxis = -Direction.X; U = Direction.Z; V = Direction.Y; break;
+        case 2: OutMajorAxis = Direction.Y; U = Direction.X; V = -Direction.Z; break;
+        case 3: OutMajorAxis = -Direction.Y; U = Direction.X; V = Direction.Z; break;
+        case 4: OutMajorAxis = Direction.Z; U = Direction.X; V = Direction.Y; break;
+        default: OutMajorAxis = -Direction.Z; U = -Direction.X; V = Direction.Y; break;
         }
 
-        const bool bNV12 = Settings.NVENCColorFormat == EOmniCaptureColorFormat::NV12;
-        const bool bP010 = Settings.NVENCColorFormat == EOmniCaptureColorFormat::P010;
-        if (!bNV12 && !bP010)
+        if (OutMajorAxis <= UE_SMALL_NUMBER)
+        {
+            return false;
+        }
+
+        OutU = U / OutMajorAxis;
+        OutV = V / OutMajorAxis;
+        return true;
+    }
+
+    // Rows are handed to workers in bands of roughly this many output bytes so
+    // each task streams through a cache-friendly slice of the frame.
+    constexpr int64 CPUReprojectionBandBytes = 256 * 1024;
+
+    void ParallelForRowBands(int32 NumRows, int64 BytesPerRow, int32 WorkerCount, TFunctionRef<void(int32 RowStart, int32 RowEnd)> Body)
+    {
+        if (NumRows <= 0)
         {
             return;
         }
 
-        const EPixelFormat LumaFormat = bNV12 ? PF_R8 : PF_R16_UINT;
-        const EPixelFormat ChromaFormat = bNV12 ? PF_R8G8 : PF_R16G16_UINT;
+        const int32 RowsPerBand = static_cast<int32>(FMath::Clamp<int64>(CPUReprojectionBandBytes / FMath::Max<int64>(1, BytesPerRow), 1, NumRows));
+        const int32 NumBands = FMath::DivideAndRoundUp(NumRows, RowsPerBand);
 
-        FRDGTextureDesc LumaDesc = FRDGTextureDesc::Create2D(FIntPoint(OutputWidth, OutputHeight), LumaFormat, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV);
-        FRDGTextureDesc ChromaDesc = FRDGTextureDesc::Create2D(FIntPoint(FMath::Max(OutputWidth / 2, 1), FMath::Max(OutputHeight / 2, 1)), ChromaFormat, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV);
+        auto RunBand = [&Body, NumRows, RowsPerBand](int32 BandIndex)
+        {
+            const int32 RowStart = BandIndex * RowsPerBand;
+            Body(RowStart, FMath::Min(NumRows, RowStart + RowsPerBand));
+        };
 
-        OutLuma = GraphBuilder.CreateTexture(LumaDesc, TEXT("OmniNVENC_Luma"));
-        OutChroma = GraphBuilder.CreateTexture(ChromaDesc, TEXT("OmniNVENC_Chroma"));
+        if (WorkerCount <= 0)
+        {
+            ParallelFor(NumBands, RunBand);
+            return;
+        }
 
-        FOmniConvertToYUVLumaCS::FParameters* LumaParameters = GraphBuilder.AllocParameters<FOmniConvertToYUVLumaCS::FParameters>();
-        LumaParameters->OutputSize = FVector2f(OutputWidth, OutputHeight);
-        LumaParameters->ChromaSize = FVector2f(ChromaDesc.Extent.X, ChromaDesc.Extent.Y);
-        LumaParameters->Format = bNV12 ? 0 : 1;
-        LumaParameters->ColorSpace = static_cast<int32>(Settings.ColorSpace);
-        LumaParameters->bLinearInput = bSourceLinear ? 1 : 0;
-        LumaParameters->SourceTexture = SourceTexture;
-        LumaParameters->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-        LumaParameters->LumaOutput = GraphBuilder.CreateUAV(OutLuma);
+        // Cap concurrency by striding the bands over a fixed number of tasks.
+        const int32 NumTasks = FMath::Min(WorkerCount, NumBands);
+        ParallelFor(NumTasks, [&RunBand, NumTasks, NumBands](int32 TaskIndex)
+        {
+            for (int32 BandIndex = TaskIndex; BandIndex < NumBands; BandIndex += NumTasks)
+            {
+                RunBand(BandIndex);
+            }
+        }, NumTasks <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+    }
 
-        TShaderMapRef<FOmniConvertToYUVLumaCS> LumaShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
-        const FIntVector LumaGroupCount(
-            FMath::DivideAndRoundUp(OutputWidth, 8),
-            FMath::DivideAndRoundUp(OutputHeight, 8),
-            1);
+    struct FCPUReprojectionKey
+    {
+        bool bFisheye = false;
+        bool bHalfSphere = false;
+        FIntPoint EyeResolution = FIntPoint::ZeroValue;
+        int32 FaceResolution = 0;
+        double LongitudeSpan = 0.0;
+        double LatitudeSpan = 0.0;
+        double FisheyeFovRadians = 0.0;
+        float SeamBlend = 0.0f;
+        float PolarDampening = 0.0f;
+        bool bPrefiltered = false;
+        int32 SamplesPerPixel = 1;
+
+        bool operator==(const FCPUReprojectionKey& Other) const
+        {
+            return bFisheye == Other.bFisheye
+                && bHalfSphere == Other.bHalfSphere
+                && EyeResolution == Other.EyeResolution
+                && FaceResolution == Other.FaceResolution
+                && LongitudeSpan == Other.LongitudeSpan
+                && LatitudeSpan == Other.LatitudeSpan
+                && FisheyeFovRadians == Other.FisheyeFovRadians
+                && SeamBlend == Other.SeamBlend
+                && PolarDampening == Other.PolarDampening
+                && bPrefiltered == Other.bPrefiltered
+                && SamplesPerPixel == Other.SamplesPerPixel;
+        }
+
+        friend uint32 GetTypeHash(const FCPUReprojectionKey& Key)
+        {
+            uint32 Hash = GetTypeHash(Key.EyeResolution);
+            Hash = HashCombine(Hash, GetTypeHash(Key.FaceResolution));
+            Hash = HashCombine(Hash, GetTypeHash(Key.LongitudeSpan));
+            Hash = HashCombine(Hash, GetTypeHash(Key.LatitudeSpan));
+            Hash = HashCombine(Hash, GetTypeHash(Key.FisheyeFovRadians));
+            Hash = HashCombine(Hash, GetTypeHash(Key.SeamBlend));
+            Hash = HashCombine(Hash, GetTypeHash(Key.PolarDampening));
+            Hash = HashCombine(Hash, GetTypeHash(Key.SamplesPerPixel));
+            return HashCombine(Hash, (Key.bFisheye ? 1u : 0u) | (Key.bHalfSphere ? 2u : 0u) | (Key.bPrefiltered ? 4u : 0u));
+        }
+    };
 
-        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::YUVLuma"), LumaShader, LumaParameters, LumaGroupCount);
+    // Per-eye lookup table from output pixel to cube face texel.  Both eyes
+    // share the same table, so the stereo layout only matters through the
+    // eye resolution stored in the key.  Each eye pixel owns SamplesPerPixel
+    // consecutive samples; prefiltered maps also store the fractional face
+    // coordinate and the mip picked from the pixel footprint per sample.
+    struct FCPUReprojectionMap
+    {
+        FCPUReprojectionKey Key;
+        uint32 KeyHash = 0;
+        TArray<uint32> Samples;
+        TArray<uint32> FilterCoords;
+        TArray<uint8> MipLevels;
+        int32 NumMipLevels = 1;
+    };
 
-        FOmniConvertToYUVChromaCS::FParameters* ChromaParameters = GraphBuilder.AllocParameters<FOmniConvertToYUVChromaCS::FParameters>();
-        ChromaParameters->OutputSize = FVector2f(OutputWidth, OutputHeight);
-        ChromaParameters->ChromaSize = FVector2f(ChromaDesc.Extent.X, ChromaDesc.Extent.Y);
-        ChromaParameters->Format = bNV12 ? 0 : 1;
-        ChromaParameters->ColorSpace = static_cast<int32>(Settings.ColorSpace);
-        ChromaParameters->bLinearInput = bSourceLinear ? 1 : 0;
-        ChromaParameters->SourceTexture = SourceTexture;
-        ChromaParameters->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-        ChromaParameters->ChromaOutput = GraphBuilder.CreateUAV(OutChroma);
+    constexpr int32 MaxCPUSupersampleCount = 16;
+    constexpr int32 MaxCPUFaceMipLevels = 8;
 
-        TShaderMapRef<FOmniConvertToYUVChromaCS> ChromaShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
-        const FIntVector ChromaGroupCount(
-            FMath::DivideAndRoundUp(ChromaDesc.Extent.X, 8),
-            FMath::DivideAndRoundUp(ChromaDesc.Extent.Y, 8),
-            1);
+    FORCEINLINE uint32 PackFilterCoord(float U, float V)
+    {
+        const uint32 PackedU = static_cast<uint32>(FMath::RoundToInt(FMath::Clamp(U, 0.0f, 1.0f) * 65535.0f));
+        const uint32 PackedV = static_cast<uint32>(FMath::RoundToInt(FMath::Clamp(V, 0.0f, 1.0f) * 65535.0f));
+        return PackedU | (PackedV << 16);
+    }
 
-        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::YUVChroma"), ChromaShader, ChromaParameters, ChromaGroupCount);
+    FORCEINLINE FVector2f UnpackFilterCoord(uint32 FilterCoord)
+    {
+        return FVector2f(static_cast<float>(FilterCoord & 0xFFFFu) / 65535.0f, static_cast<float>(FilterCoord >> 16) / 65535.0f);
     }
 
-    FRDGTextureRef AddBGRAPackingPass(
-        FRDGBuilder& GraphBuilder,
-        const FOmniCaptureSettings& Settings,
-        bool bSourceLinear,
-        int32 OutputWidth,
-        int32 OutputHeight,
-        FRDGTextureRef SourceTexture)
+    // Sub-pixel offsets on a square grid rotated by atan(1/2), so no two
+    // samples share a row or column.  The grid is shrunk by cos(angle) to keep
+    // every sample inside the pixel.
+    void BuildRotatedGridOffsets(int32 SampleCount, TArray<FVector2D, TInlineAllocator<MaxCPUSupersampleCount>>& OutOffsets)
     {
-        if (!SourceTexture)
+        OutOffsets.Reset();
+        if (SampleCount <= 1)
         {
-            return nullptr;
+            OutOffsets.Add(FVector2D::ZeroVector);
+            return;
         }
 
-        FRDGTextureDesc Desc = FRDGTextureDesc::Create2D(FIntPoint(OutputWidth, OutputHeight), PF_B8G8R8A8, FClearValueBinding::Transparent, TexCreate_ShaderResource | TexCreate_UAV);
-        FRDGTextureRef OutputTexture = GraphBuilder.CreateTexture(Desc, TEXT("OmniNVENC_BGRA"));
+        const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(SampleCount)));
+        const double Angle = FMath::Atan(0.5);
+        const double CosAngle = FMath::Cos(Angle);
+        const double SinAngle = FMath::Sin(Angle);
 
-        FOmniConvertToBGRACS::FParameters* Parameters = GraphBuilder.AllocParameters<FOmniConvertToBGRACS::FParameters>();
-        Parameters->OutputSize = FVector2f(OutputWidth, OutputHeight);
-        Parameters->ChromaSize = FVector2f(OutputWidth * 0.5f, OutputHeight * 0.5f);
-        Parameters->Format = 0;
-        Parameters->ColorSpace = static_cast<int32>(Settings.ColorSpace);
-        Parameters->bLinearInput = bSourceLinear ? 1 : 0;
-        Parameters->SourceTexture = SourceTexture;
-        Parameters->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
-        Parameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+        for (int32 Index = 0; Index < SampleCount; ++Index)
+        {
+            const double CellX = (static_cast<double>(Index % GridSize) + 0.5) / GridSize - 0.5;
+            const double CellY = (static_cast<double>(Index / GridSize) + 0.5) / GridSize - 0.5;
+            OutOffsets.Add(FVector2D(
+                (CellX * CosAngle - CellY * SinAngle) * CosAngle,
+                (CellX * SinAngle + CellY * CosAngle) * CosAngle));
+        }
+    }
 
-        TShaderMapRef<FOmniConvertToBGRACS> Shader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
-        const FIntVector GroupCount(
-            FMath::DivideAndRoundUp(OutputWidth, 8),
-            FMath::DivideAndRoundUp(OutputHeight, 8),
-            1);
+    // A texel on the unit-distance face plane subtends its area divided by the
+    // cube of its distance from the centre.
+    double ComputeTexelSolidAngle(float U, float V, int32 FaceResolution)
+    {
+        const double FaceX = U * 2.0 - 1.0;
+        const double FaceY = V * 2.0 - 1.0;
+        const double TexelSize = 2.0 / FMath::Max(1, FaceResolution);
+        return TexelSize * TexelSize / FMath::Pow(1.0 + FaceX * FaceX + FaceY * FaceY, 1.5);
+    }
 
-        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::BGRAPack"), Shader, Parameters, GroupCount);
+    using FCPUReprojectionMapPtr = TSharedPtr<const FCPUReprojectionMap, ESPMode::ThreadSafe>;
 
-        return OutputTexture;
+    FCriticalSection GReprojectionMapCS;
+    FCPUReprojectionMapPtr GCachedReprojectionMap;
+
+    FCPUReprojectionKey MakeEquirectReprojectionKey(const FOmniCaptureSettings& Settings, const FIntPoint& EyeResolution, int32 FaceResolution)
+    {
+        FCPUReprojectionKey Key;
+        Key.bHalfSphere = Settings.IsVR180();
+        Key.EyeResolution = EyeResolution;
+        Key.FaceResolution = FaceResolution;
+        Key.LongitudeSpan = Settings.GetLongitudeSpanRadians();
+        Key.LatitudeSpan = Settings.GetLatitudeSpanRadians();
+        Key.SeamBlend = Settings.SeamBlend;
+        Key.PolarDampening = Settings.PolarDampening;
+        Key.bPrefiltered = Settings.CPUSamplingQuality == EOmniCaptureCPUSamplingQuality::Prefiltered;
+        Key.SamplesPerPixel = FMath::Clamp(Settings.CPUSupersampleCount, 1, MaxCPUSupersampleCount);
+        return Key;
     }
 
-    FRDGTextureRef BuildFaceArray(FRDGBuilder& GraphBuilder, const TArray<FTextureRHIRef, TInlineAllocator<6>>& Faces, int32 FaceResolution, EPixelFormat PixelFormat, const TCHAR* DebugName)
+    FCPUReprojectionKey MakeFisheyeReprojectionKey(const FOmniCaptureSettings& Settings, const FIntPoint& EyeResolution, int32 FaceResolution)
     {
-        if (Faces.Num() == 0)
+        FCPUReprojectionKey Key;
+        Key.bFisheye = true;
+        Key.bHalfSphere = Settings.IsVR180();
+        Key.EyeResolution = EyeResolution;
+        Key.FaceResolution = FaceResolution;
+        Key.FisheyeFovRadians = FMath::DegreesToRadians(FMath::Clamp(Settings.FisheyeFOV, 0.0f, 360.0f));
+        Key.SeamBlend = Settings.SeamBlend;
+        Key.bPrefiltered = Settings.CPUSamplingQuality == EOmniCaptureCPUSamplingQuality::Prefiltered;
+        Key.SamplesPerPixel = FMath::Clamp(Settings.CPUSupersampleCount, 1, MaxCPUSupersampleCount);
+        return Key;
+    }
+
+    void BuildReprojectionMap(const FCPUReprojectionKey& Key, int32 WorkerCount, FCPUReprojectionMap& OutMap)
+    {
+        const FIntPoint EyeResolution = Key.EyeResolution;
+        const int32 FaceResolution = Key.FaceResolution;
+        const int32 SamplesPerPixel = Key.SamplesPerPixel;
+        const int32 NumSamples = EyeResolution.X * EyeResolution.Y * SamplesPerPixel;
+
+        OutMap.Key = Key;
+        OutMap.KeyHash = GetTypeHash(Key);
+        OutMap.Samples.SetNumUninitialized(NumSamples);
+        OutMap.NumMipLevels = 1;
+        if (Key.bPrefiltered)
         {
-            return nullptr;
+            OutMap.FilterCoords.SetNumUninitialized(NumSamples);
+            OutMap.MipLevels.SetNumUninitialized(NumSamples);
         }
 
-        FRDGTextureDesc ArrayDesc = FRDGTextureDesc::Create2DArray(FIntPoint(FaceResolution, FaceResolution), PixelFormat, FClearValueBinding::Transparent, TexCreate_ShaderResource | TexCreate_UAV, Faces.Num());
-        FRDGTextureRef ArrayTexture = GraphBuilder.CreateTexture(ArrayDesc, DebugName);
+        TArray<FVector2D, TInlineAllocator<MaxCPUSupersampleCount>> SampleOffsets;
+        BuildRotatedGridOffsets(SamplesPerPixel, SampleOffsets);
 
-        for (int32 Index = 0; Index < Faces.Num(); ++Index)
+        // Every sub-sample offset gets its own tables, which keeps the
+        // supersampled directions separable as well.
+        TArray<FEquirectTrigTables, TInlineAllocator<MaxCPUSupersampleCount>> TrigTables;
+        if (!Key.bFisheye)
         {
-            if (!Faces[Index].IsValid())
+            TrigTables.SetNum(SamplesPerPixel);
+            for (int32 SampleIndex = 0; SampleIndex < SamplesPerPixel; ++SampleIndex)
             {
-                continue;
+                TrigTables[SampleIndex].Build(EyeResolution, Key.LongitudeSpan, Key.LatitudeSpan, SampleOffsets[SampleIndex]);
             }
+        }
 
-            FRDGTextureRef SourceTexture = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(Faces[Index], *FString::Printf(TEXT("%sFace%d"), DebugName, Index)));
-            FRHICopyTextureInfo CopyInfo;
-            CopyInfo.SourceSliceIndex = 0;
-            CopyInfo.DestSliceIndex = Index;
-            CopyInfo.NumSlices = 1;
+        auto DirectionAt = [&Key, EyeResolution](const FVector2D& PixelPosition, bool& bOutValid) -> FVector
+        {
+            if (Key.bFisheye)
+            {
+                return DirectionFromFisheyePixelCPU(PixelPosition, EyeResolution, Key.FisheyeFovRadians, bOutValid);
+            }
 
-            AddCopyTexturePass(GraphBuilder, SourceTexture, ArrayTexture, CopyInfo);
-        }
+            bOutValid = true;
+            return DirectionFromEquirectPositionCPU(PixelPosition, EyeResolution, Key.LongitudeSpan, Key.LatitudeSpan, Key.PolarDampening);
+        };
 
-        return ArrayTexture;
-    }
+        // Solid angle covered by one output pixel, from the directions towards
+        // its right and lower neighbours (or left and upper at the fisheye rim).
+        auto PixelSolidAngle = [&DirectionAt](const FVector2D& PixelCentre) -> double
+        {
+            bool bCentreValid = false;
+            const FVector Centre = DirectionAt(PixelCentre, bCentreValid);
 
-    void ConvertOnRenderThread(const FOmniCaptureSettings Settings, const TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces, const TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces, FOmniCaptureEquirectResult& OutResult)
-    {
-        const int32 FaceResolution = Settings.Resolution;
-        const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
-        const bool bSideBySide = bStereo && Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide;
-        const FIntPoint OutputSize = Settings.GetEquirectResolution();
-        const int32 OutputWidth = OutputSize.X;
-        const int32 OutputHeight = OutputSize.Y;
-        const bool bUseLinear = Settings.Gamma == EOmniCaptureGamma::Linear;
+            auto Axis = [&](const FVector2D& Step) -> FVector
+            {
+                bool bValid = false;
+                const FVector Forward = DirectionAt(PixelCentre + Step, bValid);
+                if (bValid)
+                {
+                    return Forward - Centre;
+                }
+
+                const FVector Backward = DirectionAt(PixelCentre - Step, bValid);
+                return bValid ? Centre - Backward : FVector::ZeroVector;
+            };
+
+            return bCentreValid ? FVector::CrossProduct(Axis(FVector2D(1.0, 0.0)), Axis(FVector2D(0.0, 1.0))).Size() : 0.0;
+        };
+
+        const int32 MaxMipLevel = FMath::Min(MaxCPUFaceMipLevels - 1, static_cast<int32>(FMath::FloorLog2(static_cast<uint32>(FaceResolution))));
+        const int64 BytesPerSample = Key.bPrefiltered ? sizeof(uint32) * 2 + sizeof(uint8) : sizeof(uint32);
+
+        ParallelForRowBands(EyeResolution.Y, EyeResolution.X * SamplesPerPixel * BytesPerSample, WorkerCount, [&](int32 RowStart, int32 RowEnd)
+        {
+            // Directions are gathered per row in structure-of-arrays form so the
+            // face lookup can run four lanes at a time.
+            TArray<float> DirX;
+            TArray<float> DirY;
+            TArray<float> DirZ;
+            TArray<bool> Valid;
+            TArray<uint32> RowSamples;
+            TArray<double> SampleSolidAngles;
+            DirX.SetNumUninitialized(EyeResolution.X);
+            DirY.SetNumUninitialized(EyeResolution.X);
+            DirZ.SetNumUninitialized(EyeResolution.X);
+            Valid.SetNumUninitialized(EyeResolution.X);
+            RowSamples.SetNumUninitialized(EyeResolution.X);
+            if (Key.bPrefiltered)
+            {
+                SampleSolidAngles.SetNumUninitialized(EyeResolution.X);
+            }
+
+            for (int32 Y = RowStart; Y < RowEnd; ++Y)
+            {
+                const int32 RowBase = Y * EyeResolution.X;
+
+                if (Key.bPrefiltered)
+                {
+                    // Sub-samples split the pixel footprint between them.
+                    for (int32 X = 0; X < EyeResolution.X; ++X)
+                    {
+                        SampleSolidAngles[X] = PixelSolidAngle(FVector2D(X + 0.5, Y + 0.5)) / SamplesPerPixel;
+                    }
+                }
+
+                for (int32 SampleIndex = 0; SampleIndex < SamplesPerPixel; ++SampleIndex)
+                {
+                    const FVector2D& SampleOffset = SampleOffsets[SampleIndex];
+
+                    for (int32 X = 0; X < EyeResolution.X; ++X)
+                    {
+                        bool bValid = true;
+                        FVector Direction;
+                        if (Key.bFisheye)
+                        {
+                            const FVector2D PixelPosition(static_cast<double>(X) + 0.5 + SampleOffset.X, static_cast<double>(Y) + 0.5 + SampleOffset.Y);
+                            Direction = DirectionFromFisheyePixelCPU(PixelPosition, EyeResolution, Key.FisheyeFovRadians, bValid);
+                        }
+                        else
+                        {
+                            const FEquirectTrigTables& Tables = TrigTables[SampleIndex];
+                            Direction = Tables.GetDirection(X, Y);
+                            ApplyPolarMitigation(Key.PolarDampening, Tables.Latitude[Y], Direction);
+                        }
+
+                        Valid[X] = bValid && !(Key.bHalfSphere && Direction.X < 0.0f);
+                        DirX[X] = static_cast<float>(Direction.X);
+                        DirY[X] = static_cast<float>(Direction.Y);
+                        DirZ[X] = static_cast<float>(Direction.Z);
+                    }
+
+                    if (!Key.bPrefiltered)
+                    {
+                        FOmniCaptureCubemapKernels::LookupTexels(DirX.GetData(), DirY.GetData(), DirZ.GetData(), EyeResolution.X, FaceResolution, Key.SeamBlend, RowSamples.GetData());
+
+                        for (int32 X = 0; X < EyeResolution.X; ++X)
+                        {
+                            OutMap.Samples[(RowBase + X) * SamplesPerPixel + SampleIndex] = Valid[X] ? RowSamples[X] : FOmniCaptureCubemapKernels::InvalidSample;
+                        }
+                        continue;
+                    }
+
+                    for (int32 X = 0; X < EyeResolution.X; ++X)
+                    {
+                        const int32 MapIndex = (RowBase + X) * SamplesPerPixel + SampleIndex;
+                        if (!Valid[X])
+                        {
+                            OutMap.Samples[MapIndex] = FOmniCaptureCubemapKernels::InvalidSample;
+                            OutMap.FilterCoords[MapIndex] = 0;
+                            OutMap.MipLevels[MapIndex] = 0;
+                            continue;
+                        }
+
+                        float U = 0.0f;
+                        float V = 0.0f;
+                        const uint32 FaceIndex = FOmniCaptureCubemapKernels::ProjectToFaceScalar(DirX[X], DirY[X], DirZ[X], FaceResolution, Key.SeamBlend, U, V);
+                        const uint32 TexelX = static_cast<uint32>(U * (FaceResolution - 1));
+                        const uint32 TexelY = static_cast<uint32>(V * (FaceResolution - 1));
+
+                        // Each mip level quarters the texel count, so the level
+                        // is half the log2 of the footprint-to-texel area ratio.
+                        const double FootprintRatio = SampleSolidAngles[X] / ComputeTexelSolidAngle(U, V, FaceResolution);
+                        const int32 MipLevel = FootprintRatio > 1.0 ? FMath::RoundToInt(0.5 * FMath::Log2(FootprintRatio)) : 0;
+
+                        OutMap.Samples[MapIndex] = FOmniCaptureCubemapKernels::PackSample(FaceIndex, TexelY * static_cast<uint32>(FaceResolution) + TexelX);
+                        OutMap.FilterCoords[MapIndex] = PackFilterCoord(U, V);
+                        OutMap.MipLevels[MapIndex] = static_cast<uint8>(FMath::Clamp(MipLevel, 0, MaxMipLevel));
+                    }
+                }
+            }
+        });
+
+        if (Key.bPrefiltered)
+        {
+            uint8 HighestMipLevel = 0;
+            for (const uint8 MipLevel : OutMap.MipLevels)
+            {
+                HighestMipLevel = FMath::Max(HighestMipLevel, MipLevel);
+            }
+            OutMap.NumMipLevels = HighestMipLevel + 1;
+        }
+    }
+
+    FCPUReprojectionMapPtr FindOrBuildReprojectionMap(const FCPUReprojectionKey& Key, int32 WorkerCount)
+    {
+        if (Key.EyeResolution.X <= 0 || Key.EyeResolution.Y <= 0 || Key.FaceResolution <= 0)
+        {
+            return nullptr;
+        }
+
+        if (!FOmniCaptureCubemapKernels::SupportsFaceResolution(Key.FaceResolution))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("OmniCapture CPU reprojection does not support %d px cube faces"), Key.FaceResolution);
+            return nullptr;
+        }
+
+        const uint32 KeyHash = GetTypeHash(Key);
+
+        FScopeLock Lock(&GReprojectionMapCS);
+        if (GCachedReprojectionMap.IsValid() && GCachedReprojectionMap->KeyHash == KeyHash && GCachedReprojectionMap->Key == Key)
+        {
+            return GCachedReprojectionMap;
+        }
+
+        // Drop the previous table first so two full-size maps never coexist.
+        GCachedReprojectionMap.Reset();
+
+        TSharedPtr<FCPUReprojectionMap, ESPMode::ThreadSafe> Map = MakeShared<FCPUReprojectionMap, ESPMode::ThreadSafe>();
+        BuildReprojectionMap(Key, WorkerCount, *Map);
+        GCachedReprojectionMap = Map;
+        return GCachedReprojectionMap;
+    }
+
+    // Typed view over one cubemap so the gather loops are instantiated once per
+    // source precision instead of branching per texel.
+    template <typename TexelType>
+    struct TCPUCubemapView
+    {
+        const FCPUFaceData* FaceData[6];
+        const TArray<TexelType>* Faces[6];
+
+        explicit TCPUCubemapView(const FCPUCubemap& Cubemap)
+        {
+            for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+            {
+                FaceData[FaceIndex] = &Cubemap.Faces[FaceIndex];
+                Faces[FaceIndex] = &Cubemap.Faces[FaceIndex].GetTexels<TexelType>();
+            }
+        }
+
+        FORCEINLINE FLinearColor Fetch(uint32 Sample) const
+        {
+            const TArray<TexelType>& Texels = *Faces[FOmniCaptureCubemapKernels::GetFaceIndex(Sample)];
+            const int32 TexelIndex = static_cast<int32>(FOmniCaptureCubemapKernels::GetTexelIndex(Sample));
+            return Texels.IsValidIndex(TexelIndex)
+                ? FLinearColor(Texels[TexelIndex])
+                : FLinearColor::Black;
+        }
+
+        FORCEINLINE FLinearColor FetchLevelTexel(uint32 FaceIndex, int32 Level, int32 TexelIndex) const
+        {
+            if (Level == 0)
+            {
+                const TArray<TexelType>& Texels = *Faces[FaceIndex];
+                return Texels.IsValidIndex(TexelIndex) ? FLinearColor(Texels[TexelIndex]) : FLinearColor::Black;
+            }
+
+            const TArray<FLinearColor>& Texels = FaceData[FaceIndex]->Mips[Level - 1];
+            return Texels.IsValidIndex(TexelIndex) ? Texels[TexelIndex] : FLinearColor::Black;
+        }
+
+        // One bilinear tap from the prefiltered level.  Taps are clamped to
+        // the face; the seam blend already keeps samples off the face border.
+        FLinearColor FetchFiltered(uint32 Sample, uint32 FilterCoord, uint8 MipLevel) const
+        {
+            const uint32 FaceIndex = FOmniCaptureCubemapKernels::GetFaceIndex(Sample);
+            const FCPUFaceData& Face = *FaceData[FaceIndex];
+            const int32 Level = FMath::Min<int32>(MipLevel, Face.Mips.Num());
+            const int32 LevelResolution = FMath::Max(1, Face.Resolution >> Level);
+            const FVector2f UV = UnpackFilterCoord(FilterCoord);
+
+            const float TexelX = UV.X * LevelResolution - 0.5f;
+            const float TexelY = UV.Y * LevelResolution - 0.5f;
+            const int32 X0 = FMath::FloorToInt(TexelX);
+            const int32 Y0 = FMath::FloorToInt(TexelY);
+            const float FracX = TexelX - X0;
+            const float FracY = TexelY - Y0;
+
+            const int32 Left = FMath::Clamp(X0, 0, LevelResolution - 1);
+            const int32 Right = FMath::Clamp(X0 + 1, 0, LevelResolution - 1);
+            const int32 Top = FMath::Clamp(Y0, 0, LevelResolution - 1) * LevelResolution;
+            const int32 Bottom = FMath::Clamp(Y0 + 1, 0, LevelResolution - 1) * LevelResolution;
+
+            const FLinearColor Upper = FMath::Lerp(FetchLevelTexel(FaceIndex, Level, Top + Left), FetchLevelTexel(FaceIndex, Level, Top + Right), FracX);
+            const FLinearColor Lower = FMath::Lerp(FetchLevelTexel(FaceIndex, Level, Bottom + Left), FetchLevelTexel(FaceIndex, Level, Bottom + Right), FracX);
+            return FMath::Lerp(Upper, Lower, FracY);
+        }
+    };
+
+    FORCEINLINE VectorRegister4Float LoadTexelVector(const FLinearColor& Texel)
+    {
+        return VectorLoad(&Texel.R);
+    }
+
+    FORCEINLINE VectorRegister4Float LoadTexelVector(const FFloat16Color& Texel)
+    {
+        float Linear[4];
+        FPlatformMath::VectorLoadHalf(Linear, reinterpret_cast<const uint16*>(&Texel));
+        return VectorLoad(Linear);
+    }
+
+    // 2x2 box filter into the next level. Odd source sizes clamp the last
+    // row and column.
+    template <typename TexelType>
+    void DownsampleFaceLevel(const TexelType* Source, int32 SourceResolution, int32 LevelResolution, TArray<FLinearColor>& OutLevel)
+    {
+        OutLevel.SetNumUninitialized(LevelResolution * LevelResolution);
+        const VectorRegister4Float Quarter = VectorSetFloat1(0.25f);
+
+        for (int32 Y = 0; Y < LevelResolution; ++Y)
+        {
+            const TexelType* Row0 = Source + FMath::Min(Y * 2, SourceResolution - 1) * SourceResolution;
+            const TexelType* Row1 = Source + FMath::Min(Y * 2 + 1, SourceResolution - 1) * SourceResolution;
+            FLinearColor* DestRow = OutLevel.GetData() + Y * LevelResolution;
+
+            for (int32 X = 0; X < LevelResolution; ++X)
+            {
+                const int32 X0 = FMath::Min(X * 2, SourceResolution - 1);
+                const int32 X1 = FMath::Min(X * 2 + 1, SourceResolution - 1);
+                const VectorRegister4Float Sum = VectorAdd(
+                    VectorAdd(LoadTexelVector(Row0[X0]), LoadTexelVector(Row0[X1])),
+                    VectorAdd(LoadTexelVector(Row1[X0]), LoadTexelVector(Row1[X1])));
+                VectorStore(VectorMultiply(Sum, Quarter), &DestRow[X].R);
+            }
+        }
+    }
+
+    void BuildFaceMips(FCPUFaceData& Face, int32 NumLevels)
+    {
+        if (!Face.IsValid())
+        {
+            Face.Mips.Reset();
+            return;
+        }
+
+        Face.Mips.SetNum(FMath::Max(0, NumLevels - 1));
+
+        int32 SourceResolution = Face.Resolution;
+        for (int32 Level = 1; Level < NumLevels; ++Level)
+        {
+            const int32 LevelResolution = FMath::Max(1, SourceResolution / 2);
+            TArray<FLinearColor>& Dest = Face.Mips[Level - 1];
+
+            if (Level > 1)
+            {
+                DownsampleFaceLevel(Face.Mips[Level - 2].GetData(), SourceResolution, LevelResolution, Dest);
+            }
+            else if (Face.Precision == EOmniCapturePixelPrecision::FullFloat)
+            {
+                DownsampleFaceLevel(Face.FloatPixels.GetData(), SourceResolution, LevelResolution, Dest);
+            }
+            else
+            {
+                DownsampleFaceLevel(Face.HalfPixels.GetData(), SourceResolution, LevelResolution, Dest);
+            }
+
+            SourceResolution = LevelResolution;
+        }
+    }
+
+    // Rebuilds the face mips the map samples from, once per frame. Point
+    // sampled maps release any levels left over from a prefiltered run.
+    void PrepareCubemapMips(const FCPUReprojectionMap& Map, FCPUCubemap& LeftCubemap, FCPUCubemap* RightCubemap, int32 WorkerCount)
+    {
+        const int32 NumLevels = Map.Key.bPrefiltered ? Map.NumMipLevels : 1;
+        FCPUCubemap* Cubemaps[2] = { &LeftCubemap, RightCubemap };
+        const int32 NumFaces = RightCubemap ? 12 : 6;
+        const bool bSingleThread = NumLevels <= 1 || WorkerCount == 1;
+
+        ParallelFor(NumFaces, [&Cubemaps, NumLevels](int32 Index)
+        {
+            BuildFaceMips(Cubemaps[Index / 6]->Faces[Index % 6], NumLevels);
+        }, bSingleThread ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+    }
+
+    // Face buffers are kept between frames so the readback does not reallocate
+    // gigabytes of texels every frame. Conversions serialize on the lock.
+    FCriticalSection GCPUCubemapCS;
+    FCPUCubemap GCPUCubemaps[2];
+
+    void ReleaseCPUCubemaps()
+    {
+        FScopeLock Lock(&GCPUCubemapCS);
+        for (FCPUCubemap& Cubemap : GCPUCubemaps)
+        {
+            Cubemap = FCPUCubemap();
+        }
+        GFaceReadbackScratch = FFaceReadbackScratch();
+    }
+
+    void AddYUVConversionPasses(
+        FRDGBuilder& GraphBuilder,
+        const FOmniCaptureSettings& Settings,
+        bool bSourceLinear,
+        int32 OutputWidth,
+        int32 OutputHeight,
+        FRDGTextureRef SourceTexture,
+        FRDGTextureRef& OutLuma,
+        FRDGTextureRef& OutChroma)
+    {
+        if (!SourceTexture)
+        {
+            return;
+        }
+
+        const bool bNV12 = Settings.NVENCColorFormat == EOmniCaptureColorFormat::NV12;
+        const bool bP010 = Settings.NVENCColorFormat == EOmniCaptureColorFormat::P010;
+        if (!bNV12 && !bP010)
+        {
+            return;
+        }
+
+        const EPixelFormat LumaFormat = bNV12 ? PF_R8 : PF_R16_UINT;
+        const EPixelFormat ChromaFormat = bNV12 ? PF_R8G8 : PF_R16G16_UINT;
+
+        FRDGTextureDesc LumaDesc = FRDGTextureDesc::Create2D(FIntPoint(OutputWidth, OutputHeight), LumaFormat, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV);
+        FRDGTextureDesc ChromaDesc = FRDGTextureDesc::Create2D(FIntPoint(FMath::Max(OutputWidth / 2, 1), FMath::Max(OutputHeight / 2, 1)), ChromaFormat, FClearValueBinding::Black, TexCreate_ShaderResource | TexCreate_UAV);
+
+        OutLuma = GraphBuilder.CreateTexture(LumaDesc, TEXT("OmniNVENC_Luma"));
+        OutChroma = GraphBuilder.CreateTexture(ChromaDesc, TEXT("OmniNVENC_Chroma"));
+
+        FOmniConvertToYUVLumaCS::FParameters* LumaParameters = GraphBuilder.AllocParameters<FOmniConvertToYUVLumaCS::FParameters>();
+        LumaParameters->OutputSize = FVector2f(OutputWidth, OutputHeight);
+        LumaParameters->ChromaSize = FVector2f(ChromaDesc.Extent.X, ChromaDesc.Extent.Y);
+        LumaParameters->Format = bNV12 ? 0 : 1;
+        LumaParameters->ColorSpace = static_cast<int32>(Settings.ColorSpace);
+        LumaParameters->bLinearInput = bSourceLinear ? 1 : 0;
+        LumaParameters->SourceTexture = SourceTexture;
+        LumaParameters->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+        LumaParameters->LumaOutput = GraphBuilder.CreateUAV(OutLuma);
+
+        TShaderMapRef<FOmniConvertToYUVLumaCS> LumaShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        const FIntVector LumaGroupCount(
+            FMath::DivideAndRoundUp(OutputWidth, 8),
+            FMath::DivideAndRoundUp(OutputHeight, 8),
+            1);
+
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::YUVLuma"), LumaShader, LumaParameters, LumaGroupCount);
+
+        FOmniConvertToYUVChromaCS::FParameters* ChromaParameters = GraphBuilder.AllocParameters<FOmniConvertToYUVChromaCS::FParameters>();
+        ChromaParameters->OutputSize = FVector2f(OutputWidth, OutputHeight);
+        ChromaParameters->ChromaSize = FVector2f(ChromaDesc.Extent.X, ChromaDesc.Extent.Y);
+        ChromaParameters->Format = bNV12 ? 0 : 1;
+        ChromaParameters->ColorSpace = static_cast<int32>(Settings.ColorSpace);
+        ChromaParameters->bLinearInput = bSourceLinear ? 1 : 0;
+        ChromaParameters->SourceTexture = SourceTexture;
+        ChromaParameters->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+        ChromaParameters->ChromaOutput = GraphBuilder.CreateUAV(OutChroma);
+
+        TShaderMapRef<FOmniConvertToYUVChromaCS> ChromaShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        const FIntVector ChromaGroupCount(
+            FMath::DivideAndRoundUp(ChromaDesc.Extent.X, 8),
+            FMath::DivideAndRoundUp(ChromaDesc.Extent.Y, 8),
+            1);
+
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::YUVChroma"), ChromaShader, ChromaParameters, ChromaGroupCount);
+    }
+
+    FRDGTextureRef AddBGRAPackingPass(
+        FRDGBuilder& GraphBuilder,
+        const FOmniCaptureSettings& Settings,
+        bool bSourceLinear,
+        int32 OutputWidth,
+        int32 OutputHeight,
+        FRDGTextureRef SourceTexture)
+    {
+        if (!SourceTexture)
+        {
+            return nullptr;
+        }
+
+        FRDGTextureDesc Desc = FRDGTextureDesc::Create2D(FIntPoint(OutputWidth, OutputHeight), PF_B8G8R8A8, FClearValueBinding::Transparent, TexCreate_ShaderResource | TexCreate_UAV);
+        FRDGTextureRef OutputTexture = GraphBuilder.CreateTexture(Desc, TEXT("OmniNVENC_BGRA"));
+
+        FOmniConvertToBGRACS::FParameters* Parameters = GraphBuilder.AllocParameters<FOmniConvertToBGRACS::FParameters>();
+        Parameters->OutputSize = FVector2f(OutputWidth, OutputHeight);
+        Parameters->ChromaSize = FVector2f(OutputWidth * 0.5f, OutputHeight * 0.5f);
+        Parameters->Format = 0;
+        Parameters->ColorSpace = static_cast<int32>(Settings.ColorSpace);
+        Parameters->bLinearInput = bSourceLinear ? 1 : 0;
+        Parameters->SourceTexture = SourceTexture;
+        Parameters->SourceSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+        Parameters->OutputTexture = GraphBuilder.CreateUAV(OutputTexture);
+
+        TShaderMapRef<FOmniConvertToBGRACS> Shader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+        const FIntVector GroupCount(
+            FMath::DivideAndRoundUp(OutputWidth, 8),
+            FMath::DivideAndRoundUp(OutputHeight, 8),
+            1);
+
+        FComputeShaderUtils::AddPass(GraphBuilder, RDG_EVENT_NAME("OmniCapture::BGRAPack"), Shader, Parameters, GroupCount);
+
+        return OutputTexture;
+    }
+
+    FRDGTextureRef BuildFaceArray(FRDGBuilder& GraphBuilder, const TArray<FTextureRHIRef, TInlineAllocator<6>>& Faces, int32 FaceResolution, EPixelFormat PixelFormat, const TCHAR* DebugName)
+    {
+        if (Faces.Num() == 0)
+        {
+            return nullptr;
+        }
+
+        FRDGTextureDesc ArrayDesc = FRDGTextureDesc::Create2DArray(FIntPoint(FaceResolution, FaceResolution), PixelFormat, FClearValueBinding::Transparent, TexCreate_ShaderResource | TexCreate_UAV, Faces.Num());
+        FRDGTextureRef ArrayTexture = GraphBuilder.CreateTexture(ArrayDesc, DebugName);
+
+        for (int32 Index = 0; Index < Faces.Num(); ++Index)
+        {
+            if (!Faces[Index].IsValid())
+            {
+                continue;
+            }
+
+            FRDGTextureRef SourceTexture = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(Faces[Index], *FString::Printf(TEXT("%sFace%d"), DebugName, Index)));
+            FRHICopyTextureInfo CopyInfo;
+            CopyInfo.SourceSliceIndex = 0;
+            CopyInfo.DestSliceIndex = Index;
+            CopyInfo.NumSlices = 1;
+
+            AddCopyTexturePass(GraphBuilder, SourceTexture, ArrayTexture, CopyInfo);
+        }
+
+        return ArrayTexture;
+    }
+
+    void ConvertOnRenderThread(const FOmniCaptureSettings Settings, const TArray<FTextureRHIRef, TInlineAllocator<6>> LeftFaces, const TArray<FTextureRHIRef, TInlineAllocator<6>> RightFaces, FOmniCaptureEquirectResult& OutResult)
+    {
+        const int32 FaceResolution = Settings.Resolution;
+        const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
+        const bool bSideBySide = bStereo && Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide;
+        const FIntPoint OutputSize = Settings.GetEquirectResolution();
+        const int32 OutputWidth = OutputSize.X;
+        const int32 OutputHeight = OutputSize.Y;
+        const bool bUseLinear = Settings.Gamma == EOmniCaptureGamma::Linear;
         const float LongitudeSpan = Settings.GetLongitudeSpanRadians();
         const float LatitudeSpan = Settings.GetLatitudeSpanRadians();
         const bool bHalfSphere = Settings.IsVR180();
@@ -762,8 +1430,7 @@ namespace
             {
                 if (Precision == EOmniCapturePixelPrecision::FullFloat)
                 {
-                    TUniquePtr<TImagePixelData<FLinearColor>> PixelData = MakeUnique<TImagePixelData<FLinearColor>>(FIntPoint(OutputWidth, OutputHeight));
-                    PixelData->Pixels.SetNum(PixelCount);
+                    TUniquePtr<TImagePixelData<FLinearColor>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<FLinearColor>(FIntPoint(OutputWidth, OutputHeight));
 
                     FLinearColor* DestData = PixelData->Pixels.GetData();
                     const FLinearColor* SourcePixels = reinterpret_cast<const FLinearColor*>(RawData);
@@ -775,21 +1442,10 @@ namespace
 
                     OutResult.PixelData = MoveTemp(PixelData);
                     OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat32;
-
-                    OutResult.PreviewPixels.SetNum(PixelCount);
-                    const TImagePixelData<FLinearColor>* FloatData = static_cast<const TImagePixelData<FLinearColor>*>(OutResult.PixelData.Get());
-                    if (FloatData)
-                    {
-                        for (uint32 Index = 0; Index < PixelCount; ++Index)
-                        {
-                            OutResult.PreviewPixels[Index] = FloatData->Pixels[Index].ToFColor(true);
-                        }
-                    }
                 }
                 else
                 {
-                    TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = MakeUnique<TImagePixelData<FFloat16Color>>(FIntPoint(OutputWidth, OutputHeight));
-                    PixelData->Pixels.SetNum(PixelCount);
+                    TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<FFloat16Color>(FIntPoint(OutputWidth, OutputHeight));
 
                     FFloat16Color* DestData = PixelData->Pixels.GetData();
                     const FFloat16Color* SourcePixels = reinterpret_cast<const FFloat16Color*>(RawData);
@@ -801,47 +1457,24 @@ namespace
 
                     OutResult.PixelData = MoveTemp(PixelData);
                     OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat16;
-
-                    OutResult.PreviewPixels.SetNum(PixelCount);
-                    const TImagePixelData<FFloat16Color>* FloatData = static_cast<const TImagePixelData<FFloat16Color>*>(OutResult.PixelData.Get());
-                    if (FloatData)
-                    {
-                        for (uint32 Index = 0; Index < PixelCount; ++Index)
-                        {
-                            const FFloat16Color& Source = FloatData->Pixels[Index];
-                            const FLinearColor Linear(Source.R.GetFloat(), Source.G.GetFloat(), Source.B.GetFloat(), Source.A.GetFloat());
-                            OutResult.PreviewPixels[Index] = Linear.ToFColor(true);
-                        }
-                    }
                 }
             }
             else
             {
-                TUniquePtr<TImagePixelData<FColor>> PixelData = MakeUnique<TImagePixelData<FColor>>(FIntPoint(OutputWidth, OutputHeight));
-                PixelData->Pixels.SetNum(PixelCount);
-                OutResult.PreviewPixels.SetNum(PixelCount);
+                TUniquePtr<TImagePixelData<FColor>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<FColor>(FIntPoint(OutputWidth, OutputHeight));
 
                 const uint8* SourcePixels = RawData;
                 for (int32 Row = 0; Row < OutputHeight; ++Row)
                 {
                     const uint8* SourceRow = SourcePixels + (RowPitch * Row * BytesPerPixel);
                     FColor* DestRow = PixelData->Pixels.GetData() + Row * OutputWidth;
-                    for (int32 Column = 0; Column < OutputWidth; ++Column)
+                    if (Precision == EOmniCapturePixelPrecision::FullFloat)
                     {
-                        FLinearColor Linear;
-                        if (Precision == EOmniCapturePixelPrecision::FullFloat)
-                        {
-                            const FLinearColor* Pixel = reinterpret_cast<const FLinearColor*>(SourceRow) + Column;
-                            Linear = *Pixel;
-                        }
-                        else
-                        {
-                            const FFloat16Color* Pixel = reinterpret_cast<const FFloat16Color*>(SourceRow) + Column;
-                            Linear = FLinearColor(Pixel->R.GetFloat(), Pixel->G.GetFloat(), Pixel->B.GetFloat(), Pixel->A.GetFloat());
-                        }
-                        const FColor SRGB = Linear.ToFColor(true);
-                        DestRow[Column] = SRGB;
-                        OutResult.PreviewPixels[Row * OutputWidth + Column] = SRGB;
+                        FOmniCapturePixelKernels::LinearToSRGB8(reinterpret_cast<const FLinearColor*>(SourceRow), OutputWidth, DestRow);
+                    }
+                    else
+                    {
+                        FOmniCapturePixelKernels::LinearToSRGB8(reinterpret_cast<const FFloat16Color*>(SourceRow), OutputWidth, DestRow);
                     }
                 }
 
@@ -1032,8 +1665,7 @@ namespace
             {
                 if (Precision == EOmniCapturePixelPrecision::FullFloat)
                 {
-                    TUniquePtr<TImagePixelData<FLinearColor>> PixelData = MakeUnique<TImagePixelData<FLinearColor>>(OutputSize);
-                    PixelData->Pixels.SetNum(PixelCount);
+                    TUniquePtr<TImagePixelData<FLinearColor>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<FLinearColor>(OutputSize);
 
                     FLinearColor* DestData = PixelData->Pixels.GetData();
                     const FLinearColor* SourcePixels = reinterpret_cast<const FLinearColor*>(RawData);
@@ -1045,21 +1677,10 @@ namespace
 
                     OutResult.PixelData = MoveTemp(PixelData);
                     OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat32;
-
-                    OutResult.PreviewPixels.SetNum(PixelCount);
-                    const TImagePixelData<FLinearColor>* FloatData = static_cast<const TImagePixelData<FLinearColor>*>(OutResult.PixelData.Get());
-                    if (FloatData)
-                    {
-                        for (uint32 Index = 0; Index < PixelCount; ++Index)
-                        {
-                            OutResult.PreviewPixels[Index] = FloatData->Pixels[Index].ToFColor(true);
-                        }
-                    }
                 }
                 else
                 {
-                    TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = MakeUnique<TImagePixelData<FFloat16Color>>(OutputSize);
-                    PixelData->Pixels.SetNum(PixelCount);
+                    TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<FFloat16Color>(OutputSize);
 
                     FFloat16Color* DestData = PixelData->Pixels.GetData();
                     const FFloat16Color* SourcePixels = reinterpret_cast<const FFloat16Color*>(RawData);
@@ -1071,47 +1692,24 @@ namespace
 
                     OutResult.PixelData = MoveTemp(PixelData);
                     OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat16;
-
-                    OutResult.PreviewPixels.SetNum(PixelCount);
-                    const TImagePixelData<FFloat16Color>* FloatData = static_cast<const TImagePixelData<FFloat16Color>*>(OutResult.PixelData.Get());
-                    if (FloatData)
-                    {
-                        for (uint32 Index = 0; Index < PixelCount; ++Index)
-                        {
-                            const FFloat16Color& Source = FloatData->Pixels[Index];
-                            const FLinearColor Linear(Source.R.GetFloat(), Source.G.GetFloat(), Source.B.GetFloat(), Source.A.GetFloat());
-                            OutResult.PreviewPixels[Index] = Linear.ToFColor(true);
-                        }
-                    }
                 }
             }
             else
             {
-                TUniquePtr<TImagePixelData<FColor>> PixelData = MakeUnique<TImagePixelData<FColor>>(OutputSize);
-                PixelData->Pixels.SetNum(PixelCount);
-                OutResult.PreviewPixels.SetNum(PixelCount);
+                TUniquePtr<TImagePixelData<FColor>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<FColor>(OutputSize);
 
                 const uint8* SourcePixels = RawData;
                 for (int32 Row = 0; Row < OutputSize.Y; ++Row)
                 {
                     const uint8* SourceRow = SourcePixels + (RowPitch * Row * BytesPerPixel);
                     FColor* DestRow = PixelData->Pixels.GetData() + Row * OutputSize.X;
-                    for (int32 Column = 0; Column < OutputSize.X; ++Column)
+                    if (Precision == EOmniCapturePixelPrecision::FullFloat)
                     {
-                        FLinearColor Linear;
-                        if (Precision == EOmniCapturePixelPrecision::FullFloat)
-                        {
-                            const FLinearColor* Pixel = reinterpret_cast<const FLinearColor*>(SourceRow) + Column;
-                            Linear = *Pixel;
-                        }
-                        else
-                        {
-                            const FFloat16Color* Pixel = reinterpret_cast<const FFloat16Color*>(SourceRow) + Column;
-                            Linear = FLinearColor(Pixel->R.GetFloat(), Pixel->G.GetFloat(), Pixel->B.GetFloat(), Pixel->A.GetFloat());
-                        }
-                        const FColor SRGB = Linear.ToFColor(true);
-                        DestRow[Column] = SRGB;
-                        OutResult.PreviewPixels[Row * OutputSize.X + Column] = SRGB;
+                        FOmniCapturePixelKernels::LinearToSRGB8(reinterpret_cast<const FLinearColor*>(SourceRow), OutputSize.X, DestRow);
+                    }
+                    else
+                    {
+                        FOmniCapturePixelKernels::LinearToSRGB8(reinterpret_cast<const FFloat16Color*>(SourceRow), OutputSize.X, DestRow);
                     }
                 }
 
@@ -1225,43 +1823,334 @@ namespace
                 FGPUFenceRHIRef Fence = RHICreateGPUFence(TEXT("OmniPlanarFence"));
                 if (Fence.IsValid())
                 {
-                    RHICmdList.WriteGPUFence(Fence);
-                    OutResult.ReadyFence = Fence;
+                    RHICmdList.WriteGPUFence(Fence);
+                    OutResult.ReadyFence = Fence;
+                }
+            }
+        }
+    }
+
+namespace
+{
+    // Per-frame state for resolving map samples against one or two cubemaps.
+    template <typename SourceTexelType>
+    struct TReprojectionGather
+    {
+        const FCPUReprojectionMap& Map;
+        const TCPUCubemapView<SourceTexelType> LeftView;
+        const TCPUCubemapView<SourceTexelType> RightView;
+        const int32 SamplesPerPixel;
+        const bool bPrefiltered;
+        const bool bSingleTap;
+        const float SampleWeight;
+
+        TReprojectionGather(const FCPUReprojectionMap& InMap, const FCPUCubemap& LeftCubemap, const FCPUCubemap& RightCubemap)
+            : Map(InMap)
+            , LeftView(LeftCubemap)
+            , RightView(RightCubemap)
+            , SamplesPerPixel(InMap.Key.SamplesPerPixel)
+            , bPrefiltered(InMap.Key.bPrefiltered)
+            , bSingleTap(InMap.Key.SamplesPerPixel == 1 && !InMap.Key.bPrefiltered)
+            , SampleWeight(1.0f / InMap.Key.SamplesPerPixel)
+        {
+        }
+
+        // Sub-samples are averaged; invalid ones count as transparent so the
+        // edge of the covered area is antialiased too.
+        FLinearColor ResolvePixel(const TCPUCubemapView<SourceTexelType>& View, int32 FirstSample) const
+        {
+            FLinearColor Sum(0.0f, 0.0f, 0.0f, 0.0f);
+            for (int32 SampleIndex = FirstSample; SampleIndex < FirstSample + SamplesPerPixel; ++SampleIndex)
+            {
+                const uint32 Sample = Map.Samples[SampleIndex];
+                if (Sample == FOmniCaptureCubemapKernels::InvalidSample)
+                {
+                    continue;
+                }
+
+                Sum += bPrefiltered
+                    ? View.FetchFiltered(Sample, Map.FilterCoords[SampleIndex], Map.MipLevels[SampleIndex])
+                    : View.Fetch(Sample);
+            }
+            return Sum * SampleWeight;
+        }
+
+        // Writes eye row Y into the left and right eye rows; a null row skips that eye.
+        template <typename PixelType, typename ConvertFunc>
+        void GatherEyeRow(int32 Y, PixelType* LeftRow, PixelType* RightRow, const PixelType& TransparentPixel, ConvertFunc& ConvertColor) const
+        {
+            const int32 Width = Map.Key.EyeResolution.X;
+
+            if (!bSingleTap)
+            {
+                for (int32 X = 0; X < Width; ++X)
+                {
+                    const int32 FirstSample = (Y * Width + X) * SamplesPerPixel;
+                    if (LeftRow)
+                    {
+                        LeftRow[X] = ConvertColor(ResolvePixel(LeftView, FirstSample));
+                    }
+                    if (RightRow)
+                    {
+                        RightRow[X] = ConvertColor(ResolvePixel(RightView, FirstSample));
+                    }
+                }
+                return;
+            }
+
+            const uint32* RowSamples = Map.Samples.GetData() + Y * Width;
+            for (int32 X = 0; X < Width; ++X)
+            {
+                const uint32 Sample = RowSamples[X];
+                const bool bValid = Sample != FOmniCaptureCubemapKernels::InvalidSample;
+
+                if (LeftRow)
+                {
+                    LeftRow[X] = bValid ? ConvertColor(LeftView.Fetch(Sample)) : TransparentPixel;
+                }
+                if (RightRow)
+                {
+                    RightRow[X] = bValid ? ConvertColor(RightView.Fetch(Sample)) : TransparentPixel;
+                }
+            }
+        }
+    };
+
+    FIntPoint GetCoveredCanvasSize(const FIntPoint& EyeResolution, bool bStereo, bool bSideBySide)
+    {
+        return FIntPoint(
+            EyeResolution.X * (bStereo && bSideBySide ? 2 : 1),
+            EyeResolution.Y * (bStereo && !bSideBySide ? 2 : 1));
+    }
+
+    // Walks the per-eye reprojection map once. In stereo every sample is fetched
+    // from both cubemaps and written to both eye regions of the canvas, so the
+    // map is read once per eye pixel rather than once per output pixel.
+    template <typename SourceTexelType, typename PixelType, typename ConvertFunc>
+    void GatherReprojectedPixelsFrom(
+        const FCPUReprojectionMap& Map,
+        const FCPUCubemap& LeftCubemap,
+        const FCPUCubemap* RightCubemap,
+        const FIntPoint& OutputSize,
+        bool bSideBySide,
+        int32 WorkerCount,
+        TArray64<PixelType>& OutPixels,
+        ConvertFunc ConvertColor)
+    {
+        const FIntPoint EyeResolution = Map.Key.EyeResolution;
+        const bool bStereo = RightCubemap != nullptr;
+        const FIntPoint CoveredSize = GetCoveredCanvasSize(EyeResolution, bStereo, bSideBySide);
+
+        const bool bLayoutFits = CoveredSize.X <= OutputSize.X && CoveredSize.Y <= OutputSize.Y;
+
+        const PixelType TransparentPixel = ConvertColor(FLinearColor::Transparent);
+        if (CoveredSize != OutputSize)
+        {
+            // Alignment padding outside the eye regions stays transparent.
+            for (int64 Index = 0; Index < OutPixels.Num(); ++Index)
+            {
+                OutPixels[Index] = TransparentPixel;
+            }
+        }
+
+        if (!bLayoutFits)
+        {
+            return;
+        }
+
+        const TReprojectionGather<SourceTexelType> Gather(Map, LeftCubemap, bStereo ? *RightCubemap : LeftCubemap);
+        const int32 RightEyeOffset = bSideBySide ? EyeResolution.X : EyeResolution.Y * OutputSize.X;
+        const int64 BytesPerRow = static_cast<int64>(EyeResolution.X) * sizeof(PixelType) * (bStereo ? 2 : 1);
+
+        ParallelForRowBands(EyeResolution.Y, BytesPerRow, WorkerCount, [&](int32 RowStart, int32 RowEnd)
+        {
+            for (int32 Y = RowStart; Y < RowEnd; ++Y)
+            {
+                PixelType* LeftRow = OutPixels.GetData() + static_cast<int64>(Y) * OutputSize.X;
+                Gather.GatherEyeRow(Y, LeftRow, bStereo ? LeftRow + RightEyeOffset : nullptr, TransparentPixel, ConvertColor);
+            }
+        });
+    }
+
+    // Reprojects canvas rows [RowStart, RowStart + RowCount) into OutRows, which
+    // holds RowCount full rows. A top-bottom canvas row belongs to a single eye;
+    // a side-by-side row still fills both eyes from one map read.
+    template <typename SourceTexelType, typename PixelType, typename ConvertFunc>
+    void GatherReprojectedRowsFrom(
+        const FCPUReprojectionMap& Map,
+        const FCPUCubemap& LeftCubemap,
+        const FCPUCubemap* RightCubemap,
+        const FIntPoint& OutputSize,
+        bool bSideBySide,
+        int32 WorkerCount,
+        int32 RowStart,
+        int32 RowCount,
+        PixelType* OutRows,
+        ConvertFunc ConvertColor)
+    {
+        const FIntPoint EyeResolution = Map.Key.EyeResolution;
+        const bool bStereo = RightCubemap != nullptr;
+        const bool bTopBottom = bStereo && !bSideBySide;
+        const FIntPoint CoveredSize = GetCoveredCanvasSize(EyeResolution, bStereo, bSideBySide);
+        const bool bLayoutFits = CoveredSize.X <= OutputSize.X && CoveredSize.Y <= OutputSize.Y;
+
+        const PixelType TransparentPixel = ConvertColor(FLinearColor::Transparent);
+        const TReprojectionGather<SourceTexelType> Gather(Map, LeftCubemap, bStereo ? *RightCubemap : LeftCubemap);
+        const int64 BytesPerRow = static_cast<int64>(OutputSize.X) * sizeof(PixelType);
+
+        ParallelForRowBands(RowCount, BytesPerRow, WorkerCount, [&](int32 BandStart, int32 BandEnd)
+        {
+            for (int32 Row = BandStart; Row < BandEnd; ++Row)
+            {
+                const int32 Y = RowStart + Row;
+                PixelType* OutRow = OutRows + static_cast<int64>(Row) * OutputSize.X;
+
+                const bool bRightEyeRow = bTopBottom && Y >= EyeResolution.Y;
+                const int32 EyeRow = bRightEyeRow ? Y - EyeResolution.Y : Y;
+
+                int32 CoveredWidth = 0;
+                if (bLayoutFits && EyeRow < EyeResolution.Y)
+                {
+                    if (bStereo && bSideBySide)
+                    {
+                        Gather.GatherEyeRow(EyeRow, OutRow, OutRow + EyeResolution.X, TransparentPixel, ConvertColor);
+                    }
+                    else
+                    {
+                        Gather.GatherEyeRow(EyeRow, bRightEyeRow ? nullptr : OutRow, bRightEyeRow ? OutRow : nullptr, TransparentPixel, ConvertColor);
+                    }
+                    CoveredWidth = CoveredSize.X;
+                }
+
+                for (int32 X = CoveredWidth; X < OutputSize.X; ++X)
+                {
+                    OutRow[X] = TransparentPixel;
+                }
+            }
+        });
+    }
+
+    template <typename PixelType, typename ConvertFunc>
+    void GatherReprojectedPixels(
+        const FCPUReprojectionMap& Map,
+        const FCPUCubemap& LeftCubemap,
+        const FCPUCubemap* RightCubemap,
+        const FIntPoint& OutputSize,
+        bool bSideBySide,
+        int32 WorkerCount,
+        TArray64<PixelType>& OutPixels,
+        ConvertFunc ConvertColor)
+    {
+        if (LeftCubemap.Precision == EOmniCapturePixelPrecision::FullFloat)
+        {
+            GatherReprojectedPixelsFrom<FLinearColor>(Map, LeftCubemap, RightCubemap, OutputSize, bSideBySide, WorkerCount, OutPixels, ConvertColor);
+        }
+        else
+        {
+            GatherReprojectedPixelsFrom<FFloat16Color>(Map, LeftCubemap, RightCubemap, OutputSize, bSideBySide, WorkerCount, OutPixels, ConvertColor);
+        }
+    }
+
+    // Owns one frame's face data and hands out reprojected bands on request, so
+    // the image writer encodes the canvas without it ever being allocated whole.
+    class FCPUReprojectionRowSource final : public IOmniCaptureRowSource
+    {
+    public:
+        FCPUReprojectionRowSource(FCPUReprojectionMapPtr InMap, FCPUCubemap&& InLeftCubemap, FCPUCubemap* InRightCubemap, const FIntPoint& InOutputSize, bool bInSideBySide, bool bInHalfPrecision, int32 InWorkerCount)
+            : Map(MoveTemp(InMap))
+            , LeftCubemap(MoveTemp(InLeftCubemap))
+            , OutputSize(InOutputSize)
+            , bStereo(InRightCubemap != nullptr)
+            , bSideBySide(bInSideBySide)
+            , bHalfPrecision(bInHalfPrecision)
+            , WorkerCount(InWorkerCount)
+        {
+            if (InRightCubemap)
+            {
+                RightCubemap = MoveTemp(*InRightCubemap);
+            }
+        }
+
+        virtual FIntPoint GetSize() const override
+        {
+            return OutputSize;
+        }
+
+        virtual void ReadRows(int32 RowStart, int32 RowCount, TArray64<FLinearColor>& OutPixels) const override
+        {
+            RowCount = FMath::Clamp(RowCount, 0, OutputSize.Y - RowStart);
+            OutPixels.SetNumUninitialized(static_cast<int64>(RowCount) * OutputSize.X, EAllowShrinking::No);
+            if (RowCount <= 0)
+            {
+                return;
+            }
+
+            // Half-precision frames are rounded the way a materialized canvas would be.
+            const auto ReadAs = [&](auto ConvertColor)
+            {
+                if (LeftCubemap.Precision == EOmniCapturePixelPrecision::FullFloat)
+                {
+                    GatherReprojectedRowsFrom<FLinearColor>(*Map, LeftCubemap, bStereo ? &RightCubemap : nullptr, OutputSize, bSideBySide, WorkerCount, RowStart, RowCount, OutPixels.GetData(), ConvertColor);
+                }
+                else
+                {
+                    GatherReprojectedRowsFrom<FFloat16Color>(*Map, LeftCubemap, bStereo ? &RightCubemap : nullptr, OutputSize, bSideBySide, WorkerCount, RowStart, RowCount, OutPixels.GetData(), ConvertColor);
                 }
+            };
+
+            if (bHalfPrecision)
+            {
+                ReadAs([](const FLinearColor& Linear) { return FLinearColor(FFloat16Color(Linear)); });
+            }
+            else
+            {
+                ReadAs([](const FLinearColor& Linear) { return Linear; });
             }
         }
-    }
 
-namespace
-{
-    void ConvertOnCPU(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, FOmniCaptureEquirectResult& OutResult)
-    {
-        FCPUCubemap LeftCubemap;
-        if (!BuildCPUCubemap(LeftEye, LeftCubemap))
+        virtual int64 GetAllocatedSize() const override
         {
-            return;
+            // The map is shared between frames, so only the face texels are charged to this one.
+            return GetCubemapAllocatedSize(LeftCubemap) + GetCubemapAllocatedSize(RightCubemap);
         }
 
-        FCPUCubemap RightCubemap;
-        if (Settings.Mode == EOmniCaptureMode::Stereo)
+    private:
+        static int64 GetCubemapAllocatedSize(const FCPUCubemap& Cubemap)
         {
-            if (!BuildCPUCubemap(RightEye, RightCubemap))
+            int64 Bytes = 0;
+            for (const FCPUFaceData& Face : Cubemap.Faces)
             {
-                return;
+                Bytes += Face.HalfPixels.GetAllocatedSize() + Face.FloatPixels.GetAllocatedSize();
+                for (const TArray<FLinearColor>& Mip : Face.Mips)
+                {
+                    Bytes += Mip.GetAllocatedSize();
+                }
             }
+            return Bytes;
         }
 
-        const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
-        const bool bSideBySide = bStereo && Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide;
-        const int32 FaceResolution = LeftCubemap.Faces[0].Resolution;
-        const FIntPoint OutputSize = Settings.GetEquirectResolution();
-        const int32 OutputWidth = OutputSize.X;
-        const int32 OutputHeight = OutputSize.Y;
-        const double LongitudeSpan = Settings.GetLongitudeSpanRadians();
-        const double LatitudeSpan = Settings.GetLatitudeSpanRadians();
-        const bool bHalfSphere = Settings.IsVR180();
+        FCPUReprojectionMapPtr Map;
+        FCPUCubemap LeftCubemap;
+        FCPUCubemap RightCubemap;
+        FIntPoint OutputSize;
+        bool bStereo = false;
+        bool bSideBySide = false;
+        bool bHalfPrecision = false;
+        int32 WorkerCount = 0;
+    };
 
-        OutResult.Size = FIntPoint(OutputWidth, OutputHeight);
+    // Shared tail of the CPU conversions once the cubemaps, map and mips are ready.
+    void ResolveCPUConversion(
+        const FOmniCaptureSettings& Settings,
+        const FCPUReprojectionMapPtr& Map,
+        FCPUCubemap& LeftCubemap,
+        FCPUCubemap* RightCubemap,
+        const FIntPoint& OutputSize,
+        bool bSideBySide,
+        bool bStreamRows,
+        FOmniCaptureEquirectResult& OutResult)
+    {
+        OutResult.Size = OutputSize;
         OutResult.bIsLinear = Settings.Gamma == EOmniCaptureGamma::Linear;
         OutResult.bUsedCPUFallback = true;
         OutResult.OutputTarget.SafeRelease();
@@ -1269,105 +2158,128 @@ namespace
         OutResult.ReadyFence.SafeRelease();
         OutResult.EncoderPlanes.Reset();
 
-        const int32 PixelCount = OutputWidth * OutputHeight;
-        OutResult.PreviewPixels.SetNum(PixelCount);
         OutResult.PixelPrecision = LeftCubemap.Precision;
-
-        auto ProcessPixel = [&](auto& PixelArray, auto ConvertColor)
-        {
-            for (int32 Y = 0; Y < OutputHeight; ++Y)
-            {
-                for (int32 X = 0; X < OutputWidth; ++X)
-                {
-                    const int32 Index = Y * OutputWidth + X;
-
-                    FIntPoint EyePixel(X, Y);
-                    FIntPoint EyeResolution(OutputWidth, OutputHeight);
-                    bool bRightEye = false;
-
-                    if (bStereo)
-                    {
-                        if (bSideBySide)
-                        {
-                            const int32 EyeWidth = OutputWidth / 2;
-                            bRightEye = X >= EyeWidth;
-                            EyePixel.X = X % EyeWidth;
-                            EyeResolution = FIntPoint(EyeWidth, OutputHeight);
-                        }
-                        else
-                        {
-                            const int32 EyeHeight = OutputHeight / 2;
-                            bRightEye = Y >= EyeHeight;
-                            EyePixel.Y = Y % EyeHeight;
-                            EyeResolution = FIntPoint(OutputWidth, EyeHeight);
-                        }
-                    }
-
-                    float Latitude = 0.0f;
-                    FVector Direction = DirectionFromEquirectPixelCPU(EyePixel, EyeResolution, LongitudeSpan, LatitudeSpan, Latitude);
-                    ApplyPolarMitigation(Settings.PolarDampening, Latitude, Direction);
-
-                    if (bHalfSphere && Direction.X < 0.0f)
-                    {
-                        PixelArray[Index] = ConvertColor(FLinearColor::Transparent);
-                        OutResult.PreviewPixels[Index] = FColor::Transparent;
-                        continue;
-                    }
-
-                    const FLinearColor LinearColor = SampleCubemapCPU(
-                        (bStereo && bRightEye) ? RightCubemap : LeftCubemap,
-                        Direction,
-                        FaceResolution,
-                        Settings.SeamBlend);
-
-                    PixelArray[Index] = ConvertColor(LinearColor);
-                    OutResult.PreviewPixels[Index] = LinearColor.ToFColor(true);
-                }
-            }
-        };
-
         if (OutResult.bIsLinear)
         {
             if (OutResult.PixelPrecision == EOmniCapturePixelPrecision::FullFloat)
             {
-                TUniquePtr<TImagePixelData<FLinearColor>> PixelData = MakeUnique<TImagePixelData<FLinearColor>>(OutResult.Size);
-                PixelData->Pixels.SetNum(PixelCount);
-                ProcessPixel(PixelData->Pixels, [](const FLinearColor& Linear) { return Linear; });
-                OutResult.PixelData = MoveTemp(PixelData);
                 OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat32;
             }
             else
             {
                 OutResult.PixelPrecision = EOmniCapturePixelPrecision::HalfFloat;
-                TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = MakeUnique<TImagePixelData<FFloat16Color>>(OutResult.Size);
-                PixelData->Pixels.SetNum(PixelCount);
-                ProcessPixel(PixelData->Pixels, [](const FLinearColor& Linear) { return FFloat16Color(Linear); });
-                OutResult.PixelData = MoveTemp(PixelData);
                 OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat16;
             }
         }
         else
         {
-            TUniquePtr<TImagePixelData<FColor>> PixelData = MakeUnique<TImagePixelData<FColor>>(OutResult.Size);
-            PixelData->Pixels.SetNum(PixelCount);
-            ProcessPixel(PixelData->Pixels, [](const FLinearColor& Linear) { return Linear.ToFColor(true); });
-            OutResult.PixelData = MoveTemp(PixelData);
             OutResult.PixelDataType = EOmniCapturePixelDataType::Color8;
         }
+
+        if (bStreamRows)
+        {
+            // The face buffers move into the source and the cache refills them
+            // next frame; each frame in flight keeps only its own faces alive.
+            const bool bHalfPrecision = OutResult.PixelDataType == EOmniCapturePixelDataType::LinearColorFloat16;
+            OutResult.RowSource = MakeShared<FCPUReprojectionRowSource, ESPMode::ThreadSafe>(Map, MoveTemp(LeftCubemap), RightCubemap, OutputSize, bSideBySide, bHalfPrecision, Settings.CPUReprojectionWorkerCount);
+            return;
+        }
+
+        const int32 PixelCount = OutputSize.X * OutputSize.Y;
+
+        auto ProcessPixel = [&](auto& PixelArray, auto ConvertColor)
+        {
+            GatherReprojectedPixels(*Map, LeftCubemap, RightCubemap, OutputSize, bSideBySide, Settings.CPUReprojectionWorkerCount, PixelArray, ConvertColor);
+        };
+
+        switch (OutResult.PixelDataType)
+        {
+        case EOmniCapturePixelDataType::LinearColorFloat32:
+        {
+            TUniquePtr<TImagePixelData<FLinearColor>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<FLinearColor>(OutputSize);
+            ProcessPixel(PixelData->Pixels, [](const FLinearColor& Linear) { return Linear; });
+            OutResult.PixelData = MoveTemp(PixelData);
+            break;
+        }
+        case EOmniCapturePixelDataType::LinearColorFloat16:
+        {
+            TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<FFloat16Color>(OutputSize);
+            ProcessPixel(PixelData->Pixels, [](const FLinearColor& Linear) { return FFloat16Color(Linear); });
+            OutResult.PixelData = MoveTemp(PixelData);
+            break;
+        }
+        default:
+        {
+            TUniquePtr<TImagePixelData<FColor>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<FColor>(OutputSize);
+            ProcessPixel(PixelData->Pixels, [](const FLinearColor& Linear) { return FOmniCapturePixelKernels::ToSRGB8(Linear); });
+            OutResult.PixelData = MoveTemp(PixelData);
+            break;
+        }
+        }
     }
 
-    void ConvertFisheyeOnCPU(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, FOmniCaptureEquirectResult& OutResult)
+    void ConvertOnCPU(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, bool bStreamRows, FOmniCaptureEquirectResult& OutResult)
     {
-        FCPUCubemap LeftCubemap;
+        FScopeLock CubemapLock(&GCPUCubemapCS);
+
+        FCPUCubemap& LeftCubemap = GCPUCubemaps[0];
         if (!BuildCPUCubemap(LeftEye, LeftCubemap))
         {
             return;
         }
 
-        FCPUCubemap RightCubemap;
+        FCPUCubemap& RightCubemap = GCPUCubemaps[1];
+        if (Settings.Mode == EOmniCaptureMode::Stereo)
+        {
+            if (!BuildCPUCubemap(RightEye, RightCubemap)
+                || RightCubemap.Resolution != LeftCubemap.Resolution
+                || RightCubemap.FaceMask != LeftCubemap.FaceMask
+                || RightCubemap.Precision != LeftCubemap.Precision)
+            {
+                return;
+            }
+        }
+
+        const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
+        const bool bSideBySide = bStereo && Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide;
+        const int32 FaceResolution = LeftCubemap.Resolution;
+        const FIntPoint OutputSize = Settings.GetEquirectResolution();
+        const int32 OutputWidth = OutputSize.X;
+        const int32 OutputHeight = OutputSize.Y;
+
+        FIntPoint EyeResolution(OutputWidth, OutputHeight);
+        if (bStereo)
+        {
+            EyeResolution = bSideBySide ? FIntPoint(OutputWidth / 2, OutputHeight) : FIntPoint(OutputWidth, OutputHeight / 2);
+        }
+
+        const FCPUReprojectionMapPtr Map = FindOrBuildReprojectionMap(MakeEquirectReprojectionKey(Settings, EyeResolution, FaceResolution), Settings.CPUReprojectionWorkerCount);
+        if (!Map.IsValid())
+        {
+            return;
+        }
+
+        PrepareCubemapMips(*Map, LeftCubemap, bStereo ? &RightCubemap : nullptr, Settings.CPUReprojectionWorkerCount);
+        ResolveCPUConversion(Settings, Map, LeftCubemap, bStereo ? &RightCubemap : nullptr, OutputSize, bSideBySide, bStreamRows, OutResult);
+    }
+
+    void ConvertFisheyeOnCPU(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, bool bStreamRows, FOmniCaptureEquirectResult& OutResult)
+    {
+        FScopeLock CubemapLock(&GCPUCubemapCS);
+
+        FCPUCubemap& LeftCubemap = GCPUCubemaps[0];
+        if (!BuildCPUCubemap(LeftEye, LeftCubemap))
+        {
+            return;
+        }
+
+        FCPUCubemap& RightCubemap = GCPUCubemaps[1];
         if (Settings.Mode == EOmniCaptureMode::Stereo)
         {
-            if (!BuildCPUCubemap(RightEye, RightCubemap))
+            if (!BuildCPUCubemap(RightEye, RightCubemap)
+                || RightCubemap.Resolution != LeftCubemap.Resolution
+                || RightCubemap.FaceMask != LeftCubemap.FaceMask
+                || RightCubemap.Precision != LeftCubemap.Precision)
             {
                 return;
             }
@@ -1375,114 +2287,125 @@ namespace
 
         const bool bStereo = Settings.Mode == EOmniCaptureMode::Stereo;
         const bool bSideBySide = bStereo && Settings.StereoLayout == EOmniCaptureStereoLayout::SideBySide;
-        const int32 FaceResolution = LeftCubemap.Faces[0].Resolution;
+        const int32 FaceResolution = LeftCubemap.Resolution;
         const FIntPoint OutputSize = Settings.GetOutputResolution();
         const FIntPoint EyeSize = Settings.GetFisheyeResolution();
-        const bool bHalfSphere = Settings.IsVR180();
-        const double FovRadians = FMath::DegreesToRadians(FMath::Clamp(Settings.FisheyeFOV, 0.0f, 360.0f));
+        const FIntPoint EyeResolution(FMath::Max(1, EyeSize.X), FMath::Max(1, EyeSize.Y));
 
-        OutResult.Size = OutputSize;
-        OutResult.bIsLinear = Settings.Gamma == EOmniCaptureGamma::Linear;
-        OutResult.bUsedCPUFallback = true;
-        OutResult.OutputTarget.SafeRelease();
-        OutResult.Texture.SafeRelease();
-        OutResult.ReadyFence.SafeRelease();
-        OutResult.EncoderPlanes.Reset();
+        const FCPUReprojectionMapPtr Map = FindOrBuildReprojectionMap(MakeFisheyeReprojectionKey(Settings, EyeResolution, FaceResolution), Settings.CPUReprojectionWorkerCount);
+        if (!Map.IsValid())
+        {
+            return;
+        }
 
-        const int32 PixelCount = OutputSize.X * OutputSize.Y;
-        OutResult.PreviewPixels.SetNum(PixelCount);
-        OutResult.PixelPrecision = LeftCubemap.Precision;
+        PrepareCubemapMips(*Map, LeftCubemap, bStereo ? &RightCubemap : nullptr, Settings.CPUReprojectionWorkerCount);
+        ResolveCPUConversion(Settings, Map, LeftCubemap, bStereo ? &RightCubemap : nullptr, OutputSize, bSideBySide, bStreamRows, OutResult);
+    }
 
-        auto ProcessPixel = [&](auto& PixelArray, auto ConvertColor)
+    template <typename PixelType, typename ToColorFunc>
+    void DownsamplePreview(const TArray64<PixelType>& Source, const FIntPoint& SourceSize, const FIntPoint& PreviewSize, TArray<FColor>& OutPreview, ToColorFunc ToColor)
+    {
+        OutPreview.SetNumUninitialized(PreviewSize.X * PreviewSize.Y);
+
+        // Point-sample the centre of each preview cell; the preview is only a
+        // monitoring aid, so filtering is not worth the extra reads.
+        for (int32 Y = 0; Y < PreviewSize.Y; ++Y)
         {
-            for (int32 Y = 0; Y < OutputSize.Y; ++Y)
-            {
-                for (int32 X = 0; X < OutputSize.X; ++X)
-                {
-                    const int32 Index = Y * OutputSize.X + X;
+            const int32 SourceY = static_cast<int32>((static_cast<int64>(2 * Y + 1) * SourceSize.Y) / (2 * PreviewSize.Y));
+            const PixelType* SourceRow = Source.GetData() + static_cast<int64>(SourceY) * SourceSize.X;
+            FColor* DestRow = OutPreview.GetData() + Y * PreviewSize.X;
 
-                    FIntPoint EyePixel(X, Y);
-                    FIntPoint EyeResolution = EyeSize;
-                    bool bRightEye = false;
+            for (int32 X = 0; X < PreviewSize.X; ++X)
+            {
+                const int32 SourceX = static_cast<int32>((static_cast<int64>(2 * X + 1) * SourceSize.X) / (2 * PreviewSize.X));
+                DestRow[X] = ToColor(SourceRow[SourceX]);
+            }
+        }
+    }
 
-                    if (bStereo)
-                    {
-                        if (bSideBySide)
-                        {
-                            const int32 EyeWidth = FMath::Max(1, EyeSize.X);
-                            bRightEye = X >= EyeWidth;
-                            EyePixel.X = X % EyeWidth;
-                            EyeResolution = FIntPoint(EyeWidth, EyeSize.Y);
-                        }
-                        else
-                        {
-                            const int32 EyeHeight = FMath::Max(1, EyeSize.Y);
-                            bRightEye = Y >= EyeHeight;
-                            EyePixel.Y = Y % EyeHeight;
-                            EyeResolution = FIntPoint(EyeSize.X, EyeHeight);
-                        }
-                    }
+    void BuildPreviewPixels(const FOmniCaptureSettings& Settings, FOmniCaptureEquirectResult& Result)
+    {
+        Result.PreviewPixels.Reset();
+        Result.PreviewSize = FIntPoint::ZeroValue;
 
-                    bool bValid = false;
-                    FVector Direction = DirectionFromFisheyePixelCPU(EyePixel, EyeResolution, FovRadians, bValid);
-                    if (!bValid)
-                    {
-                        PixelArray[Index] = ConvertColor(FLinearColor::Transparent);
-                        OutResult.PreviewPixels[Index] = FColor::Transparent;
-                        continue;
-                    }
+        const FIntPoint SourceSize = Result.Size;
+        if (SourceSize.X <= 0 || SourceSize.Y <= 0)
+        {
+            return;
+        }
 
-                    if (bHalfSphere && Direction.X < 0.0f)
-                    {
-                        PixelArray[Index] = ConvertColor(FLinearColor::Transparent);
-                        OutResult.PreviewPixels[Index] = FColor::Transparent;
-                        continue;
-                    }
+        const FIntPoint PreviewSize = Settings.GetPreviewResolution(SourceSize);
 
-                    const FLinearColor LinearColor = SampleCubemapCPU(
-                        (bStereo && bRightEye) ? RightCubemap : LeftCubemap,
-                        Direction,
-                        FaceResolution,
-                        Settings.SeamBlend);
+        if (Result.RowSource.IsValid())
+        {
+            // Streamed frames have no canvas; reproject just the rows the preview samples.
+            TArray64<FLinearColor> SourceRow;
+            Result.PreviewPixels.SetNumUninitialized(PreviewSize.X * PreviewSize.Y);
+            for (int32 Y = 0; Y < PreviewSize.Y; ++Y)
+            {
+                const int32 SourceY = static_cast<int32>((static_cast<int64>(2 * Y + 1) * SourceSize.Y) / (2 * PreviewSize.Y));
+                Result.RowSource->ReadRows(SourceY, 1, SourceRow);
+                FColor* DestRow = Result.PreviewPixels.GetData() + Y * PreviewSize.X;
 
-                    PixelArray[Index] = ConvertColor(LinearColor);
-                    OutResult.PreviewPixels[Index] = LinearColor.ToFColor(true);
+                for (int32 X = 0; X < PreviewSize.X; ++X)
+                {
+                    const int32 SourceX = static_cast<int32>((static_cast<int64>(2 * X + 1) * SourceSize.X) / (2 * PreviewSize.X));
+                    DestRow[X] = FOmniCapturePixelKernels::ToSRGB8(SourceRow[SourceX]);
                 }
             }
-        };
 
-        if (OutResult.bIsLinear)
+            Result.PreviewSize = PreviewSize;
+            return;
+        }
+
+        if (!Result.PixelData.IsValid())
         {
-            if (OutResult.PixelPrecision == EOmniCapturePixelPrecision::FullFloat)
+            return;
+        }
+
+        const int64 SourcePixelCount = static_cast<int64>(SourceSize.X) * SourceSize.Y;
+
+        switch (Result.PixelDataType)
+        {
+        case EOmniCapturePixelDataType::LinearColorFloat32:
+        {
+            const TArray64<FLinearColor>& Pixels = static_cast<const TImagePixelData<FLinearColor>*>(Result.PixelData.Get())->Pixels;
+            if (Pixels.Num() != SourcePixelCount)
             {
-                TUniquePtr<TImagePixelData<FLinearColor>> PixelData = MakeUnique<TImagePixelData<FLinearColor>>(OutputSize);
-                PixelData->Pixels.SetNum(PixelCount);
-                ProcessPixel(PixelData->Pixels, [](const FLinearColor& Linear) { return Linear; });
-                OutResult.PixelData = MoveTemp(PixelData);
-                OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat32;
+                return;
             }
-            else
+            DownsamplePreview(Pixels, SourceSize, PreviewSize, Result.PreviewPixels, [](const FLinearColor& Pixel) { return FOmniCapturePixelKernels::ToSRGB8(Pixel); });
+            break;
+        }
+        case EOmniCapturePixelDataType::LinearColorFloat16:
+        {
+            const TArray64<FFloat16Color>& Pixels = static_cast<const TImagePixelData<FFloat16Color>*>(Result.PixelData.Get())->Pixels;
+            if (Pixels.Num() != SourcePixelCount)
             {
-                OutResult.PixelPrecision = EOmniCapturePixelPrecision::HalfFloat;
-                TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = MakeUnique<TImagePixelData<FFloat16Color>>(OutputSize);
-                PixelData->Pixels.SetNum(PixelCount);
-                ProcessPixel(PixelData->Pixels, [](const FLinearColor& Linear) { return FFloat16Color(Linear); });
-                OutResult.PixelData = MoveTemp(PixelData);
-                OutResult.PixelDataType = EOmniCapturePixelDataType::LinearColorFloat16;
+                return;
             }
+            DownsamplePreview(Pixels, SourceSize, PreviewSize, Result.PreviewPixels, [](const FFloat16Color& Pixel) { return FOmniCapturePixelKernels::ToSRGB8(Pixel); });
+            break;
         }
-        else
+        case EOmniCapturePixelDataType::Color8:
         {
-            TUniquePtr<TImagePixelData<FColor>> PixelData = MakeUnique<TImagePixelData<FColor>>(OutputSize);
-            PixelData->Pixels.SetNum(PixelCount);
-            ProcessPixel(PixelData->Pixels, [](const FLinearColor& Linear) { return Linear.ToFColor(true); });
-            OutResult.PixelData = MoveTemp(PixelData);
-            OutResult.PixelDataType = EOmniCapturePixelDataType::Color8;
+            const TArray64<FColor>& Pixels = static_cast<const TImagePixelData<FColor>*>(Result.PixelData.Get())->Pixels;
+            if (Pixels.Num() != SourcePixelCount)
+            {
+                return;
+            }
+            DownsamplePreview(Pixels, SourceSize, PreviewSize, Result.PreviewPixels, [](const FColor& Pixel) { return Pixel; });
+            break;
+        }
+        default:
+            return;
         }
+
+        Result.PreviewSize = PreviewSize;
     }
 }
 
-FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToEquirectangular(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye)
+FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToEquirectangular(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, bool bGeneratePreview, bool bStreamRows)
 {
     FOmniCaptureEquirectResult Result;
 
@@ -1542,7 +2465,11 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToEquirectangul
 #endif
     if (!bSupportsCompute)
     {
-        ConvertOnCPU(Settings, LeftEye, RightEye, Result);
+        ConvertOnCPU(Settings, LeftEye, RightEye, bStreamRows, Result);
+        if (bGeneratePreview)
+        {
+            BuildPreviewPixels(Settings, Result);
+        }
         return Result;
     }
 
@@ -1559,13 +2486,18 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToEquirectangul
 
     if (!Result.PixelData.IsValid() && (!Result.Texture.IsValid() || !Result.OutputTarget.IsValid()))
     {
-        ConvertOnCPU(Settings, LeftEye, RightEye, Result);
+        ConvertOnCPU(Settings, LeftEye, RightEye, bStreamRows, Result);
+    }
+
+    if (bGeneratePreview)
+    {
+        BuildPreviewPixels(Settings, Result);
     }
 
     return Result;
 }
 
-FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToFisheye(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye)
+FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToFisheye(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, bool bGeneratePreview, bool bStreamRows)
 {
     FOmniCaptureEquirectResult Result;
 
@@ -1638,13 +2570,18 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToFisheye(const
     }
     else
     {
-        ConvertFisheyeOnCPU(Settings, LeftEye, RightEye, Result);
+        ConvertFisheyeOnCPU(Settings, LeftEye, RightEye, bStreamRows, Result);
+    }
+
+    if (bGeneratePreview)
+    {
+        BuildPreviewPixels(Settings, Result);
     }
 
     return Result;
 }
 
-FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToPlanar(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& SourceEye)
+FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToPlanar(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& SourceEye, bool bGeneratePreview)
 {
     FOmniCaptureEquirectResult Result;
 
@@ -1679,8 +2616,6 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToPlanar(const
     Result.OutputTarget.SafeRelease();
     Result.GPUSource.SafeRelease();
 
-    const int32 PixelCount = OutputSize.X * OutputSize.Y;
-
     if (Result.bIsLinear)
     {
         TUniquePtr<TImagePixelData<FFloat16Color>> PixelData = MakeUnique<TImagePixelData<FFloat16Color>>(OutputSize);
@@ -1716,34 +2651,12 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToPlanar(const
 
     if (!Result.PixelData.IsValid())
     {
-        Result.PreviewPixels.Reset();
         return Result;
     }
 
-    Result.PreviewPixels.SetNum(PixelCount);
-    if (Result.bIsLinear)
-    {
-        const TImagePixelData<FFloat16Color>* FloatData = static_cast<const TImagePixelData<FFloat16Color>*>(Result.PixelData.Get());
-        if (FloatData)
-        {
-            for (int32 Index = 0; Index < PixelCount; ++Index)
-            {
-                Result.PreviewPixels[Index] = FLinearColor(FloatData->Pixels[Index]).ToFColor(true);
-            }
-        }
-    }
-    else
-    {
-        const TImagePixelData<FColor>* ColorData = static_cast<const TImagePixelData<FColor>*>(Result.PixelData.Get());
-        if (ColorData)
-        {
-            Result.PreviewPixels = ColorData->Pixels;
-        }
-    }
-
-    if (Result.PreviewPixels.Num() != PixelCount)
+    if (bGeneratePreview)
     {
-        Result.PreviewPixels.Init(FColor::Black, PixelCount);
+        BuildPreviewPixels(Settings, Result);
     }
 
     Result.Texture = Resource->GetRenderTargetTexture();
@@ -1763,3 +2676,108 @@ FOmniCaptureEquirectResult FOmniCaptureEquirectConverter::ConvertToPlanar(const
 
     return Result;
 }
+
+FOmniCaptureFaceCoverage FOmniCaptureEquirectConverter::ComputeFaceCoverage(const FOmniCaptureSettings& Settings)
+{
+    if (!Settings.bCullUnusedCubeFaces || Settings.IsPlanar())
+    {
+        return FOmniCaptureFaceCoverage();
+    }
+
+    const int32 FaceResolution = FMath::Max(1, Settings.Resolution);
+    const bool bFisheye = Settings.IsFisheye() && !Settings.ShouldConvertFisheyeToEquirect();
+    const bool bHalfSphere = Settings.IsVR180();
+    const double LongitudeSpan = Settings.GetLongitudeSpanRadians();
+    const double LatitudeSpan = Settings.GetLatitudeSpanRadians();
+    const double FisheyeFovRadians = FMath::DegreesToRadians(FMath::Clamp(Settings.FisheyeFOV, 0.0f, 360.0f));
+
+    // The projection is evaluated on a grid that includes the eye edges.
+    // AngularStep bounds the angle between neighbouring grid samples: faces
+    // that come within that angle of being the major axis count as sampled,
+    // and every rectangle is padded by the texels that angle can span, so
+    // nothing between grid samples is missed.
+    constexpr int32 GridSize = 1024;
+    const FIntPoint GridExtent(GridSize, GridSize);
+    const double AngularStep = 4.0 * PI / GridSize;
+
+    int32 PadTexels = FMath::CeilToInt(FaceResolution * AngularStep) + 2;
+    if (Settings.CPUSamplingQuality == EOmniCaptureCPUSamplingQuality::Prefiltered)
+    {
+        // Box-filtered mips gather texels from up to one coarsest-level texel away.
+        PadTexels += 1 << (MaxCPUFaceMipLevels - 1);
+    }
+
+    FIntPoint MinTexel[6];
+    FIntPoint MaxTexel[6];
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        MinTexel[FaceIndex] = FIntPoint(MAX_int32, MAX_int32);
+        MaxTexel[FaceIndex] = FIntPoint(-1, -1);
+    }
+
+    for (int32 GridY = 0; GridY <= GridSize; ++GridY)
+    {
+        for (int32 GridX = 0; GridX <= GridSize; ++GridX)
+        {
+            const FVector2D Position(GridX, GridY);
+
+            bool bValid = true;
+            const FVector Direction = bFisheye
+                ? DirectionFromFisheyePixelCPU(Position, GridExtent, FisheyeFovRadians, bValid)
+                : DirectionFromEquirectPositionCPU(Position, GridExtent, LongitudeSpan, LatitudeSpan, Settings.PolarDampening);
+
+            if (!bValid || (bHalfSphere && Direction.X < -AngularStep))
+            {
+                continue;
+            }
+
+            const double LargestAxis = Direction.GetAbs().GetMax();
+            for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+            {
+                double MajorAxis = 0.0;
+                double U = 0.0;
+                double V = 0.0;
+                if (!ProjectOntoCubeFace(FaceIndex, Direction, MajorAxis, U, V) || MajorAxis < LargestAxis - AngularStep)
+                {
+                    continue;
+                }
+
+                const FIntPoint Texel(
+                    FMath::Clamp(FMath::FloorToInt((U + 1.0) * 0.5 * FaceResolution), 0, FaceResolution - 1),
+                    FMath::Clamp(FMath::FloorToInt((V + 1.0) * 0.5 * FaceResolution), 0, FaceResolution - 1));
+                MinTexel[FaceIndex] = FIntPoint(FMath::Min(MinTexel[FaceIndex].X, Texel.X), FMath::Min(MinTexel[FaceIndex].Y, Texel.Y));
+                MaxTexel[FaceIndex] = FIntPoint(FMath::Max(MaxTexel[FaceIndex].X, Texel.X), FMath::Max(MaxTexel[FaceIndex].Y, Texel.Y));
+            }
+        }
+    }
+
+    FOmniCaptureFaceCoverage Coverage;
+    Coverage.FaceMask = 0;
+    for (int32 FaceIndex = 0; FaceIndex < 6; ++FaceIndex)
+    {
+        if (MaxTexel[FaceIndex].X < 0)
+        {
+            continue;
+        }
+
+        Coverage.FaceMask |= 1u << FaceIndex;
+        Coverage.FaceRects[FaceIndex] = FIntRect(
+            FMath::Max(0, MinTexel[FaceIndex].X - PadTexels),
+            FMath::Max(0, MinTexel[FaceIndex].Y - PadTexels),
+            FMath::Min(FaceResolution, MaxTexel[FaceIndex].X + PadTexels + 1),
+            FMath::Min(FaceResolution, MaxTexel[FaceIndex].Y + PadTexels + 1));
+    }
+
+    // Degenerate spans sample nothing; keep every face rather than none.
+    return Coverage.FaceMask != 0 ? Coverage : FOmniCaptureFaceCoverage();
+}
+
+void FOmniCaptureEquirectConverter::ReleaseCachedResources()
+{
+    {
+        FScopeLock Lock(&GReprojectionMapCS);
+        GCachedReprojectionMap.Reset();
+    }
+
+    ReleaseCPUCubemaps();
+}
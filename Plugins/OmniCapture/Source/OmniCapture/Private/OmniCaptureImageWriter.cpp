@@ -1,9 +1,11 @@
 #include "OmniCaptureImageWriter.h"
 
 
-#include "Async/Async.h"
 #include "Async/Future.h"
+#include "HAL/Event.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
 #include "IImageWrapperModule.h"
 #include "IImageWrapper.h"
 #include "ImageWriteQueue.h"
@@ -13,8 +15,19 @@
 #include "Modules/ModuleManager.h"
 #include "Containers/StringConv.h"
 #include "Internationalization/Internationalization.h"
+#include "JsonObjectConverter.h"
 #include "Math/Vector2D.h"
+#include "Misc/ScopeExit.h"
+#include "Serialization/MemoryWriter.h"
+#include "OmniCaptureDirectFileWriter.h"
+#include "OmniCapturePackedSequence.h"
+#include "OmniCaptureParallelPNGEncoder.h"
+#include "OmniCapturePixelBufferPool.h"
+#include "OmniCapturePixelKernels.h"
+#include "OmniCaptureQOIEncoder.h"
+#include "OmniCaptureRawContainer.h"
 #include "OmniCaptureVersion.h"
+#include "OmniCaptureWorkerPool.h"
 
 #include <exception>
 
@@ -28,6 +41,7 @@ THIRD_PARTY_INCLUDES_END
 
 #if WITH_OMNICAPTURE_OPENEXR
 THIRD_PARTY_INCLUDES_START
+#include "OpenEXR/ImfIO.h"
 #include "OpenEXR/ImfMultiPartOutputFile.h"
 #include "OpenEXR/ImfOutputFile.h"
 #include "OpenEXR/ImfOutputPart.h"
@@ -36,6 +50,7 @@ THIRD_PARTY_INCLUDES_START
 #include "OpenEXR/ImfStringAttribute.h"
 #include "OpenEXR/ImfCompression.h"
 #include "OpenEXR/ImfNamespace.h"
+#include "OpenEXR/ImfStdIO.h"
 #include "Imath/half.h"
 THIRD_PARTY_INCLUDES_END
 #endif
@@ -105,6 +120,52 @@ namespace
             return PixelType == OPENEXR_IMF_NAMESPACE::PixelType::FLOAT ? sizeof(float) : sizeof(IMATH_NAMESPACE::half);
         }
     };
+
+    // Collects an EXR in memory so it can go through SaveEncodedFile like the other formats.
+    class FExrMemoryStream final : public OPENEXR_IMF_NAMESPACE::OStream
+    {
+    public:
+        explicit FExrMemoryStream(const char FileName[])
+            : OStream(FileName)
+        {
+        }
+
+        virtual void write(const char Bytes[], int Count) override
+        {
+            const int64 End = Position + Count;
+            if (End > Data.Num())
+            {
+                Data.SetNumUninitialized(End, EAllowShrinking::No);
+            }
+            FMemory::Memcpy(Data.GetData() + Position, Bytes, Count);
+            Position = End;
+        }
+
+        virtual uint64_t tellp() override
+        {
+            return static_cast<uint64_t>(Position);
+        }
+
+        virtual void seekp(uint64_t Pos) override
+        {
+            Position = static_cast<int64>(Pos);
+        }
+
+        TArray64<uint8> Data;
+
+    private:
+        int64 Position = 0;
+    };
+
+    // OpenEXR writes the file itself unless the bytes are wanted in memory.
+    TUniquePtr<OPENEXR_IMF_NAMESPACE::OStream> CreateExrStream(const FString& FilePath, bool bInMemory)
+    {
+        if (bInMemory)
+        {
+            return MakeUnique<FExrMemoryStream>(TCHAR_TO_UTF8(*FilePath));
+        }
+        return MakeUnique<OPENEXR_IMF_NAMESPACE::StdOFStream>(TCHAR_TO_UTF8(*FilePath));
+    }
 #endif
 
     TSharedPtr<IImageWrapper> CreateImageWrapper(EImageFormat Format)
@@ -113,7 +174,7 @@ namespace
         return ImageWrapperModule.CreateImageWrapper(Format);
     }
 
-    bool WritePNGWithImageWrapper(const FString& FilePath, const FIntPoint& Size, const void* RawData, int64 RawSizeInBytes, ERGBFormat Format, int32 BitDepth)
+    bool EncodePNGWithImageWrapper(const FIntPoint& Size, const void* RawData, int64 RawSizeInBytes, ERGBFormat Format, int32 BitDepth, TArray64<uint8>& OutCompressedData)
     {
         if (!RawData || RawSizeInBytes <= 0 || Size.X <= 0 || Size.Y <= 0)
         {
@@ -131,14 +192,21 @@ namespace
             return false;
         }
 
-        const TArray64<uint8> CompressedData = ImageWrapper->GetCompressed(0);
-        if (CompressedData.Num() == 0)
+        OutCompressedData = ImageWrapper->GetCompressed(0);
+        return OutCompressedData.Num() > 0;
+    }
+
+    EThreadPriority ToThreadPriority(EOmniCaptureThreadPriority Priority)
+    {
+        switch (Priority)
         {
-            return false;
+        case EOmniCaptureThreadPriority::Lowest: return TPri_Lowest;
+        case EOmniCaptureThreadPriority::Normal: return TPri_Normal;
+        case EOmniCaptureThreadPriority::AboveNormal: return TPri_AboveNormal;
+        case EOmniCaptureThreadPriority::Highest: return TPri_Highest;
+        case EOmniCaptureThreadPriority::BelowNormal:
+        default: return TPri_BelowNormal;
         }
-
-        IFileManager::Get().Delete(*FilePath, false, true, false);
-        return FFileHelper::SaveArrayToFile(CompressedData, *FilePath);
     }
 
     FString NormalizeFilePath(const FString& InPath)
@@ -164,6 +232,32 @@ namespace
         }
     }
 
+    struct FPNGCompressionParams
+    {
+        int32 ZlibLevel = 6;
+        // libpng filter mask. A single filter is used on every row; several are chosen between per row.
+        int32 LibPngFilters = PNG_ALL_FILTERS;
+        // The same choice for the parallel encoder: a PNG filter type, or -1 for adaptive.
+        int32 FixedFilter = -1;
+    };
+
+    FPNGCompressionParams GetPNGCompressionParams(EOmniCapturePNGCompression Preset)
+    {
+        switch (Preset)
+        {
+        case EOmniCapturePNGCompression::StoreOnly:
+            // Filtering only helps deflate, so skip it when nothing is deflated.
+            return { 0, PNG_FILTER_NONE, 0 };
+        case EOmniCapturePNGCompression::Fast:
+            return { 1, PNG_FILTER_UP, 2 };
+        case EOmniCapturePNGCompression::Max:
+            return { 9, PNG_ALL_FILTERS, -1 };
+        case EOmniCapturePNGCompression::Default:
+        default:
+            return { 6, PNG_ALL_FILTERS, -1 };
+        }
+    }
+
     int32 GetPngColorType(ERGBFormat Format)
     {
         switch (Format)
@@ -204,13 +298,80 @@ namespace
             Archive->Flush();
         }
     }
+
+    // Streamed frames are reprojected at most this many bytes of linear colour at a time.
+    constexpr int64 RowSourceBandBytes = 16ll * 1024ll * 1024ll;
+
+    int32 GetRowSourceBandRows(int32 Width)
+    {
+        const int64 BytesPerRow = static_cast<int64>(FMath::Max(1, Width)) * sizeof(FLinearColor);
+        return static_cast<int32>(FMath::Clamp<int64>(RowSourceBandBytes / BytesPerRow, 1, MAX_int32));
+    }
+
+    // Pulls rows [RowStart, RowStart + RowCount) from the source band by band.
+    void ForEachSourceBand(const IOmniCaptureRowSource& Source, int32 RowStart, int32 RowCount, TArray64<FLinearColor>& Band, TFunctionRef<void(int32 BandStart, int32 BandRows)> Consume)
+    {
+        const int32 BandRows = GetRowSourceBandRows(Source.GetSize().X);
+        for (int32 BandStart = RowStart; BandStart < RowStart + RowCount; BandStart += BandRows)
+        {
+            const int32 RowsThisBand = FMath::Min(BandRows, RowStart + RowCount - BandStart);
+            Source.ReadRows(BandStart, RowsThisBand, Band);
+            Consume(BandStart, RowsThisBand);
+        }
+    }
+
+    template <typename PixelType, typename ConvertFunc>
+    TUniquePtr<FImagePixelData> MaterializeRowSourceAs(const IOmniCaptureRowSource& Source, ConvertFunc ConvertColor)
+    {
+        const FIntPoint Size = Source.GetSize();
+        TUniquePtr<TImagePixelData<PixelType>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<PixelType>(Size);
+
+        TArray64<FLinearColor> Band;
+        ForEachSourceBand(Source, 0, Size.Y, Band, [&](int32 BandStart, int32 BandRows)
+        {
+            PixelType* Dest = PixelData->Pixels.GetData() + static_cast<int64>(BandStart) * Size.X;
+            const int64 Count = static_cast<int64>(BandRows) * Size.X;
+            for (int64 Index = 0; Index < Count; ++Index)
+            {
+                Dest[Index] = ConvertColor(Band[Index]);
+            }
+        });
+
+        return PixelData;
+    }
+
+    // Builds the canvas a non-streamed frame of this type would have carried.
+    TUniquePtr<FImagePixelData> MaterializeRowSource(const IOmniCaptureRowSource& Source, EOmniCapturePixelDataType PixelDataType)
+    {
+        switch (PixelDataType)
+        {
+        case EOmniCapturePixelDataType::LinearColorFloat32:
+            return MaterializeRowSourceAs<FLinearColor>(Source, [](const FLinearColor& Linear) { return Linear; });
+        case EOmniCapturePixelDataType::LinearColorFloat16:
+            return MaterializeRowSourceAs<FFloat16Color>(Source, [](const FLinearColor& Linear) { return FFloat16Color(Linear); });
+        case EOmniCapturePixelDataType::Color8:
+            return MaterializeRowSourceAs<FColor>(Source, [](const FLinearColor& Linear) { return FOmniCapturePixelKernels::ToSRGB8(Linear); });
+        default:
+            return nullptr;
+        }
+    }
 }
 
 FOmniCaptureImageWriter::FOmniCaptureImageWriter()
 {
     bStopRequested.Store(false);
+    FailedWriteCount.Store(0);
+    TaskSlotFreedEvent = FPlatformProcess::GetSynchEventFromPool();
+}
+
+FOmniCaptureImageWriter::~FOmniCaptureImageWriter()
+{
+    Flush();
+    EncodePool.Reset();
+    FileWritePool.Reset();
+    FPlatformProcess::ReturnSynchEventToPool(TaskSlotFreedEvent);
+    TaskSlotFreedEvent = nullptr;
 }
-FOmniCaptureImageWriter::~FOmniCaptureImageWriter() { Flush(); }
 
 void FOmniCaptureImageWriter::Initialize(const FOmniCaptureSettings& Settings, const FString& InOutputDirectory)
 {
@@ -220,54 +381,143 @@ void FOmniCaptureImageWriter::Initialize(const FOmniCaptureSettings& Settings, c
     IFileManager::Get().MakeDirectory(*OutputDirectory, true);
     TargetFormat = Settings.ImageFormat;
     TargetPNGBitDepth = Settings.PNGBitDepth;
+    TargetPNGCompression = Settings.PNGCompression;
     MaxPendingTasks = FMath::Max(1, Settings.MaxPendingImageTasks);
+    bParallelPNGCompression = Settings.bParallelPNGCompression;
+    ParallelPNGThreadCount = FMath::Max(0, Settings.ParallelPNGThreadCount);
+    bParallelQOIEncoding = Settings.bParallelQOIEncoding;
+    ParallelQOIThreadCount = FMath::Max(0, Settings.ParallelQOIThreadCount);
     bPackEXRAuxiliaryLayers = Settings.bPackEXRAuxiliaryLayers;
     bUseEXRMultiPart = Settings.bUseEXRMultiPart;
+    bUnbufferedWrites = Settings.bUnbufferedImageWrites;
     TargetEXRCompression = Settings.EXRCompression;
+
+    // Replacing the pools drains whatever an earlier capture left queued.
+    const EThreadPriority Priority = ToThreadPriority(Settings.ImageWriterThreadPriority);
+    const uint64 AffinityMask = static_cast<uint64>(Settings.ImageWriterThreadAffinityMask);
+    const int32 EncodeThreads = Settings.ImageEncodeThreadCount > 0
+        ? Settings.ImageEncodeThreadCount
+        : FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 1, 1, MaxPendingTasks);
+    EncodePool = MakeUnique<FOmniCaptureWorkerPool>(TEXT("OmniCaptureImageEncode"), EncodeThreads, Priority, AffinityMask);
+    FileWritePool.Reset();
+    if (Settings.ImageFileWriteThreadCount > 0)
+    {
+        FileWritePool = MakeUnique<FOmniCaptureWorkerPool>(TEXT("OmniCaptureImageFileWrite"), Settings.ImageFileWriteThreadCount, Priority, AffinityMask);
+    }
+    FreeTaskSlots.store(MaxPendingTasks);
+
+    PackedSequence.Reset();
+    // Without OpenEXR, EXRs go through the engine's image write queue, which can only write files.
+    const bool bCanPackFormat = TargetFormat != EOmniCaptureImageFormat::OmniRaw
+        && (TargetFormat != EOmniCaptureImageFormat::EXR || WITH_OMNICAPTURE_OPENEXR);
+    if (Settings.PackedSequenceFramesPerFile > 0 && !bCanPackFormat && TargetFormat != EOmniCaptureImageFormat::OmniRaw)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Packed sequences need OpenEXR support for EXR output; writing individual files instead."));
+    }
+    if (Settings.PackedSequenceFramesPerFile > 0 && bCanPackFormat)
+    {
+        // Packs are filled per file, so count every layer a frame writes on its own.
+        const bool bLayersInFrameFile = TargetFormat == EOmniCaptureImageFormat::EXR && bPackEXRAuxiliaryLayers;
+        const int32 FilesPerFrame = 1 + (bLayersInFrameFile ? 0 : Settings.AuxiliaryPasses.Num());
+        PackedSequence = MakeUnique<FOmniCapturePackedSequenceWriter>(OutputDirectory, SequenceBaseName, Settings.PackedSequenceFramesPerFile * FilesPerFrame);
+    }
+
+    RawContainer.Reset();
+    if (TargetFormat == EOmniCaptureImageFormat::OmniRaw)
+    {
+        // The settings travel with the pixels so the container can be converted without the project.
+        FString SettingsJson;
+        FJsonObjectConverter::UStructToJsonObjectString(Settings, SettingsJson);
+
+        RawContainer = MakeUnique<FOmniCaptureRawContainerWriter>();
+        const FString ContainerPath = NormalizeFilePath(OutputDirectory / (SequenceBaseName + Settings.GetImageFileExtension()));
+        if (!RawContainer->Open(ContainerPath, SettingsJson))
+        {
+            RawContainer.Reset();
+            UE_LOG(LogTemp, Error, TEXT("OmniCapture could not open raw container %s"), *ContainerPath);
+            return;
+        }
+    }
+
     bStopRequested.Store(false);
     bInitialized = true;
 }
 
 void FOmniCaptureImageWriter::EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame, const FString& FrameFileName)
 {
-    if (!bInitialized || !Frame.IsValid() || IsStopRequested())
+    if (!Frame.IsValid())
     {
         return;
     }
 
-    PruneCompletedTasks();
-    WaitForAvailableTaskSlot();
+    if (SubmitFrame(*Frame, FrameFileName))
+    {
+        RecordFrame(Frame->Metadata);
+    }
+}
+
+bool FOmniCaptureImageWriter::SubmitFrame(FOmniCaptureFrame& Frame, const FString& FrameFileName)
+{
+    if (!bInitialized || IsStopRequested())
+    {
+        return false;
+    }
 
-    if (IsStopRequested())
+    DrainFailedWrites();
+    if (!AcquireTaskSlot())
     {
-        return;
+        return false;
+    }
+
+    if (RawContainer.IsValid())
+    {
+        return SubmitRawFrame(Frame);
     }
 
     FString TargetPath = NormalizeFilePath(OutputDirectory / FrameFileName);
-    FOmniCaptureFrameMetadata Metadata = Frame->Metadata;
-    bool bIsLinear = Frame->bLinearColor;
+    bool bIsLinear = Frame.bLinearColor;
 
-    TUniquePtr<FImagePixelData> PixelData = MoveTemp(Frame->PixelData);
-    TMap<FName, FOmniCaptureLayerPayload> AuxiliaryLayers = MoveTemp(Frame->AuxiliaryLayers);
-    if (!PixelData.IsValid())
+    TUniquePtr<FImagePixelData> PixelData = MoveTemp(Frame.PixelData);
+    TSharedPtr<IOmniCaptureRowSource, ESPMode::ThreadSafe> RowSource = MoveTemp(Frame.RowSource);
+    TMap<FName, FOmniCaptureLayerPayload> AuxiliaryLayers = MoveTemp(Frame.AuxiliaryLayers);
+    if (!PixelData.IsValid() && !RowSource.IsValid())
     {
-        return;
+        ReleaseTaskSlot();
+        return false;
     }
 
-    const EOmniCapturePixelPrecision PixelPrecision = Frame->PixelPrecision;
-    const EOmniCapturePixelDataType PixelDataType = Frame->PixelDataType;
+    const EOmniCapturePixelPrecision PixelPrecision = Frame.PixelPrecision;
+    const EOmniCapturePixelDataType PixelDataType = Frame.PixelDataType;
     const FString LayerDirectory = FPaths::GetPath(TargetPath);
     const FString LayerBaseName = FPaths::GetBaseFilename(TargetPath);
     const FString LayerExtension = FPaths::GetExtension(TargetPath, true);
 
-    TFuture<bool> Future = Async(EAsyncExecution::ThreadPool, [this, FilePath = MoveTemp(TargetPath), Format = TargetFormat, bIsLinear, PixelPrecision, PixelDataType, PixelData = MoveTemp(PixelData), AuxiliaryLayers = MoveTemp(AuxiliaryLayers), LayerDirectory, LayerBaseName, LayerExtension]() mutable
+    const FString ReportedPath = TargetPath;
+    TUniqueFunction<bool()> WriteTask = [this, FilePath = MoveTemp(TargetPath), Format = TargetFormat, bIsLinear, PixelPrecision, PixelDataType, PixelData = MoveTemp(PixelData), RowSource = MoveTemp(RowSource), AuxiliaryLayers = MoveTemp(AuxiliaryLayers), LayerDirectory, LayerBaseName, LayerExtension]() mutable
     {
-        if (Format == EOmniCaptureImageFormat::EXR)
+        if (RowSource.IsValid() && !CanStreamRows(Format, AuxiliaryLayers.Num() > 0))
         {
-            return WriteEXRFrame(FilePath, bIsLinear, MoveTemp(PixelData), PixelPrecision, PixelDataType, MoveTemp(AuxiliaryLayers), LayerDirectory, LayerBaseName, LayerExtension);
+            // Encoders without a scanline interface still get a full canvas.
+            PixelData = MaterializeRowSource(*RowSource, PixelDataType);
+            RowSource.Reset();
         }
 
-        bool bResult = WritePixelDataToDisk(MoveTemp(PixelData), FilePath, Format, bIsLinear, PixelPrecision, PixelDataType);
+        bool bResult = false;
+        if (RowSource.IsValid())
+        {
+            bResult = Format == EOmniCaptureImageFormat::EXR
+                ? WriteEXRFromRowSource(*RowSource, FilePath, bIsLinear, PixelDataType)
+                : WritePNGFromRowSource(*RowSource, FilePath, bIsLinear);
+            RowSource.Reset();
+        }
+        else if (Format == EOmniCaptureImageFormat::EXR)
+        {
+            return WriteEXRFrame(FilePath, bIsLinear, MoveTemp(PixelData), PixelPrecision, PixelDataType, MoveTemp(AuxiliaryLayers), LayerDirectory, LayerBaseName, LayerExtension);
+        }
+        else
+        {
+            bResult = WritePixelDataToDisk(MoveTemp(PixelData), FilePath, Format, bIsLinear, PixelPrecision, PixelDataType);
+        }
 
         for (TPair<FName, FOmniCaptureLayerPayload>& Pair : AuxiliaryLayers)
         {
@@ -298,26 +548,89 @@ void FOmniCaptureImageWriter::EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame
         }
 
         return bResult;
+    };
+
+    EncodePool->Enqueue([this, WriteTask = MoveTemp(WriteTask), ReportedPath]() mutable
+    {
+        if (!WriteTask())
+        {
+            ReportFailedWrite(ReportedPath);
+        }
+        ReleaseTaskSlot();
     });
 
-    TrackPendingTask(MoveTemp(Future));
-    PruneCompletedTasks();
-    EnforcePendingTaskLimit();
+    return true;
+}
+
+bool FOmniCaptureImageWriter::SubmitRawFrame(FOmniCaptureFrame& Frame)
+{
+    TUniquePtr<FOmniCaptureFrame> RawFrame = MakeUnique<FOmniCaptureFrame>();
+    RawFrame->Metadata = Frame.Metadata;
+    RawFrame->PixelData = MoveTemp(Frame.PixelData);
+    RawFrame->RowSource = MoveTemp(Frame.RowSource);
+    RawFrame->AuxiliaryLayers = MoveTemp(Frame.AuxiliaryLayers);
+    RawFrame->bLinearColor = Frame.bLinearColor;
+    RawFrame->PixelPrecision = Frame.PixelPrecision;
+    RawFrame->PixelDataType = Frame.PixelDataType;
+    if (!RawFrame->PixelData.IsValid() && !RawFrame->RowSource.IsValid())
+    {
+        ReleaseTaskSlot();
+        return false;
+    }
 
+    EncodePool->Enqueue([this, RawFrame = MoveTemp(RawFrame)]() mutable
     {
-        FScopeLock Lock(&MetadataCS);
-        CapturedMetadata.Add(Metadata);
+        if (RawFrame->RowSource.IsValid())
+        {
+            RawFrame->PixelData = MaterializeRowSource(*RawFrame->RowSource, RawFrame->PixelDataType);
+            RawFrame->RowSource.Reset();
+        }
+
+        // Appending is only a copy to disk, so frames already queued are kept even when stopping.
+        if (!RawContainer->AppendFrame(*RawFrame))
+        {
+            ReportFailedWrite(FString::Printf(TEXT("%s frame %d"), *RawContainer->GetFilePath(), RawFrame->Metadata.FrameIndex));
+        }
+        FOmniCapturePixelBufferPool::Get().ReleaseFrame(*RawFrame);
+        ReleaseTaskSlot();
+    });
+
+    return true;
+}
+
+void FOmniCaptureImageWriter::RecordFrame(const FOmniCaptureFrameMetadata& Metadata)
+{
+    if (!bInitialized || IsStopRequested())
+    {
+        return;
     }
+
+    FScopeLock Lock(&MetadataCS);
+    CapturedMetadata.Add(Metadata);
 }
 
 void FOmniCaptureImageWriter::Flush()
 {
     RequestStop();
-    PruneCompletedTasks();
     WaitForAllTasks();
+    if (RawContainer.IsValid())
+    {
+        RawContainer->Close();
+        RawContainer.Reset();
+    }
+    if (PackedSequence.IsValid())
+    {
+        PackedSequence->Close();
+        PackedSequence.Reset();
+    }
     bInitialized = false;
 }
 
+void FOmniCaptureImageWriter::WaitForPendingWrites()
+{
+    WaitForAllTasks();
+}
+
 TArray<FOmniCaptureFrameMetadata> FOmniCaptureImageWriter::ConsumeCapturedFrames()
 {
     FScopeLock Lock(&MetadataCS);
@@ -340,6 +653,12 @@ bool FOmniCaptureImageWriter::WritePixelDataToDisk(TUniquePtr<FImagePixelData> P
 
     EOmniCapturePixelDataType EffectiveType = PixelDataType;
 
+    // Whatever is still owned here once the file is written goes back to the pool.
+    ON_SCOPE_EXIT
+    {
+        FOmniCapturePixelBufferPool::Get().Release(MoveTemp(PixelData), EffectiveType);
+    };
+
     if (Format != EOmniCaptureImageFormat::EXR)
     {
         if (EffectiveType == EOmniCapturePixelDataType::ScalarFloat32)
@@ -466,6 +785,35 @@ bool FOmniCaptureImageWriter::WritePixelDataToDisk(TUniquePtr<FImagePixelData> P
             }
         }
         break;
+    case EOmniCaptureImageFormat::QOI:
+        if (bIsLinear)
+        {
+            if (PixelPrecision == EOmniCapturePixelPrecision::FullFloat)
+            {
+                if (RequireType(EOmniCapturePixelDataType::LinearColorFloat32))
+                {
+                    const TImagePixelData<FLinearColor>* LinearQOI = static_cast<const TImagePixelData<FLinearColor>*>(PixelData.Get());
+                    bWriteSuccessful = WriteQOIFromLinearFloat32(*LinearQOI, FilePath);
+                }
+            }
+            else
+            {
+                if (RequireType(EOmniCapturePixelDataType::LinearColorFloat16))
+                {
+                    const TImagePixelData<FFloat16Color>* LinearQOI = static_cast<const TImagePixelData<FFloat16Color>*>(PixelData.Get());
+                    bWriteSuccessful = WriteQOIFromLinear(*LinearQOI, FilePath);
+                }
+            }
+        }
+        else
+        {
+            if (RequireType(EOmniCapturePixelDataType::Color8))
+            {
+                const TImagePixelData<FColor>* QoiColor = static_cast<const TImagePixelData<FColor>*>(PixelData.Get());
+                bWriteSuccessful = WriteQOI(*QoiColor, FilePath);
+            }
+        }
+        break;
     case EOmniCaptureImageFormat::PNG:
     default:
         if (bIsLinear)
@@ -553,7 +901,9 @@ bool FOmniCaptureImageWriter::WritePNGRaw(const FString& FilePath, const FIntPoi
 
     if (BitDepth == 8)
     {
-        return WritePNGWithImageWrapper(FilePath, Size, RawData, RawSizeInBytes, Format, BitDepth);
+        TArray64<uint8> CompressedData;
+        return EncodePNGWithImageWrapper(Size, RawData, RawSizeInBytes, Format, BitDepth, CompressedData)
+            && SaveEncodedFile(MoveTemp(CompressedData), FilePath);
     }
 
     return false;
@@ -591,8 +941,41 @@ bool FOmniCaptureImageWriter::WritePNGWithRowSource(const FString& FilePath, con
         return false;
     }
 
-    IFileManager::Get().Delete(*FilePath, false, true, false);
-    TUniquePtr<FArchive> Archive(IFileManager::Get().CreateFileWriter(*FilePath));
+    const FPNGCompressionParams Compression = GetPNGCompressionParams(TargetPNGCompression);
+
+    if (bParallelPNGCompression && FOmniCaptureParallelPNGEncoder::SupportsFormat(Channels, BitDepth))
+    {
+        FOmniCapturePNGEncodeOptions Options;
+        Options.Channels = Channels;
+        Options.BitDepth = BitDepth;
+        Options.bBGROrder = Format == ERGBFormat::BGRA;
+        Options.CompressionLevel = Compression.ZlibLevel;
+        Options.FixedFilter = Compression.FixedFilter;
+        Options.ThreadCount = ParallelPNGThreadCount;
+
+        TArray64<uint8> EncodedData;
+        if (!FOmniCaptureParallelPNGEncoder::Encode(Size, Options, PrepareRows, [this]() { return IsStopRequested(); }, EncodedData))
+        {
+            return false;
+        }
+        return SaveEncodedFile(MoveTemp(EncodedData), FilePath);
+    }
+
+    // With a file-write stage or a packed sequence the image is compressed into memory and handed over once complete.
+    const bool bEncodeInMemory = FileWritePool.IsValid() || PackedSequence.IsValid();
+    TArray64<uint8> EncodedData;
+    TUniquePtr<FArchive> Archive;
+    if (bEncodeInMemory)
+    {
+        Archive = MakeUnique<FMemoryWriter64>(EncodedData);
+    }
+    else
+    {
+        IFileManager::Get().Delete(*FilePath, false, true, false);
+        // Raw size is an upper bound for all but incompressible images; the file is trimmed on close.
+        Archive = CreateImageFileWriter(FilePath, BytesPerRow * Size.Y);
+    }
+
     if (!Archive.IsValid())
     {
         return false;
@@ -623,6 +1006,8 @@ bool FOmniCaptureImageWriter::WritePNGWithRowSource(const FString& FilePath, con
 
     png_set_write_fn(PngPtr, Archive.Get(), PngWriteDataCallback, PngFlushCallback);
     png_set_IHDR(PngPtr, InfoPtr, Size.X, Size.Y, BitDepth, ColorType, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_set_compression_level(PngPtr, Compression.ZlibLevel);
+    png_set_filter(PngPtr, PNG_FILTER_TYPE_BASE, Compression.LibPngFilters);
 
     if (BitDepth == 16)
     {
@@ -666,7 +1051,12 @@ bool FOmniCaptureImageWriter::WritePNGWithRowSource(const FString& FilePath, con
     png_destroy_write_struct(&PngPtr, &InfoPtr);
 
     Archive->Close();
-    return !Archive->IsError();
+    if (Archive->IsError())
+    {
+        return false;
+    }
+
+    return !bEncodeInMemory || SaveEncodedFile(MoveTemp(EncodedData), FilePath);
 #else
     return false;
 #endif
@@ -761,14 +1151,13 @@ bool FOmniCaptureImageWriter::WriteBMP(const TImagePixelData<FColor>& PixelData,
         return false;
     }
 
-    const TArray64<uint8> CompressedData = ImageWrapper->GetCompressed(0);
+    TArray64<uint8> CompressedData = ImageWrapper->GetCompressed(0);
     if (CompressedData.Num() == 0)
     {
         return false;
     }
 
-    IFileManager::Get().Delete(*FilePath, false, true, false);
-    return FFileHelper::SaveArrayToFile(CompressedData, *FilePath);
+    return SaveEncodedFile(MoveTemp(CompressedData), FilePath);
 }
 
 bool FOmniCaptureImageWriter::WritePNGFromLinear(const TImagePixelData<FFloat16Color>& PixelData, const FString& FilePath) const
@@ -792,26 +1181,13 @@ bool FOmniCaptureImageWriter::WritePNGFromLinear(const TImagePixelData<FFloat16C
             const int64 RequiredSize = BytesPerRow * RowCount;
             TempBuffer.SetNum(RequiredSize, EAllowShrinking::No);
 
-            const auto ToUInt16 = [](float Value) -> uint16
-            {
-                const float Clamped = FMath::Clamp(Value, 0.0f, 1.0f);
-                return static_cast<uint16>(FMath::RoundToInt(Clamped * 65535.0f));
-            };
-
             for (int32 Row = 0; Row < RowCount; ++Row)
             {
                 uint8* RowData = TempBuffer.GetData() + BytesPerRow * Row;
                 RowPointers[Row] = RowData;
                 uint16* Dest = reinterpret_cast<uint16*>(RowData);
                 const int64 PixelRowStart = static_cast<int64>(RowStart + Row) * Size.X;
-                for (int32 Column = 0; Column < Size.X; ++Column)
-                {
-                    const FFloat16Color& Pixel = PixelData.Pixels[PixelRowStart + Column];
-                    *Dest++ = ToUInt16(Pixel.B.GetFloat());
-                    *Dest++ = ToUInt16(Pixel.G.GetFloat());
-                    *Dest++ = ToUInt16(Pixel.R.GetFloat());
-                    *Dest++ = ToUInt16(Pixel.A.GetFloat());
-                }
+                FOmniCapturePixelKernels::LinearToUNorm16BGRA(&PixelData.Pixels[PixelRowStart], Size.X, Dest);
             }
         };
 
@@ -823,21 +1199,7 @@ bool FOmniCaptureImageWriter::WritePNGFromLinear(const TImagePixelData<FFloat16C
     TArray64<uint8> ConvertedPixels;
     ConvertedPixels.SetNum(PixelCount * 4, EAllowShrinking::No);
 
-    for (int64 PixelIndex = 0; PixelIndex < PixelCount; ++PixelIndex)
-    {
-        const FFloat16Color& Pixel = PixelData.Pixels[PixelIndex];
-        const FLinearColor Linear(
-            Pixel.R.GetFloat(),
-            Pixel.G.GetFloat(),
-            Pixel.B.GetFloat(),
-            Pixel.A.GetFloat());
-        const FColor Converted = Linear.ToFColor(true);
-        const int64 Offset = PixelIndex * 4;
-        ConvertedPixels[Offset + 0] = Converted.B;
-        ConvertedPixels[Offset + 1] = Converted.G;
-        ConvertedPixels[Offset + 2] = Converted.R;
-        ConvertedPixels[Offset + 3] = Converted.A;
-    }
+    FOmniCapturePixelKernels::LinearToSRGB8(PixelData.Pixels.GetData(), PixelCount, reinterpret_cast<FColor*>(ConvertedPixels.GetData()));
 
     uint8* ConvertedBasePtr = ConvertedPixels.GetData();
     auto PrepareRows = [ConvertedBasePtr, BytesPerRow](int32 RowStart, int32 RowCount, int64, TArray64<uint8>& TempBuffer, TArray<uint8*>& RowPointers)
@@ -854,7 +1216,9 @@ bool FOmniCaptureImageWriter::WritePNGFromLinear(const TImagePixelData<FFloat16C
         return true;
     }
 
-    return WritePNGWithImageWrapper(FilePath, Size, ConvertedPixels.GetData(), ConvertedPixels.Num(), ERGBFormat::BGRA, 8);
+    TArray64<uint8> CompressedData;
+    return EncodePNGWithImageWrapper(Size, ConvertedPixels.GetData(), ConvertedPixels.Num(), ERGBFormat::BGRA, 8, CompressedData)
+        && SaveEncodedFile(MoveTemp(CompressedData), FilePath);
 }
 
 bool FOmniCaptureImageWriter::WritePNGFromLinearFloat32(const TImagePixelData<FLinearColor>& PixelData, const FString& FilePath) const
@@ -878,26 +1242,13 @@ bool FOmniCaptureImageWriter::WritePNGFromLinearFloat32(const TImagePixelData<FL
             const int64 RequiredSize = BytesPerRow * RowCount;
             TempBuffer.SetNum(RequiredSize, EAllowShrinking::No);
 
-            const auto ToUInt16 = [](float Value) -> uint16
-            {
-                const float Clamped = FMath::Clamp(Value, 0.0f, 1.0f);
-                return static_cast<uint16>(FMath::RoundToInt(Clamped * 65535.0f));
-            };
-
             for (int32 Row = 0; Row < RowCount; ++Row)
             {
                 uint8* RowData = TempBuffer.GetData() + BytesPerRow * Row;
                 RowPointers[Row] = RowData;
                 uint16* Dest = reinterpret_cast<uint16*>(RowData);
                 const int64 PixelRowStart = static_cast<int64>(RowStart + Row) * Size.X;
-                for (int32 Column = 0; Column < Size.X; ++Column)
-                {
-                    const FLinearColor& Pixel = PixelData.Pixels[PixelRowStart + Column];
-                    *Dest++ = ToUInt16(Pixel.B);
-                    *Dest++ = ToUInt16(Pixel.G);
-                    *Dest++ = ToUInt16(Pixel.R);
-                    *Dest++ = ToUInt16(Pixel.A);
-                }
+                FOmniCapturePixelKernels::LinearToUNorm16BGRA(&PixelData.Pixels[PixelRowStart], Size.X, Dest);
             }
         };
 
@@ -914,22 +1265,83 @@ bool FOmniCaptureImageWriter::WritePNGFromLinearFloat32(const TImagePixelData<FL
             uint8* RowData = TempBuffer.GetData() + BytesPerRow * Row;
             RowPointers[Row] = RowData;
             const int64 PixelRowStart = static_cast<int64>(RowStart + Row) * Size.X;
-            for (int32 Column = 0; Column < Size.X; ++Column)
-            {
-                const FLinearColor& Pixel = PixelData.Pixels[PixelRowStart + Column];
-                const FColor Converted = Pixel.ToFColor(true);
-                const int64 Offset = static_cast<int64>(Column) * 4;
-                RowData[Offset + 0] = Converted.B;
-                RowData[Offset + 1] = Converted.G;
-                RowData[Offset + 2] = Converted.R;
-                RowData[Offset + 3] = Converted.A;
-            }
+            FOmniCapturePixelKernels::LinearToSRGB8(&PixelData.Pixels[PixelRowStart], Size.X, reinterpret_cast<FColor*>(RowData));
         }
     };
 
     return WritePNGWithRowSource(FilePath, Size, ERGBFormat::BGRA, 8, PrepareRows8Bit);
 }
 
+bool FOmniCaptureImageWriter::CanStreamRows(EOmniCaptureImageFormat Format, bool bHasAuxiliaryLayers) const
+{
+    switch (Format)
+    {
+    case EOmniCaptureImageFormat::PNG:
+#if WITH_LIBPNG
+        return true;
+#else
+        return false;
+#endif
+    case EOmniCaptureImageFormat::EXR:
+        // Auxiliary layers arrive as full canvases and are written with the beauty pass.
+        return WITH_OMNICAPTURE_OPENEXR && !bHasAuxiliaryLayers;
+    default:
+        return false;
+    }
+}
+
+bool FOmniCaptureImageWriter::WritePNGFromRowSource(const IOmniCaptureRowSource& Source, const FString& FilePath, bool bIsLinear) const
+{
+    const FIntPoint Size = Source.GetSize();
+    if (Size.X <= 0 || Size.Y <= 0)
+    {
+        return false;
+    }
+
+    if (IsStopRequested())
+    {
+        return false;
+    }
+
+    // Same encodings as WritePNG (display-referred) and WritePNGFromLinear*.
+    const bool b16Bit = TargetPNGBitDepth == EOmniCapturePNGBitDepth::BitDepth16;
+    TArray64<FLinearColor> Band;
+    TArray<FColor> DisplayRow;
+
+    auto PrepareRows = [&](int32 RowStart, int32 RowCount, int64 BytesPerRow, TArray64<uint8>& TempBuffer, TArray<uint8*>& RowPointers)
+    {
+        TempBuffer.SetNum(BytesPerRow * RowCount, EAllowShrinking::No);
+
+        ForEachSourceBand(Source, RowStart, RowCount, Band, [&](int32 BandStart, int32 BandRows)
+        {
+            for (int32 BandRow = 0; BandRow < BandRows; ++BandRow)
+            {
+                const int32 Row = BandStart - RowStart + BandRow;
+                uint8* RowData = TempBuffer.GetData() + BytesPerRow * Row;
+                RowPointers[Row] = RowData;
+                const FLinearColor* Pixels = Band.GetData() + static_cast<int64>(BandRow) * Size.X;
+
+                if (b16Bit && bIsLinear)
+                {
+                    FOmniCapturePixelKernels::LinearToUNorm16BGRA(Pixels, Size.X, reinterpret_cast<uint16*>(RowData));
+                }
+                else if (b16Bit)
+                {
+                    DisplayRow.SetNumUninitialized(Size.X, EAllowShrinking::No);
+                    FOmniCapturePixelKernels::LinearToSRGB8(Pixels, Size.X, DisplayRow.GetData());
+                    FOmniCapturePixelKernels::SRGB8ToUNorm16BGRA(DisplayRow.GetData(), Size.X, reinterpret_cast<uint16*>(RowData));
+                }
+                else
+                {
+                    FOmniCapturePixelKernels::LinearToSRGB8(Pixels, Size.X, reinterpret_cast<FColor*>(RowData));
+                }
+            }
+        });
+    };
+
+    return WritePNGWithRowSource(FilePath, Size, ERGBFormat::BGRA, b16Bit ? 16 : 8, PrepareRows);
+}
+
 bool FOmniCaptureImageWriter::WriteBMPFromLinear(const TImagePixelData<FFloat16Color>& PixelData, const FString& FilePath) const
 {
     const FIntPoint Size = PixelData.GetSize();
@@ -944,21 +1356,9 @@ bool FOmniCaptureImageWriter::WriteBMPFromLinear(const TImagePixelData<FFloat16C
         return false;
     }
 
-    TArray<FColor> Converted;
-    Converted.SetNum(ExpectedCount);
-    for (int32 Index = 0; Index < ExpectedCount; ++Index)
-    {
-        const FFloat16Color& Pixel = PixelData.Pixels[Index];
-        const FLinearColor Linear(
-            Pixel.R.GetFloat(),
-            Pixel.G.GetFloat(),
-            Pixel.B.GetFloat(),
-            Pixel.A.GetFloat());
-        Converted[Index] = Linear.ToFColor(true);
-    }
-
     TUniquePtr<TImagePixelData<FColor>> TempData = MakeUnique<TImagePixelData<FColor>>(Size);
-    TempData->Pixels = MoveTemp(Converted);
+    TempData->Pixels.SetNumUninitialized(ExpectedCount);
+    FOmniCapturePixelKernels::LinearToSRGB8(PixelData.Pixels.GetData(), ExpectedCount, TempData->Pixels.GetData());
     return WriteBMP(*TempData, FilePath);
 }
 
@@ -977,12 +1377,8 @@ bool FOmniCaptureImageWriter::WriteBMPFromLinearFloat32(const TImagePixelData<FL
     }
 
     TUniquePtr<TImagePixelData<FColor>> TempData = MakeUnique<TImagePixelData<FColor>>(Size);
-    TempData->Pixels.SetNum(ExpectedCount);
-
-    for (int32 Index = 0; Index < ExpectedCount; ++Index)
-    {
-        TempData->Pixels[Index] = PixelData.Pixels[Index].ToFColor(true);
-    }
+    TempData->Pixels.SetNumUninitialized(ExpectedCount);
+    FOmniCapturePixelKernels::LinearToSRGB8(PixelData.Pixels.GetData(), ExpectedCount, TempData->Pixels.GetData());
 
     return WriteBMP(*TempData, FilePath);
 }
@@ -1012,14 +1408,13 @@ bool FOmniCaptureImageWriter::WriteJPEG(const TImagePixelData<FColor>& PixelData
         return false;
     }
 
-    const TArray64<uint8> CompressedData = ImageWrapper->GetCompressed(DefaultJpegQuality);
+    TArray64<uint8> CompressedData = ImageWrapper->GetCompressed(DefaultJpegQuality);
     if (CompressedData.Num() == 0)
     {
         return false;
     }
 
-    IFileManager::Get().Delete(*FilePath, false, true, false);
-    return FFileHelper::SaveArrayToFile(CompressedData, *FilePath);
+    return SaveEncodedFile(MoveTemp(CompressedData), FilePath);
 }
 
 bool FOmniCaptureImageWriter::WriteJPEGFromLinear(const TImagePixelData<FFloat16Color>& PixelData, const FString& FilePath) const
@@ -1036,25 +1431,62 @@ bool FOmniCaptureImageWriter::WriteJPEGFromLinear(const TImagePixelData<FFloat16
         return false;
     }
 
-    TArray<FColor> Converted;
-    Converted.SetNum(ExpectedCount);
-    for (int32 Index = 0; Index < ExpectedCount; ++Index)
+    TUniquePtr<TImagePixelData<FColor>> TempData = MakeUnique<TImagePixelData<FColor>>(Size);
+    TempData->Pixels.SetNumUninitialized(ExpectedCount);
+    FOmniCapturePixelKernels::LinearToSRGB8(PixelData.Pixels.GetData(), ExpectedCount, TempData->Pixels.GetData());
+    return WriteJPEG(*TempData, FilePath);
+}
+
+bool FOmniCaptureImageWriter::WriteJPEGFromLinearFloat32(const TImagePixelData<FLinearColor>& PixelData, const FString& FilePath) const
+{
+    const FIntPoint Size = PixelData.GetSize();
+    const int32 ExpectedCount = Size.X * Size.Y;
+    if (PixelData.Pixels.Num() != ExpectedCount)
+    {
+        return false;
+    }
+
+    if (IsStopRequested())
     {
-        const FFloat16Color& Pixel = PixelData.Pixels[Index];
-        const FLinearColor Linear(
-            Pixel.R.GetFloat(),
-            Pixel.G.GetFloat(),
-            Pixel.B.GetFloat(),
-            Pixel.A.GetFloat());
-        Converted[Index] = Linear.ToFColor(true);
+        return false;
     }
 
     TUniquePtr<TImagePixelData<FColor>> TempData = MakeUnique<TImagePixelData<FColor>>(Size);
-    TempData->Pixels = MoveTemp(Converted);
+    TempData->Pixels.SetNumUninitialized(ExpectedCount);
+    FOmniCapturePixelKernels::LinearToSRGB8(PixelData.Pixels.GetData(), ExpectedCount, TempData->Pixels.GetData());
+
     return WriteJPEG(*TempData, FilePath);
 }
 
-bool FOmniCaptureImageWriter::WriteJPEGFromLinearFloat32(const TImagePixelData<FLinearColor>& PixelData, const FString& FilePath) const
+bool FOmniCaptureImageWriter::WriteQOI(const TImagePixelData<FColor>& PixelData, const FString& FilePath) const
+{
+    if (IsStopRequested())
+    {
+        return false;
+    }
+
+    const FIntPoint Size = PixelData.GetSize();
+    const TArray64<FColor>& Pixels = PixelData.Pixels;
+    if (Pixels.Num() != static_cast<int64>(Size.X) * Size.Y)
+    {
+        return false;
+    }
+
+    FOmniCaptureQOIEncodeOptions Options;
+    Options.bChunked = bParallelQOIEncoding;
+    Options.ThreadCount = ParallelQOIThreadCount;
+
+    TArray64<uint8> EncodedData;
+    if (!FOmniCaptureQOIEncoder::Encode(Size, Pixels.GetData(), Options, EncodedData))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("QOI encoding failed for %s (%dx%d)"), *FilePath, Size.X, Size.Y);
+        return false;
+    }
+
+    return SaveEncodedFile(MoveTemp(EncodedData), FilePath);
+}
+
+bool FOmniCaptureImageWriter::WriteQOIFromLinear(const TImagePixelData<FFloat16Color>& PixelData, const FString& FilePath) const
 {
     const FIntPoint Size = PixelData.GetSize();
     const int32 ExpectedCount = Size.X * Size.Y;
@@ -1069,14 +1501,31 @@ bool FOmniCaptureImageWriter::WriteJPEGFromLinearFloat32(const TImagePixelData<F
     }
 
     TUniquePtr<TImagePixelData<FColor>> TempData = MakeUnique<TImagePixelData<FColor>>(Size);
-    TempData->Pixels.SetNum(ExpectedCount);
+    TempData->Pixels.SetNumUninitialized(ExpectedCount);
+    FOmniCapturePixelKernels::LinearToSRGB8(PixelData.Pixels.GetData(), ExpectedCount, TempData->Pixels.GetData());
 
-    for (int32 Index = 0; Index < ExpectedCount; ++Index)
+    return WriteQOI(*TempData, FilePath);
+}
+
+bool FOmniCaptureImageWriter::WriteQOIFromLinearFloat32(const TImagePixelData<FLinearColor>& PixelData, const FString& FilePath) const
+{
+    const FIntPoint Size = PixelData.GetSize();
+    const int32 ExpectedCount = Size.X * Size.Y;
+    if (PixelData.Pixels.Num() != ExpectedCount)
     {
-        TempData->Pixels[Index] = PixelData.Pixels[Index].ToFColor(true);
+        return false;
     }
 
-    return WriteJPEG(*TempData, FilePath);
+    if (IsStopRequested())
+    {
+        return false;
+    }
+
+    TUniquePtr<TImagePixelData<FColor>> TempData = MakeUnique<TImagePixelData<FColor>>(Size);
+    TempData->Pixels.SetNumUninitialized(ExpectedCount);
+    FOmniCapturePixelKernels::LinearToSRGB8(PixelData.Pixels.GetData(), ExpectedCount, TempData->Pixels.GetData());
+
+    return WriteQOI(*TempData, FilePath);
 }
 
 bool FOmniCaptureImageWriter::WriteEXRFrame(const FString& FilePath, bool bIsLinear, TUniquePtr<FImagePixelData> PixelData, EOmniCapturePixelPrecision PixelPrecision, EOmniCapturePixelDataType PixelDataType, TMap<FName, FOmniCaptureLayerPayload>&& AuxiliaryLayers, const FString& LayerDirectory, const FString& LayerBaseName, const FString& LayerExtension) const
@@ -1088,6 +1537,13 @@ bool FOmniCaptureImageWriter::WriteEXRFrame(const FString& FilePath, bool bIsLin
 
     TArray<FExrLayerRequest> Layers;
     Layers.Reserve(1 + AuxiliaryLayers.Num());
+    ON_SCOPE_EXIT
+    {
+        for (FExrLayerRequest& Layer : Layers)
+        {
+            FOmniCapturePixelBufferPool::Get().Release(MoveTemp(Layer.PixelData), Layer.PixelDataType);
+        }
+    };
 
     FExrLayerRequest& BeautyLayer = Layers.Emplace_GetRef();
     BeautyLayer.Name = TEXT("Beauty");
@@ -1279,12 +1735,19 @@ bool FOmniCaptureImageWriter::WriteCombinedEXR(const FString& FilePath, TArray<F
         }
     }
 
-    IFileManager::Get().Delete(*FilePath, false, true, false);
+    // Unbuffered writes need the whole EXR up front; OpenEXR seeks back to patch its offset table.
+    const bool bInMemory = PackedSequence.IsValid() || bUnbufferedWrites;
+    if (!bInMemory)
+    {
+        IFileManager::Get().Delete(*FilePath, false, true, false);
+    }
 
     bool bSucceeded = false;
+    TUniquePtr<OPENEXR_IMF_NAMESPACE::OStream> Stream;
 
     try
     {
+        Stream = CreateExrStream(FilePath, bInMemory);
         if (bUseEXRMultiPart)
         {
             TArray<OPENEXR_IMF_NAMESPACE::Header> Headers;
@@ -1321,7 +1784,7 @@ bool FOmniCaptureImageWriter::WriteCombinedEXR(const FString& FilePath, TArray<F
                 FrameBuffers.Add(Buffer);
             }
 
-            OPENEXR_IMF_NAMESPACE::MultiPartOutputFile OutputFile(TCHAR_TO_UTF8(*FilePath), Headers.GetData(), Headers.Num());
+            OPENEXR_IMF_NAMESPACE::MultiPartOutputFile OutputFile(*Stream, Headers.GetData(), Headers.Num());
             for (int32 PartIndex = 0; PartIndex < Headers.Num(); ++PartIndex)
             {
                 OPENEXR_IMF_NAMESPACE::OutputPart Part(OutputFile, PartIndex);
@@ -1356,7 +1819,7 @@ bool FOmniCaptureImageWriter::WriteCombinedEXR(const FString& FilePath, TArray<F
                 }
             }
 
-            OPENEXR_IMF_NAMESPACE::OutputFile OutputFile(TCHAR_TO_UTF8(*FilePath), Header);
+            OPENEXR_IMF_NAMESPACE::OutputFile OutputFile(*Stream, Header);
             OutputFile.setFrameBuffer(FrameBuffer);
             OutputFile.writePixels(ExpectedSize.Y);
         }
@@ -1374,6 +1837,11 @@ bool FOmniCaptureImageWriter::WriteCombinedEXR(const FString& FilePath, TArray<F
         {
             Layer.PixelData.Reset();
         }
+
+        if (bInMemory)
+        {
+            return SaveEncodedFile(MoveTemp(static_cast<FExrMemoryStream*>(Stream.Get())->Data), FilePath);
+        }
     }
 
     return bSucceeded;
@@ -1472,21 +1940,33 @@ bool FOmniCaptureImageWriter::WriteEXRInternal(TUniquePtr<FImagePixelData> Pixel
         return false;
     }
 
-#if OMNICAPTURE_UE_VERSION_AT_LEAST(5, 5, 0)
 #if WITH_OMNICAPTURE_OPENEXR
-    TArray<FExrLayerRequest> Layers;
-    FExrLayerRequest& Layer = Layers.Emplace_GetRef();
-    Layer.PixelData = MoveTemp(PixelData);
-    Layer.bLinear = true;
-    Layer.Precision = (PixelType == EImagePixelType::Float32)
-        ? EOmniCapturePixelPrecision::FullFloat
-        : EOmniCapturePixelPrecision::HalfFloat;
-
-    return WriteCombinedEXR(FilePath, Layers);
-#else
+    // Older engines can still use the image write queue, but it writes straight to disk,
+    // bypassing packed sequences and unbuffered writes.
+    if (OMNICAPTURE_UE_VERSION_AT_LEAST(5, 5, 0) || PackedSequence.IsValid() || bUnbufferedWrites)
+    {
+        TArray<FExrLayerRequest> Layers;
+        ON_SCOPE_EXIT
+        {
+            for (FExrLayerRequest& PooledLayer : Layers)
+            {
+                FOmniCapturePixelBufferPool::Get().Release(MoveTemp(PooledLayer.PixelData), PooledLayer.PixelDataType);
+            }
+        };
+        FExrLayerRequest& Layer = Layers.Emplace_GetRef();
+        Layer.PixelData = MoveTemp(PixelData);
+        Layer.bLinear = true;
+        Layer.Precision = (PixelType == EImagePixelType::Float32)
+            ? EOmniCapturePixelPrecision::FullFloat
+            : EOmniCapturePixelPrecision::HalfFloat;
+
+        return WriteCombinedEXR(FilePath, Layers);
+    }
+#endif // WITH_OMNICAPTURE_OPENEXR
+
+#if OMNICAPTURE_UE_VERSION_AT_LEAST(5, 5, 0)
     UE_LOG(LogTemp, Warning, TEXT("EXR writing is unavailable: OpenEXR support is required when building against UE 5.5 or newer."));
     return false;
-#endif // WITH_OMNICAPTURE_OPENEXR
 #else
     IImageWriteQueueModule& ImageWriteModule = FModuleManager::LoadModuleChecked<IImageWriteQueueModule>(TEXT("ImageWriteQueue"));
     IImageWriteQueue& WriteQueue = ImageWriteModule.GetWriteQueue();
@@ -1511,118 +1991,253 @@ bool FOmniCaptureImageWriter::WriteEXRInternal(TUniquePtr<FImagePixelData> Pixel
 #endif // OMNICAPTURE_UE_VERSION_AT_LEAST(5, 5, 0)
 }
 
-void FOmniCaptureImageWriter::RequestStop()
+#if WITH_OMNICAPTURE_OPENEXR
+bool FOmniCaptureImageWriter::WriteEXRFromRowSource(const IOmniCaptureRowSource& Source, const FString& FilePath, bool bIsLinear, EOmniCapturePixelDataType PixelDataType) const
 {
-    bStopRequested.Store(true);
-}
+    const FIntPoint Size = Source.GetSize();
+    if (Size.X <= 0 || Size.Y <= 0)
+    {
+        return false;
+    }
 
-bool FOmniCaptureImageWriter::IsStopRequested() const
-{
-    return bStopRequested.Load();
-}
+    if (IsStopRequested())
+    {
+        return false;
+    }
 
-void FOmniCaptureImageWriter::WaitForAvailableTaskSlot()
-{
-    if (MaxPendingTasks <= 0)
+    // Display-referred frames are stored as half like WriteEXRFromColor.
+    const bool bFullFloat = bIsLinear && PixelDataType == EOmniCapturePixelDataType::LinearColorFloat32;
+    const OPENEXR_IMF_NAMESPACE::PixelType ExrPixelType = bFullFloat ? OPENEXR_IMF_NAMESPACE::PixelType::FLOAT : OPENEXR_IMF_NAMESPACE::PixelType::HALF;
+    const int32 ComponentSize = bFullFloat ? sizeof(float) : sizeof(IMATH_NAMESPACE::half);
+    const size_t PixelStride = static_cast<size_t>(ComponentSize) * 4;
+    const size_t RowStride = PixelStride * Size.X;
+
+    const bool bInMemory = PackedSequence.IsValid() || bUnbufferedWrites;
+    if (!bInMemory)
     {
-        return;
+        IFileManager::Get().Delete(*FilePath, false, true, false);
     }
 
-    while (!IsStopRequested())
+    bool bSucceeded = false;
+    TUniquePtr<OPENEXR_IMF_NAMESPACE::OStream> Stream;
+
+    try
     {
-        TFuture<bool> TaskToWait;
+        Stream = CreateExrStream(FilePath, bInMemory);
+        OPENEXR_IMF_NAMESPACE::Header Header(Size.X, Size.Y);
+        Header.compression() = ToOpenExrCompression(TargetEXRCompression);
+        for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
+        {
+            FTCHARToUTF8 ChannelUtf8(GetChannelSuffix(ChannelIndex));
+            Header.channels().insert(ChannelUtf8.Get(), OPENEXR_IMF_NAMESPACE::Channel(ExrPixelType));
+        }
+
+        OPENEXR_IMF_NAMESPACE::OutputFile OutputFile(*Stream, Header);
+
+        TArray64<FLinearColor> Band;
+        TArray64<IMATH_NAMESPACE::half> HalfBand;
+        bool bStopped = false;
+
+        ForEachSourceBand(Source, 0, Size.Y, Band, [&](int32 BandStart, int32 BandRows)
         {
-            FScopeLock Lock(&PendingTasksCS);
-            if (PendingTasks.Num() < MaxPendingTasks)
+            if (bStopped || IsStopRequested())
             {
-                break;
+                bStopped = true;
+                return;
             }
 
-            TaskToWait = MoveTemp(PendingTasks[0]);
-            PendingTasks.RemoveAt(0, 1, EAllowShrinking::No);
-        }
+            const int64 PixelCount = static_cast<int64>(BandRows) * Size.X;
+            if (!bIsLinear)
+            {
+                for (int64 Index = 0; Index < PixelCount; ++Index)
+                {
+                    Band[Index] = Band[Index].ToFColor(true).ReinterpretAsLinear();
+                }
+            }
 
-        if (TaskToWait.IsValid())
-        {
-            const bool bResult = TaskToWait.Get();
-            if (!bResult)
+            const char* BandData = reinterpret_cast<const char*>(Band.GetData());
+            if (!bFullFloat)
+            {
+                const float* Components = reinterpret_cast<const float*>(Band.GetData());
+                HalfBand.SetNumUninitialized(PixelCount * 4, EAllowShrinking::No);
+                for (int64 Index = 0; Index < PixelCount * 4; ++Index)
+                {
+                    HalfBand[Index] = IMATH_NAMESPACE::half(Components[Index]);
+                }
+                BandData = reinterpret_cast<const char*>(HalfBand.GetData());
+            }
+
+            // Slices are addressed by absolute scanline, so rebase the band onto row 0.
+            char* BasePtr = const_cast<char*>(BandData) - static_cast<ptrdiff_t>(RowStride) * BandStart;
+
+            OPENEXR_IMF_NAMESPACE::FrameBuffer FrameBuffer;
+            for (int32 ChannelIndex = 0; ChannelIndex < 4; ++ChannelIndex)
             {
-                UE_LOG(LogTemp, Warning, TEXT("OmniCapture image write task failed"));
+                FTCHARToUTF8 ChannelUtf8(GetChannelSuffix(ChannelIndex));
+                const size_t ChannelOffset = static_cast<size_t>(ComponentSize) * ChannelIndex;
+                FrameBuffer.insert(ChannelUtf8.Get(), OPENEXR_IMF_NAMESPACE::Slice(ExrPixelType, BasePtr + ChannelOffset, PixelStride, RowStride));
             }
+
+            OutputFile.setFrameBuffer(FrameBuffer);
+            OutputFile.writePixels(BandRows);
+        });
+
+        bSucceeded = !bStopped;
+    }
+    catch (const std::exception& Exception)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to write streamed EXR '%s': %s"), *FilePath, UTF8_TO_TCHAR(Exception.what()));
+    }
+
+    if (!bSucceeded)
+    {
+        Stream.Reset();
+        if (!bInMemory)
+        {
+            IFileManager::Get().Delete(*FilePath, false, true, true);
         }
+        return false;
     }
-}
 
-void FOmniCaptureImageWriter::TrackPendingTask(TFuture<bool>&& TaskFuture)
+    if (bInMemory)
+    {
+        return SaveEncodedFile(MoveTemp(static_cast<FExrMemoryStream*>(Stream.Get())->Data), FilePath);
+    }
+
+    return true;
+}
+#else
+bool FOmniCaptureImageWriter::WriteEXRFromRowSource(const IOmniCaptureRowSource& Source, const FString& FilePath, bool bIsLinear, EOmniCapturePixelDataType PixelDataType) const
 {
-    FScopeLock Lock(&PendingTasksCS);
-    PendingTasks.Add(MoveTemp(TaskFuture));
+    UE_LOG(LogTemp, Verbose, TEXT("Skipping streamed EXR output for %s because OpenEXR support is unavailable."), *FilePath);
+    return false;
 }
+#endif // WITH_OMNICAPTURE_OPENEXR
 
-void FOmniCaptureImageWriter::PruneCompletedTasks()
+bool FOmniCaptureImageWriter::SaveEncodedFile(TArray64<uint8>&& EncodedData, const FString& FilePath) const
 {
-    FScopeLock Lock(&PendingTasksCS);
-    for (int32 Index = PendingTasks.Num() - 1; Index >= 0; --Index)
+    if (!FileWritePool.IsValid())
     {
-        if (PendingTasks[Index].IsReady())
+        return WriteEncodedFile(EncodedData, FilePath);
+    }
+
+    // Bound the encoded files held in memory when the disk falls behind.
+    FileWritePool->WaitForBacklogAtMost(MaxPendingTasks);
+    FileWritePool->Enqueue([this, EncodedData = MoveTemp(EncodedData), FilePath]()
+    {
+        if (!WriteEncodedFile(EncodedData, FilePath))
         {
-            const bool bResult = PendingTasks[Index].Get();
-            if (!bResult)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("OmniCapture image write task failed"));
-            }
-            PendingTasks.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+            ReportFailedWrite(FilePath);
         }
+    });
+    return true;
+}
+
+bool FOmniCaptureImageWriter::WriteEncodedFile(const TArray64<uint8>& EncodedData, const FString& FilePath) const
+{
+    if (PackedSequence.IsValid())
+    {
+        return PackedSequence->AddFile(FPaths::GetCleanFilename(FilePath), EncodedData);
+    }
+
+    IFileManager::Get().Delete(*FilePath, false, true, false);
+    if (bUnbufferedWrites)
+    {
+        return FOmniCaptureDirectFileWriter::WriteFile(FilePath, EncodedData);
     }
+    return FFileHelper::SaveArrayToFile(EncodedData, *FilePath);
 }
 
-void FOmniCaptureImageWriter::EnforcePendingTaskLimit()
+TUniquePtr<FArchive> FOmniCaptureImageWriter::CreateImageFileWriter(const FString& FilePath, int64 EstimatedSize) const
 {
-    if (MaxPendingTasks <= 0)
+    if (!bUnbufferedWrites)
     {
-        return;
+        return TUniquePtr<FArchive>(IFileManager::Get().CreateFileWriter(*FilePath));
     }
 
-    while (true)
+    TUniquePtr<FOmniCaptureDirectFileWriter> Writer = MakeUnique<FOmniCaptureDirectFileWriter>();
+    if (!Writer->Open(FilePath, EstimatedSize))
+    {
+        return nullptr;
+    }
+    return MoveTemp(Writer);
+}
+
+void FOmniCaptureImageWriter::RequestStop()
+{
+    bStopRequested.Store(true);
+    TaskSlotFreedEvent->Trigger();
+}
+
+bool FOmniCaptureImageWriter::IsStopRequested() const
+{
+    return bStopRequested.Load();
+}
+
+bool FOmniCaptureImageWriter::AcquireTaskSlot()
+{
+    for (;;)
     {
-        TFuture<bool> TaskToWait;
+        int32 Free = FreeTaskSlots.load();
+        while (Free > 0)
         {
-            FScopeLock Lock(&PendingTasksCS);
-            if (PendingTasks.Num() <= MaxPendingTasks)
+            if (FreeTaskSlots.compare_exchange_weak(Free, Free - 1))
             {
-                break;
+                // Releases that land before a waiter wakes coalesce into one signal, so hand any
+                // slot left over to the next waiter.
+                if (Free > 1)
+                {
+                    TaskSlotFreedEvent->Trigger();
+                }
+                return true;
             }
-
-            TaskToWait = MoveTemp(PendingTasks[0]);
-            PendingTasks.RemoveAt(0, 1, EAllowShrinking::No);
         }
 
-        if (TaskToWait.IsValid())
+        if (IsStopRequested())
         {
-            const bool bResult = TaskToWait.Get();
-            if (!bResult)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("OmniCapture image write task failed"));
-            }
+            TaskSlotFreedEvent->Trigger();
+            return false;
         }
+
+        // Every release and stop request triggers the event, and a signal that arrives before
+        // the wait is kept, so no wake-up is missed.
+        TaskSlotFreedEvent->Wait();
     }
 }
 
-void FOmniCaptureImageWriter::WaitForAllTasks()
+void FOmniCaptureImageWriter::ReleaseTaskSlot()
 {
-    TArray<TFuture<bool>> TasksToWait;
+    FreeTaskSlots.fetch_add(1);
+    TaskSlotFreedEvent->Trigger();
+}
+
+void FOmniCaptureImageWriter::ReportFailedWrite(const FString& FilePath) const
+{
+    FailedWrites.Enqueue(FilePath);
+}
+
+void FOmniCaptureImageWriter::DrainFailedWrites()
+{
+    FScopeLock Lock(&FailedWritesCS);
+    FString FilePath;
+    while (FailedWrites.Dequeue(FilePath))
     {
-        FScopeLock Lock(&PendingTasksCS);
-        TasksToWait = MoveTemp(PendingTasks);
-        PendingTasks.Reset();
+        FailedWriteCount.IncrementExchange();
+        UE_LOG(LogTemp, Warning, TEXT("OmniCapture image write task failed (%s)"), *FilePath);
     }
+}
 
-    for (TFuture<bool>& Task : TasksToWait)
+void FOmniCaptureImageWriter::WaitForAllTasks()
+{
+    // Encode tasks feed the file-write stage, so drain them first.
+    if (EncodePool.IsValid())
     {
-        const bool bResult = Task.Get();
-        if (!bResult)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("OmniCapture image write task failed"));
-        }
+        EncodePool->WaitUntilIdle();
     }
+    if (FileWritePool.IsValid())
+    {
+        FileWritePool->WaitUntilIdle();
+    }
+
+    DrainFailedWrites();
 }
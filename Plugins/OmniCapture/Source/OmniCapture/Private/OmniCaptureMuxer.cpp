@@ -1,4 +1,5 @@
 #include "OmniCaptureMuxer.h"
+#include "OmniCapturePackedSequence.h"
 #include "OmniCaptureTypes.h"
 #include "Misc/EngineVersionComparison.h"
 
@@ -79,6 +80,92 @@ namespace
 #endif
     }
 
+    // FFmpeg decoder for frames fed through image2pipe.
+    const TCHAR* GetImagePipeDecoder(EOmniCaptureImageFormat Format)
+    {
+        switch (Format)
+        {
+        case EOmniCaptureImageFormat::JPG:
+            return TEXT("mjpeg");
+        case EOmniCaptureImageFormat::EXR:
+            return TEXT("exr");
+        case EOmniCaptureImageFormat::BMP:
+            return TEXT("bmp");
+        case EOmniCaptureImageFormat::QOI:
+            return TEXT("qoi");
+        case EOmniCaptureImageFormat::PNG:
+        default:
+            return TEXT("png");
+        }
+    }
+
+    bool WriteToPipe(void* WritePipe, const uint8* Data, int64 Size, const FProcHandle& ProcHandle)
+    {
+        constexpr int64 SliceBytes = 1024 * 1024;
+        while (Size > 0)
+        {
+            int32 Written = 0;
+            if (!FPlatformProcess::WritePipe(WritePipe, Data, static_cast<int32>(FMath::Min(Size, SliceBytes)), &Written))
+            {
+                return false;
+            }
+            if (Written <= 0)
+            {
+                // The pipe is full; give FFmpeg time to drain it unless it has exited.
+                if (!FPlatformProcess::IsProcRunning(const_cast<FProcHandle&>(ProcHandle)))
+                {
+                    return false;
+                }
+                FPlatformProcess::Sleep(0.001f);
+                continue;
+            }
+            Data += Written;
+            Size -= Written;
+        }
+        return true;
+    }
+
+    // Feeds the frames of a packed sequence to FFmpeg's stdin in frame order.
+    bool StreamPackedFrames(const FString& Directory, const FString& BaseName, const FString& Extension, const TArray<FOmniCaptureFrameMetadata>& Frames, void* WritePipe, const FProcHandle& ProcHandle)
+    {
+        TArray<TUniquePtr<FOmniCapturePackedSequenceReader>> Readers;
+        TMap<FString, TPair<int32, int32>> Locations;
+        for (const FString& PackPath : FOmniCapturePackedSequenceWriter::FindPacks(Directory, BaseName))
+        {
+            TUniquePtr<FOmniCapturePackedSequenceReader> Reader = MakeUnique<FOmniCapturePackedSequenceReader>();
+            if (!Reader->Open(PackPath))
+            {
+                continue;
+            }
+            const TArray<FOmniCapturePackedEntry>& Entries = Reader->GetEntries();
+            for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+            {
+                Locations.Add(Entries[EntryIndex].FileName, TPair<int32, int32>(Readers.Num(), EntryIndex));
+            }
+            Readers.Add(MoveTemp(Reader));
+        }
+
+        int32 FramesWritten = 0;
+        TArray64<uint8> FrameData;
+        for (const FOmniCaptureFrameMetadata& Frame : Frames)
+        {
+            const FString FileName = FString::Printf(TEXT("%s_%06d%s"), *BaseName, Frame.FrameIndex, *Extension);
+            const TPair<int32, int32>* Location = Locations.Find(FileName);
+            if (!Location || !Readers[Location->Key]->ReadEntry(Location->Value, FrameData))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Frame %s is missing from the packed sequence; skipping it."), *FileName);
+                continue;
+            }
+            if (!WriteToPipe(WritePipe, FrameData.GetData(), FrameData.Num(), ProcHandle))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("FFmpeg stopped reading packed frames after %d of %d."), FramesWritten, Frames.Num());
+                return false;
+            }
+            ++FramesWritten;
+        }
+        return FramesWritten > 0;
+    }
+
     const TCHAR* ToCoverageString(EOmniCaptureCoverage Coverage)
     {
         return Coverage == EOmniCaptureCoverage::HalfSphere ? TEXT("VR180") : TEXT("VR360");
@@ -523,7 +610,21 @@ bool FOmniCaptureMuxer::TryInvokeFFmpeg(const FOmniCaptureSettings& Settings, co
     FString OutputFile = OutputDirectory / (BaseFileName + TEXT(".mp4"));
     FString CommandLine;
 
-    if (IsImageSequenceFormat(Settings.OutputFormat))
+    if (IsImageSequenceFormat(Settings.OutputFormat) && Settings.ImageFormat == EOmniCaptureImageFormat::OmniRaw)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Raw container capture; run the OmniCaptureRawConvert commandlet with -Format=Video to produce %s.mp4."), *BaseFileName);
+        return false;
+    }
+
+    // Packed sequences are read back here and piped to FFmpeg rather than unpacked to disk first.
+    // The writer falls back to individual files for formats it cannot pack, so look for the packs.
+    const bool bPackedInput = IsImageSequenceFormat(Settings.OutputFormat) && Settings.PackedSequenceFramesPerFile > 0
+        && FOmniCapturePackedSequenceWriter::FindPacks(OutputDirectory, BaseFileName).Num() > 0;
+    if (bPackedInput)
+    {
+        CommandLine = FString::Printf(TEXT("-y -f image2pipe -framerate %.3f -c:v %s -i -"), EffectiveFrameRate, GetImagePipeDecoder(Settings.ImageFormat));
+    }
+    else if (IsImageSequenceFormat(Settings.OutputFormat))
     {
         const FString Extension = Settings.GetImageFileExtension();
         FString Pattern = OutputDirectory / FString::Printf(TEXT("%s_%%06d%s"), *BaseFileName, *Extension);
@@ -619,13 +720,32 @@ bool FOmniCaptureMuxer::TryInvokeFFmpeg(const FOmniCaptureSettings& Settings, co
 
     UE_LOG(LogTemp, Log, TEXT("Invoking FFmpeg: %s %s"), *Binary, *CommandLine);
 
-    FProcHandle ProcHandle = FPlatformProcess::CreateProc(*Binary, *CommandLine, true, true, true, nullptr, 0, *OutputDirectory, nullptr);
+    void* StdInRead = nullptr;
+    void* StdInWrite = nullptr;
+    if (bPackedInput && !FPlatformProcess::CreatePipe(StdInRead, StdInWrite, true))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to create the FFmpeg input pipe."));
+        return false;
+    }
+
+    FProcHandle ProcHandle = FPlatformProcess::CreateProc(*Binary, *CommandLine, !bPackedInput, true, true, nullptr, 0, *OutputDirectory, nullptr, StdInRead);
     if (!ProcHandle.IsValid())
     {
         UE_LOG(LogTemp, Warning, TEXT("Failed to launch FFmpeg process."));
+        if (bPackedInput)
+        {
+            FPlatformProcess::ClosePipe(StdInRead, StdInWrite);
+        }
         return false;
     }
 
+    if (bPackedInput)
+    {
+        StreamPackedFrames(OutputDirectory, BaseFileName, Settings.GetImageFileExtension(), Frames, StdInWrite, ProcHandle);
+        // Closing our end is FFmpeg's end of input.
+        FPlatformProcess::ClosePipe(StdInRead, StdInWrite);
+    }
+
     FPlatformProcess::WaitForProc(ProcHandle);
     int32 ReturnCode = 0;
     FPlatformProcess::GetProcReturnCode(ProcHandle, &ReturnCode);
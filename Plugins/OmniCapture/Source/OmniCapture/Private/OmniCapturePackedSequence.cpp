@@ -0,0 +1,230 @@
+#include "OmniCapturePackedSequence.h"
+
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    constexpr uint8 PackTag[] = { 'O', 'P', 'A', 'K' };
+    constexpr uint8 PackIndexTag[] = { 'O', 'P', 'K', 'X' };
+    constexpr uint32 PackVersion = 1;
+    // Tag and version.
+    constexpr int64 PackHeaderBytes = 8;
+    // Index offset, entry count and the index tag.
+    constexpr int64 PackFooterBytes = 16;
+    // Smallest serialized entry: an empty name's length prefix, the offset and the size.
+    constexpr int64 PackMinEntryBytes = sizeof(int32) + 2 * sizeof(int64);
+
+    void SerializeEntries(FArchive& Ar, TArray<FOmniCapturePackedEntry>& Entries)
+    {
+        for (FOmniCapturePackedEntry& Entry : Entries)
+        {
+            if (Ar.IsError())
+            {
+                return;
+            }
+            Ar << Entry.FileName;
+            Ar << Entry.Offset;
+            Ar << Entry.Size;
+        }
+    }
+}
+
+FOmniCapturePackedSequenceWriter::FOmniCapturePackedSequenceWriter(const FString& InDirectory, const FString& InBaseName, int32 InFilesPerPack)
+    : Directory(InDirectory)
+    , BaseName(InBaseName)
+    , FilesPerPack(FMath::Max(1, InFilesPerPack))
+{
+}
+
+FOmniCapturePackedSequenceWriter::~FOmniCapturePackedSequenceWriter()
+{
+    Close();
+}
+
+FString FOmniCapturePackedSequenceWriter::GetPackFileName(const FString& BaseName, int32 PackIndex)
+{
+    return FString::Printf(TEXT("%s_pack%04d.omnipack"), *BaseName, PackIndex);
+}
+
+TArray<FString> FOmniCapturePackedSequenceWriter::FindPacks(const FString& Directory, const FString& BaseName)
+{
+    TArray<FString> FileNames;
+    IFileManager::Get().FindFiles(FileNames, *(Directory / (BaseName + TEXT("_pack*.omnipack"))), true, false);
+    // Pack numbers are zero-padded, so name order is pack order.
+    FileNames.Sort();
+
+    TArray<FString> Paths;
+    for (const FString& FileName : FileNames)
+    {
+        Paths.Add(Directory / FileName);
+    }
+    return Paths;
+}
+
+bool FOmniCapturePackedSequenceWriter::AddFile(const FString& FileName, const TArray64<uint8>& Data)
+{
+    FScopeLock Lock(&PackCS);
+
+    if (!PackFile.IsValid())
+    {
+        PackPath = Directory / GetPackFileName(BaseName, NextPackIndex++);
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        PlatformFile.DeleteFile(*PackPath);
+        PackFile.Reset(PlatformFile.OpenWrite(*PackPath, false, false));
+        Entries.Reset();
+        WriteOffset = 0;
+        bPackFailed = false;
+
+        uint8 Header[PackHeaderBytes];
+        FMemory::Memcpy(Header, PackTag, sizeof(PackTag));
+        FMemory::Memcpy(Header + sizeof(PackTag), &PackVersion, sizeof(PackVersion));
+        if (!PackFile.IsValid() || !PackFile->Write(Header, PackHeaderBytes))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to create image pack %s"), *PackPath);
+            PackFile.Reset();
+            return false;
+        }
+        WriteOffset = PackHeaderBytes;
+    }
+
+    if (!PackFile->Write(Data.GetData(), Data.Num()))
+    {
+        // Close the pack over the files it already holds; the next file starts a new one.
+        UE_LOG(LogTemp, Warning, TEXT("Failed to add %s to image pack %s"), *FileName, *PackPath);
+        bPackFailed = true;
+        FinishPack();
+        return false;
+    }
+
+    FOmniCapturePackedEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.FileName = FileName;
+    Entry.Offset = WriteOffset;
+    Entry.Size = Data.Num();
+    WriteOffset += Data.Num();
+
+    return Entries.Num() < FilesPerPack || FinishPack();
+}
+
+bool FOmniCapturePackedSequenceWriter::Close()
+{
+    FScopeLock Lock(&PackCS);
+    return !PackFile.IsValid() || FinishPack();
+}
+
+bool FOmniCapturePackedSequenceWriter::FinishPack()
+{
+    TArray<uint8> Index;
+    FMemoryWriter IndexWriter(Index);
+    SerializeEntries(IndexWriter, Entries);
+
+    int64 IndexOffset = WriteOffset;
+    int32 EntryCount = Entries.Num();
+    FMemoryWriter FooterWriter(Index);
+    FooterWriter.Seek(Index.Num());
+    FooterWriter << IndexOffset;
+    FooterWriter << EntryCount;
+    FooterWriter.Serialize(const_cast<uint8*>(PackIndexTag), sizeof(PackIndexTag));
+
+    // After a failed write the index replaces whatever part of the file made it to disk.
+    const bool bResult = (!bPackFailed || PackFile->Seek(WriteOffset))
+        && PackFile->Write(Index.GetData(), Index.Num())
+        && (!bPackFailed || PackFile->Truncate(WriteOffset + Index.Num()))
+        && PackFile->Flush();
+    if (!bResult)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to finish image pack %s"), *PackPath);
+    }
+
+    PackFile.Reset();
+    bPackFailed = false;
+    Entries.Reset();
+    return bResult;
+}
+
+bool FOmniCapturePackedSequenceReader::Open(const FString& InPackPath)
+{
+    PackPath = InPackPath;
+    Entries.Reset();
+    PackFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*InPackPath));
+    if (!PackFile.IsValid())
+    {
+        return false;
+    }
+
+    const int64 FileSize = PackFile->Size();
+    uint8 Header[PackHeaderBytes];
+    uint8 Footer[PackFooterBytes];
+    if (FileSize < PackHeaderBytes + PackFooterBytes
+        || !PackFile->Read(Header, PackHeaderBytes)
+        || FMemory::Memcmp(Header, PackTag, sizeof(PackTag)) != 0
+        || !PackFile->Seek(FileSize - PackFooterBytes)
+        || !PackFile->Read(Footer, PackFooterBytes)
+        || FMemory::Memcmp(Footer + PackFooterBytes - sizeof(PackIndexTag), PackIndexTag, sizeof(PackIndexTag)) != 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s is not a finished image pack"), *InPackPath);
+        PackFile.Reset();
+        return false;
+    }
+
+    int64 IndexOffset = 0;
+    int32 EntryCount = 0;
+    FMemory::Memcpy(&IndexOffset, Footer, sizeof(IndexOffset));
+    FMemory::Memcpy(&EntryCount, Footer + sizeof(IndexOffset), sizeof(EntryCount));
+    const int64 IndexSize = FileSize - PackFooterBytes - IndexOffset;
+    // The footer is untrusted: the index must lie between the header and the footer, and be
+    // large enough for the entries it claims before any of them are allocated.
+    if (EntryCount < 0 || IndexOffset < PackHeaderBytes || IndexSize < 0 || IndexSize > MAX_int32
+        || IndexOffset + IndexSize > FileSize - PackFooterBytes
+        || static_cast<int64>(EntryCount) * PackMinEntryBytes > IndexSize)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Image pack %s has a damaged footer"), *InPackPath);
+        PackFile.Reset();
+        return false;
+    }
+
+    TArray<uint8> Index;
+    Index.SetNumUninitialized(static_cast<int32>(IndexSize));
+    if (!PackFile->Seek(IndexOffset) || !PackFile->Read(Index.GetData(), Index.Num()))
+    {
+        PackFile.Reset();
+        return false;
+    }
+
+    Entries.SetNum(EntryCount);
+    FMemoryReader IndexReader(Index);
+    SerializeEntries(IndexReader, Entries);
+
+    bool bValid = !IndexReader.IsError();
+    for (const FOmniCapturePackedEntry& Entry : Entries)
+    {
+        bValid &= Entry.Offset >= PackHeaderBytes && Entry.Offset <= IndexOffset && Entry.Size >= 0 && Entry.Size <= IndexOffset - Entry.Offset;
+    }
+
+    if (!bValid)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Image pack %s has a damaged index"), *InPackPath);
+        Entries.Reset();
+        PackFile.Reset();
+    }
+    return bValid;
+}
+
+bool FOmniCapturePackedSequenceReader::ReadEntry(int32 Index, TArray64<uint8>& OutData) const
+{
+    if (!Entries.IsValidIndex(Index) || !PackFile.IsValid())
+    {
+        return false;
+    }
+
+    const FOmniCapturePackedEntry& Entry = Entries[Index];
+    OutData.SetNumUninitialized(Entry.Size);
+
+    FScopeLock Lock(&ReadCS);
+    return PackFile->Seek(Entry.Offset) && PackFile->Read(OutData.GetData(), Entry.Size);
+}
@@ -0,0 +1,419 @@
+#include "OmniCaptureParallelPNGEncoder.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/ScopeExit.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace
+{
+    // Deflate can reach back this far, so it is how much of the previous strip primes the next one.
+    constexpr int64 DeflateWindowBytes = 32 * 1024;
+    // Strips gathered per task before they are filtered and compressed together.
+    constexpr int32 StripsPerTaskPerBatch = 4;
+
+    constexpr uint8 PngSignature[] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+
+    enum EPngFilter : uint8
+    {
+        PngFilterNone = 0,
+        PngFilterSub = 1,
+        PngFilterUp = 2,
+        PngFilterAverage = 3,
+        PngFilterPaeth = 4
+    };
+
+    struct FPngStrip
+    {
+        int32 RowCount = 0;
+        // Source rows, converted in place to PNG sample order before filtering.
+        TArray64<uint8> Raw;
+        // Source row directly above the strip; empty for the first strip.
+        TArray64<uint8> PriorRow;
+        // RowCount * (BytesPerRow + 1): a filter type byte in front of every row.
+        TArray64<uint8> Filtered;
+        TArray64<uint8> Compressed;
+        uint32 Adler = 1;
+        bool bCompressed = false;
+    };
+
+    int32 GetPngColorType(int32 Channels)
+    {
+        switch (Channels)
+        {
+        case 1: return 0; // Greyscale
+        case 2: return 4; // Greyscale + alpha
+        case 3: return 2; // Truecolour
+        case 4: return 6; // Truecolour + alpha
+        default: return -1;
+        }
+    }
+
+    void AppendBigEndian32(TArray64<uint8>& Out, uint32 Value)
+    {
+        const uint8 Bytes[4] = { static_cast<uint8>(Value >> 24), static_cast<uint8>(Value >> 16), static_cast<uint8>(Value >> 8), static_cast<uint8>(Value) };
+        Out.Append(Bytes, 4);
+    }
+
+    int64 BeginChunk(TArray64<uint8>& Out, const char* Type)
+    {
+        const int64 ChunkStart = Out.Num();
+        AppendBigEndian32(Out, 0);
+        Out.Append(reinterpret_cast<const uint8*>(Type), 4);
+        return ChunkStart;
+    }
+
+    // Patches the length and appends the CRC over the type and data.
+    void EndChunk(TArray64<uint8>& Out, int64 ChunkStart)
+    {
+        const int64 DataLength = Out.Num() - ChunkStart - 8;
+        check(DataLength >= 0 && DataLength <= MAX_int32);
+
+        uint8* LengthField = Out.GetData() + ChunkStart;
+        LengthField[0] = static_cast<uint8>(DataLength >> 24);
+        LengthField[1] = static_cast<uint8>(DataLength >> 16);
+        LengthField[2] = static_cast<uint8>(DataLength >> 8);
+        LengthField[3] = static_cast<uint8>(DataLength);
+
+        const uLong Crc = crc32(crc32(0L, Z_NULL, 0), Out.GetData() + ChunkStart + 4, static_cast<uInt>(DataLength + 4));
+        AppendBigEndian32(Out, static_cast<uint32>(Crc));
+    }
+
+    // zlib stream header (RFC 1950) for a 32 KB window, with the level hint deflate itself would write.
+    void AppendZlibHeader(TArray64<uint8>& Out, int32 Level)
+    {
+        const uint8 Cmf = 0x78;
+        const uint8 LevelHint = Level < 2 ? 0 : (Level < 6 ? 1 : (Level == 6 ? 2 : 3));
+        uint8 Flg = static_cast<uint8>(LevelHint << 6);
+        Flg = static_cast<uint8>(Flg + (31 - (Cmf * 256 + Flg) % 31) % 31);
+        Out.Add(Cmf);
+        Out.Add(Flg);
+    }
+
+    // Reorders BGR to RGB and stores 16-bit samples big-endian, as libpng's bgr and swap transforms do.
+    void ConvertToPngSampleOrder(uint8* Data, int64 NumBytes, int32 Channels, int32 BytesPerSample, bool bBGROrder)
+    {
+        const int64 BytesPerPixel = static_cast<int64>(Channels) * BytesPerSample;
+        const bool bSwapRedBlue = bBGROrder && Channels >= 3;
+        const bool bSwapBytes = BytesPerSample == 2 && PLATFORM_LITTLE_ENDIAN;
+        if (!bSwapRedBlue && !bSwapBytes)
+        {
+            return;
+        }
+
+        for (uint8* Pixel = Data; Pixel + BytesPerPixel <= Data + NumBytes; Pixel += BytesPerPixel)
+        {
+            if (bSwapRedBlue)
+            {
+                for (int32 Byte = 0; Byte < BytesPerSample; ++Byte)
+                {
+                    Swap(Pixel[Byte], Pixel[2 * BytesPerSample + Byte]);
+                }
+            }
+
+            if (bSwapBytes)
+            {
+                for (int32 Sample = 0; Sample < Channels; ++Sample)
+                {
+                    Swap(Pixel[Sample * 2], Pixel[Sample * 2 + 1]);
+                }
+            }
+        }
+    }
+
+    FORCEINLINE uint8 PaethPredictor(int32 Left, int32 Up, int32 UpLeft)
+    {
+        const int32 Estimate = Left + Up - UpLeft;
+        const int32 DistanceLeft = FMath::Abs(Estimate - Left);
+        const int32 DistanceUp = FMath::Abs(Estimate - Up);
+        const int32 DistanceUpLeft = FMath::Abs(Estimate - UpLeft);
+        if (DistanceLeft <= DistanceUp && DistanceLeft <= DistanceUpLeft)
+        {
+            return static_cast<uint8>(Left);
+        }
+        return static_cast<uint8>(DistanceUp <= DistanceUpLeft ? Up : UpLeft);
+    }
+
+    template <uint8 FilterType>
+    FORCEINLINE uint8 FilterByte(const uint8* Row, const uint8* Prior, int64 Index, int32 Bpp)
+    {
+        const int32 Left = Index >= Bpp ? Row[Index - Bpp] : 0;
+        const int32 Up = Prior[Index];
+        const int32 UpLeft = Index >= Bpp ? Prior[Index - Bpp] : 0;
+
+        switch (FilterType)
+        {
+        case PngFilterSub: return static_cast<uint8>(Row[Index] - Left);
+        case PngFilterUp: return static_cast<uint8>(Row[Index] - Up);
+        case PngFilterAverage: return static_cast<uint8>(Row[Index] - ((Left + Up) >> 1));
+        case PngFilterPaeth: return static_cast<uint8>(Row[Index] - PaethPredictor(Left, Up, UpLeft));
+        default: return Row[Index];
+        }
+    }
+
+    // libpng's adaptive heuristic: the sum of residuals read as signed bytes.
+    template <uint8 FilterType>
+    uint64 MeasureFilter(const uint8* Row, const uint8* Prior, int64 RowBytes, int32 Bpp)
+    {
+        uint64 Cost = 0;
+        for (int64 Index = 0; Index < RowBytes; ++Index)
+        {
+            const uint8 Residual = FilterByte<FilterType>(Row, Prior, Index, Bpp);
+            Cost += Residual < 128 ? Residual : 256 - Residual;
+        }
+        return Cost;
+    }
+
+    template <uint8 FilterType>
+    void ApplyFilter(const uint8* Row, const uint8* Prior, int64 RowBytes, int32 Bpp, uint8* Out)
+    {
+        Out[0] = FilterType;
+        for (int64 Index = 0; Index < RowBytes; ++Index)
+        {
+            Out[Index + 1] = FilterByte<FilterType>(Row, Prior, Index, Bpp);
+        }
+    }
+
+    uint8 ChooseFilter(const uint8* Row, const uint8* Prior, int64 RowBytes, int32 Bpp)
+    {
+        const uint64 Costs[] =
+        {
+            MeasureFilter<PngFilterNone>(Row, Prior, RowBytes, Bpp),
+            MeasureFilter<PngFilterSub>(Row, Prior, RowBytes, Bpp),
+            MeasureFilter<PngFilterUp>(Row, Prior, RowBytes, Bpp),
+            MeasureFilter<PngFilterAverage>(Row, Prior, RowBytes, Bpp),
+            MeasureFilter<PngFilterPaeth>(Row, Prior, RowBytes, Bpp)
+        };
+
+        uint8 Best = PngFilterNone;
+        for (uint8 FilterType = PngFilterSub; FilterType <= PngFilterPaeth; ++FilterType)
+        {
+            if (Costs[FilterType] < Costs[Best])
+            {
+                Best = FilterType;
+            }
+        }
+        return Best;
+    }
+
+    void FilterRow(const uint8* Row, const uint8* Prior, int64 RowBytes, int32 Bpp, int32 FixedFilter, uint8* Out)
+    {
+        const uint8 Best = FixedFilter >= PngFilterNone && FixedFilter <= PngFilterPaeth
+            ? static_cast<uint8>(FixedFilter)
+            : ChooseFilter(Row, Prior, RowBytes, Bpp);
+
+        switch (Best)
+        {
+        case PngFilterSub: ApplyFilter<PngFilterSub>(Row, Prior, RowBytes, Bpp, Out); break;
+        case PngFilterUp: ApplyFilter<PngFilterUp>(Row, Prior, RowBytes, Bpp, Out); break;
+        case PngFilterAverage: ApplyFilter<PngFilterAverage>(Row, Prior, RowBytes, Bpp, Out); break;
+        case PngFilterPaeth: ApplyFilter<PngFilterPaeth>(Row, Prior, RowBytes, Bpp, Out); break;
+        default: ApplyFilter<PngFilterNone>(Row, Prior, RowBytes, Bpp, Out); break;
+        }
+    }
+
+    void FilterStrip(FPngStrip& Strip, int64 BytesPerRow, const FOmniCapturePNGEncodeOptions& Options)
+    {
+        const int32 BytesPerSample = Options.BitDepth / 8;
+        const int32 Bpp = Options.Channels * BytesPerSample;
+
+        ConvertToPngSampleOrder(Strip.Raw.GetData(), Strip.Raw.Num(), Options.Channels, BytesPerSample, Options.bBGROrder);
+        if (Strip.PriorRow.Num() == BytesPerRow)
+        {
+            ConvertToPngSampleOrder(Strip.PriorRow.GetData(), BytesPerRow, Options.Channels, BytesPerSample, Options.bBGROrder);
+        }
+        else
+        {
+            // The first row of the image filters against zeros.
+            Strip.PriorRow.SetNumZeroed(BytesPerRow);
+        }
+
+        Strip.Filtered.SetNumUninitialized(Strip.RowCount * (BytesPerRow + 1));
+        for (int32 Row = 0; Row < Strip.RowCount; ++Row)
+        {
+            const uint8* RowData = Strip.Raw.GetData() + Row * BytesPerRow;
+            const uint8* Prior = Row == 0 ? Strip.PriorRow.GetData() : RowData - BytesPerRow;
+            FilterRow(RowData, Prior, BytesPerRow, Bpp, Options.FixedFilter, Strip.Filtered.GetData() + Row * (BytesPerRow + 1));
+        }
+
+        Strip.Adler = static_cast<uint32>(adler32(adler32(0L, Z_NULL, 0), Strip.Filtered.GetData(), static_cast<uInt>(Strip.Filtered.Num())));
+    }
+
+    // Raw deflate of one strip. Every strip but the last ends in a sync flush, which byte-aligns
+    // the output without marking a final block, so the next strip's blocks can follow directly.
+    bool DeflateStrip(FPngStrip& Strip, const uint8* Dictionary, int64 DictionaryBytes, int32 Level, bool bFinalStrip)
+    {
+        z_stream Stream;
+        FMemory::Memzero(Stream);
+        if (deflateInit2(&Stream, Level, Z_DEFLATED, -MAX_WBITS, 8, Z_FILTERED) != Z_OK)
+        {
+            return false;
+        }
+        ON_SCOPE_EXIT
+        {
+            deflateEnd(&Stream);
+        };
+
+        if (DictionaryBytes > 0 && deflateSetDictionary(&Stream, Dictionary, static_cast<uInt>(DictionaryBytes)) != Z_OK)
+        {
+            return false;
+        }
+
+        // Headroom for the flush marker on top of the worst-case block overhead.
+        Strip.Compressed.SetNumUninitialized(static_cast<int64>(deflateBound(&Stream, static_cast<uLong>(Strip.Filtered.Num()))) + 64);
+        Stream.next_in = Strip.Filtered.GetData();
+        Stream.avail_in = static_cast<uInt>(Strip.Filtered.Num());
+        Stream.next_out = Strip.Compressed.GetData();
+        Stream.avail_out = static_cast<uInt>(Strip.Compressed.Num());
+
+        const int32 Result = deflate(&Stream, bFinalStrip ? Z_FINISH : Z_SYNC_FLUSH);
+        const bool bComplete = bFinalStrip
+            ? Result == Z_STREAM_END
+            : (Result == Z_OK && Stream.avail_in == 0 && Stream.avail_out > 0);
+        if (!bComplete)
+        {
+            return false;
+        }
+
+        Strip.Compressed.SetNum(static_cast<int64>(Stream.total_out), EAllowShrinking::No);
+        return true;
+    }
+
+    // Strides the strips over a fixed number of tasks, as the CPU reprojection bands do.
+    void ParallelForStrips(int32 NumStrips, int32 NumTasks, TFunctionRef<void(int32 StripIndex)> Body)
+    {
+        const int32 Tasks = FMath::Clamp(NumTasks, 1, FMath::Max(1, NumStrips));
+        ParallelFor(Tasks, [&Body, Tasks, NumStrips](int32 TaskIndex)
+        {
+            for (int32 StripIndex = TaskIndex; StripIndex < NumStrips; StripIndex += Tasks)
+            {
+                Body(StripIndex);
+            }
+        }, Tasks <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+    }
+}
+
+bool FOmniCaptureParallelPNGEncoder::SupportsFormat(int32 Channels, int32 BitDepth)
+{
+    return GetPngColorType(Channels) >= 0 && (BitDepth == 8 || BitDepth == 16);
+}
+
+bool FOmniCaptureParallelPNGEncoder::Encode(const FIntPoint& Size, const FOmniCapturePNGEncodeOptions& Options, FPrepareRows PrepareRows, TFunctionRef<bool()> ShouldAbort, TArray64<uint8>& OutPNG)
+{
+    OutPNG.Reset();
+    if (Size.X <= 0 || Size.Y <= 0 || !SupportsFormat(Options.Channels, Options.BitDepth))
+    {
+        return false;
+    }
+
+    const int32 Level = FMath::Clamp(Options.CompressionLevel, 0, 9);
+    const int64 BytesPerRow = static_cast<int64>(Size.X) * Options.Channels * (Options.BitDepth / 8);
+    const int32 RowsPerStrip = static_cast<int32>(FMath::Clamp<int64>(Options.StripBytes / (BytesPerRow + 1), 1, Size.Y));
+    const int32 NumStrips = FMath::DivideAndRoundUp(Size.Y, RowsPerStrip);
+    const int32 ThreadCount = Options.ThreadCount > 0 ? Options.ThreadCount : FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+    const int32 StripsPerBatch = FMath::Min(NumStrips, ThreadCount * StripsPerTaskPerBatch);
+
+    OutPNG.Reserve(BytesPerRow * Size.Y / 2 + 1024);
+    OutPNG.Append(PngSignature, UE_ARRAY_COUNT(PngSignature));
+
+    const int64 HeaderChunk = BeginChunk(OutPNG, "IHDR");
+    AppendBigEndian32(OutPNG, static_cast<uint32>(Size.X));
+    AppendBigEndian32(OutPNG, static_cast<uint32>(Size.Y));
+    OutPNG.Add(static_cast<uint8>(Options.BitDepth));
+    OutPNG.Add(static_cast<uint8>(GetPngColorType(Options.Channels)));
+    OutPNG.Add(0); // Deflate
+    OutPNG.Add(0); // Adaptive filtering
+    OutPNG.Add(0); // No interlace
+    EndChunk(OutPNG, HeaderChunk);
+
+    TArray<FPngStrip> Batch;
+    Batch.SetNum(StripsPerBatch);
+    TArray64<uint8> TempBuffer;
+    TArray<uint8*> RowPointers;
+    TArray64<uint8> LastSourceRow;
+    TArray64<uint8> Dictionary;
+    uint32 StreamAdler = 1;
+
+    for (int32 BatchStart = 0; BatchStart < NumStrips; BatchStart += StripsPerBatch)
+    {
+        if (ShouldAbort())
+        {
+            OutPNG.Reset();
+            return false;
+        }
+
+        const int32 StripsThisBatch = FMath::Min(StripsPerBatch, NumStrips - BatchStart);
+
+        // Rows are gathered here: the row callback is not required to be thread safe.
+        for (int32 Index = 0; Index < StripsThisBatch; ++Index)
+        {
+            FPngStrip& Strip = Batch[Index];
+            const int32 RowStart = (BatchStart + Index) * RowsPerStrip;
+            Strip.RowCount = FMath::Min(RowsPerStrip, Size.Y - RowStart);
+            Strip.PriorRow = LastSourceRow;
+            Strip.bCompressed = false;
+
+            RowPointers.SetNum(Strip.RowCount, EAllowShrinking::No);
+            PrepareRows(RowStart, Strip.RowCount, BytesPerRow, TempBuffer, RowPointers);
+
+            Strip.Raw.SetNumUninitialized(Strip.RowCount * BytesPerRow, EAllowShrinking::No);
+            for (int32 Row = 0; Row < Strip.RowCount; ++Row)
+            {
+                FMemory::Memcpy(Strip.Raw.GetData() + Row * BytesPerRow, RowPointers[Row], BytesPerRow);
+            }
+
+            LastSourceRow.SetNumUninitialized(BytesPerRow, EAllowShrinking::No);
+            FMemory::Memcpy(LastSourceRow.GetData(), Strip.Raw.GetData() + (Strip.RowCount - 1) * BytesPerRow, BytesPerRow);
+        }
+
+        ParallelForStrips(StripsThisBatch, ThreadCount, [&Batch, BytesPerRow, &Options](int32 Index)
+        {
+            FilterStrip(Batch[Index], BytesPerRow, Options);
+        });
+
+        // Needs every strip in the batch filtered: each one is primed with the tail of the one before.
+        ParallelForStrips(StripsThisBatch, ThreadCount, [&Batch, &Dictionary, BatchStart, NumStrips, Level](int32 Index)
+        {
+            const TArray64<uint8>& Preceding = Index > 0 ? Batch[Index - 1].Filtered : Dictionary;
+            const int64 DictionaryBytes = FMath::Min(DeflateWindowBytes, Preceding.Num());
+            const uint8* DictionaryData = Preceding.GetData() + Preceding.Num() - DictionaryBytes;
+            Batch[Index].bCompressed = DeflateStrip(Batch[Index], DictionaryData, DictionaryBytes, Level, BatchStart + Index == NumStrips - 1);
+        });
+
+        for (int32 Index = 0; Index < StripsThisBatch; ++Index)
+        {
+            FPngStrip& Strip = Batch[Index];
+            if (!Strip.bCompressed)
+            {
+                OutPNG.Reset();
+                return false;
+            }
+
+            StreamAdler = static_cast<uint32>(adler32_combine(StreamAdler, Strip.Adler, static_cast<z_off_t>(Strip.Filtered.Num())));
+
+            // One IDAT per strip; together they carry a single zlib stream.
+            const int64 DataChunk = BeginChunk(OutPNG, "IDAT");
+            if (BatchStart + Index == 0)
+            {
+                AppendZlibHeader(OutPNG, Level);
+            }
+            OutPNG.Append(Strip.Compressed.GetData(), Strip.Compressed.Num());
+            if (BatchStart + Index == NumStrips - 1)
+            {
+                AppendBigEndian32(OutPNG, StreamAdler);
+            }
+            EndChunk(OutPNG, DataChunk);
+        }
+
+        const TArray64<uint8>& LastFiltered = Batch[StripsThisBatch - 1].Filtered;
+        const int64 TailBytes = FMath::Min(DeflateWindowBytes, LastFiltered.Num());
+        Dictionary.Reset();
+        Dictionary.Append(LastFiltered.GetData() + LastFiltered.Num() - TailBytes, TailBytes);
+    }
+
+    EndChunk(OutPNG, BeginChunk(OutPNG, "IEND"));
+    return true;
+}
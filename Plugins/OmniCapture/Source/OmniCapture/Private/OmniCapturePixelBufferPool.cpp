@@ -0,0 +1,124 @@
+#include "OmniCapturePixelBufferPool.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    EOmniCapturePixelDataType InferPixelDataType(const FImagePixelData& PixelData)
+    {
+        switch (PixelData.GetType())
+        {
+        case EImagePixelType::Color:
+            return EOmniCapturePixelDataType::Color8;
+        case EImagePixelType::Float16:
+            return EOmniCapturePixelDataType::LinearColorFloat16;
+        case EImagePixelType::Float32:
+            return EOmniCapturePixelDataType::LinearColorFloat32;
+        default:
+            return EOmniCapturePixelDataType::Unknown;
+        }
+    }
+}
+
+FOmniCapturePixelBufferPool& FOmniCapturePixelBufferPool::Get()
+{
+    static FOmniCapturePixelBufferPool Pool;
+    return Pool;
+}
+
+void FOmniCapturePixelBufferPool::Configure(int32 InMaxBuffersPerKey, int64 InMaxPooledBytes)
+{
+    Trim();
+
+    FScopeLock Lock(&PoolCS);
+    MaxBuffersPerKey = FMath::Max(0, InMaxBuffersPerKey);
+    MaxPooledBytes = FMath::Max<int64>(0, InMaxPooledBytes);
+    Stats = FOmniCapturePixelPoolStats();
+}
+
+TUniquePtr<FImagePixelData> FOmniCapturePixelBufferPool::TakeFreeBuffer(const FIntPoint& Size, EOmniCapturePixelDataType PixelDataType)
+{
+    FScopeLock Lock(&PoolCS);
+
+    TArray<FPooledBuffer>* Bucket = FreeBuffers.Find(FPoolKey{ Size, PixelDataType });
+    if (!Bucket || Bucket->Num() == 0)
+    {
+        ++Stats.Misses;
+        return nullptr;
+    }
+
+    FPooledBuffer Buffer = Bucket->Pop(EAllowShrinking::No);
+    ++Stats.Hits;
+    --Stats.PooledBuffers;
+    Stats.PooledBytes -= Buffer.Bytes;
+    return MoveTemp(Buffer.PixelData);
+}
+
+void FOmniCapturePixelBufferPool::Release(TUniquePtr<FImagePixelData>&& PixelData, EOmniCapturePixelDataType PixelDataType)
+{
+    // Anything not kept is freed when this goes out of scope, outside the lock.
+    TUniquePtr<FImagePixelData> Returned = MoveTemp(PixelData);
+    if (!Returned.IsValid())
+    {
+        return;
+    }
+
+    if (PixelDataType == EOmniCapturePixelDataType::Unknown)
+    {
+        PixelDataType = InferPixelDataType(*Returned);
+    }
+
+    const void* RawData = nullptr;
+    int64 Bytes = 0;
+    Returned->GetRawData(RawData, Bytes);
+
+    FScopeLock Lock(&PoolCS);
+    if (PixelDataType == EOmniCapturePixelDataType::Unknown || Bytes <= 0)
+    {
+        return;
+    }
+
+    const FPoolKey Key{ Returned->GetSize(), PixelDataType };
+    TArray<FPooledBuffer>& Bucket = FreeBuffers.FindOrAdd(Key);
+    if (Bucket.Num() >= MaxBuffersPerKey || Stats.PooledBytes + Bytes > MaxPooledBytes)
+    {
+        ++Stats.Discarded;
+        return;
+    }
+
+    FPooledBuffer& Buffer = Bucket.AddDefaulted_GetRef();
+    Buffer.PixelData = MoveTemp(Returned);
+    Buffer.Bytes = Bytes;
+
+    ++Stats.Returned;
+    ++Stats.PooledBuffers;
+    Stats.PooledBytes += Bytes;
+    Stats.PeakPooledBytes = FMath::Max(Stats.PeakPooledBytes, Stats.PooledBytes);
+}
+
+void FOmniCapturePixelBufferPool::ReleaseFrame(FOmniCaptureFrame& Frame)
+{
+    Release(MoveTemp(Frame.PixelData), Frame.PixelDataType);
+    for (TPair<FName, FOmniCaptureLayerPayload>& Layer : Frame.AuxiliaryLayers)
+    {
+        Release(MoveTemp(Layer.Value.PixelData), Layer.Value.PixelDataType);
+    }
+}
+
+void FOmniCapturePixelBufferPool::Trim()
+{
+    TMap<FPoolKey, TArray<FPooledBuffer>> Freed;
+    {
+        FScopeLock Lock(&PoolCS);
+        Freed = MoveTemp(FreeBuffers);
+        FreeBuffers.Reset();
+        Stats.PooledBuffers = 0;
+        Stats.PooledBytes = 0;
+    }
+}
+
+FOmniCapturePixelPoolStats FOmniCapturePixelBufferPool::GetStats() const
+{
+    FScopeLock Lock(&PoolCS);
+    return Stats;
+}
@@ -0,0 +1,165 @@
+#include "OmniCapturePixelKernels.h"
+
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    constexpr int32 HalfCodeCount = 1 << 16;
+
+    // Conversion of every half bit pattern, built from the scalar references. NaNs map to 0.
+    struct FHalfTables
+    {
+        uint8 SRGB8[HalfCodeCount];
+        uint8 UNorm8[HalfCodeCount];
+        uint16 UNorm16[HalfCodeCount];
+
+        FHalfTables()
+        {
+            for (int32 Code = 0; Code < HalfCodeCount; ++Code)
+            {
+                FFloat16 Half;
+                Half.Encoded = static_cast<uint16>(Code);
+                const float Value = FMath::IsNaN(Half.GetFloat()) ? 0.0f : Half.GetFloat();
+
+                const FColor Converted = FOmniCapturePixelKernels::ToSRGB8Scalar(FLinearColor(Value, Value, Value, Value));
+                SRGB8[Code] = Converted.R;
+                UNorm8[Code] = Converted.A;
+                UNorm16[Code] = FOmniCapturePixelKernels::ToUNorm16Scalar(Value);
+            }
+        }
+    };
+
+    const FHalfTables& GetHalfTables()
+    {
+        static const FHalfTables Tables;
+        return Tables;
+    }
+
+    FORCEINLINE const uint16* GetHalfBits(const FFloat16Color& Pixel)
+    {
+        return reinterpret_cast<const uint16*>(&Pixel);
+    }
+
+    // Half bits are stored R, G, B, A.
+    FORCEINLINE FColor LookupSRGB8(const FHalfTables& Tables, const uint16* Bits)
+    {
+        FColor Result;
+        Result.R = Tables.SRGB8[Bits[0]];
+        Result.G = Tables.SRGB8[Bits[1]];
+        Result.B = Tables.SRGB8[Bits[2]];
+        Result.A = Tables.UNorm8[Bits[3]];
+        return Result;
+    }
+
+    FORCEINLINE void LookupUNorm16BGRA(const FHalfTables& Tables, const uint16* Bits, uint16* Dst)
+    {
+        Dst[0] = Tables.UNorm16[Bits[2]];
+        Dst[1] = Tables.UNorm16[Bits[1]];
+        Dst[2] = Tables.UNorm16[Bits[0]];
+        Dst[3] = Tables.UNorm16[Bits[3]];
+    }
+}
+
+static_assert(sizeof(FFloat16Color) == 4 * sizeof(uint16), "FFloat16Color must be four packed halves");
+static_assert(sizeof(FLinearColor) == 4 * sizeof(float), "FLinearColor must be four packed floats");
+
+FColor FOmniCapturePixelKernels::ToSRGB8(const FFloat16Color& Pixel)
+{
+    return LookupSRGB8(GetHalfTables(), GetHalfBits(Pixel));
+}
+
+FColor FOmniCapturePixelKernels::ToSRGB8(const FLinearColor& Pixel)
+{
+    uint16 Bits[4];
+    FPlatformMath::VectorStoreHalf(Bits, &Pixel.R);
+    return LookupSRGB8(GetHalfTables(), Bits);
+}
+
+void FOmniCapturePixelKernels::HalfToFloat(const FFloat16Color* Src, int64 Count, FLinearColor* Dst)
+{
+    // Two pixels per wide conversion, one for the tail.
+    int64 Index = 0;
+    for (; Index + 2 <= Count; Index += 2)
+    {
+        FPlatformMath::WideVectorLoadHalf(&Dst[Index].R, GetHalfBits(Src[Index]));
+    }
+    for (; Index < Count; ++Index)
+    {
+        FPlatformMath::VectorLoadHalf(&Dst[Index].R, GetHalfBits(Src[Index]));
+    }
+}
+
+void FOmniCapturePixelKernels::LinearToSRGB8(const FLinearColor* Src, int64 Count, FColor* Dst)
+{
+    const FHalfTables& Tables = GetHalfTables();
+
+    uint16 Bits[8];
+    int64 Index = 0;
+    for (; Index + 2 <= Count; Index += 2)
+    {
+        FPlatformMath::WideVectorStoreHalf(Bits, &Src[Index].R);
+        Dst[Index] = LookupSRGB8(Tables, Bits);
+        Dst[Index + 1] = LookupSRGB8(Tables, Bits + 4);
+    }
+    for (; Index < Count; ++Index)
+    {
+        FPlatformMath::VectorStoreHalf(Bits, &Src[Index].R);
+        Dst[Index] = LookupSRGB8(Tables, Bits);
+    }
+}
+
+void FOmniCapturePixelKernels::LinearToSRGB8(const FFloat16Color* Src, int64 Count, FColor* Dst)
+{
+    const FHalfTables& Tables = GetHalfTables();
+    for (int64 Index = 0; Index < Count; ++Index)
+    {
+        Dst[Index] = LookupSRGB8(Tables, GetHalfBits(Src[Index]));
+    }
+}
+
+void FOmniCapturePixelKernels::LinearToUNorm16BGRA(const FLinearColor* Src, int64 Count, uint16* Dst)
+{
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+    const VectorRegister4Float Scale = VectorSetFloat1(65535.0f);
+    const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+
+    // Values are clamped to [0, 1] first, so truncating x * 65535 + 0.5 rounds to nearest.
+    int32 Codes[4];
+    for (int64 Index = 0; Index < Count; ++Index)
+    {
+        VectorRegister4Float Pixel = VectorLoad(&Src[Index].R);
+        Pixel = VectorMin(VectorMax(Pixel, Zero), One);
+        Pixel = VectorMultiplyAdd(Pixel, Scale, Half);
+        Pixel = VectorSwizzle(Pixel, 2, 1, 0, 3);
+        VectorIntStore(VectorFloatToInt(Pixel), Codes);
+
+        uint16* Out = Dst + Index * 4;
+        Out[0] = static_cast<uint16>(Codes[0]);
+        Out[1] = static_cast<uint16>(Codes[1]);
+        Out[2] = static_cast<uint16>(Codes[2]);
+        Out[3] = static_cast<uint16>(Codes[3]);
+    }
+}
+
+void FOmniCapturePixelKernels::LinearToUNorm16BGRA(const FFloat16Color* Src, int64 Count, uint16* Dst)
+{
+    const FHalfTables& Tables = GetHalfTables();
+    for (int64 Index = 0; Index < Count; ++Index)
+    {
+        LookupUNorm16BGRA(Tables, GetHalfBits(Src[Index]), Dst + Index * 4);
+    }
+}
+
+void FOmniCapturePixelKernels::SRGB8ToUNorm16BGRA(const FColor* Src, int64 Count, uint16* Dst)
+{
+    for (int64 Index = 0; Index < Count; ++Index)
+    {
+        const FColor Pixel = Src[Index];
+        uint16* Out = Dst + Index * 4;
+        Out[0] = static_cast<uint16>(Pixel.B * 257u);
+        Out[1] = static_cast<uint16>(Pixel.G * 257u);
+        Out[2] = static_cast<uint16>(Pixel.R * 257u);
+        Out[3] = static_cast<uint16>(Pixel.A * 257u);
+    }
+}
@@ -143,7 +143,7 @@ void AOmniCapturePreviewActor::SetPreviewView(EOmniCapturePreviewView InView)
 
 void AOmniCapturePreviewActor::UpdatePreviewTexture(const FOmniCaptureEquirectResult& Result, const FOmniCaptureSettings& Settings)
 {
-    const FIntPoint Size = Result.Size;
+    const FIntPoint Size = Result.PreviewSize;
     if (Size.X <= 0 || Size.Y <= 0)
     {
         return;
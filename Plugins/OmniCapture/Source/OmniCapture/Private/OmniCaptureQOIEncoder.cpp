@@ -0,0 +1,442 @@
+#include "OmniCaptureQOIEncoder.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformMisc.h"
+
+#include <atomic>
+
+namespace
+{
+    constexpr uint8 QoiOpIndex = 0x00;
+    constexpr uint8 QoiOpDiff = 0x40;
+    constexpr uint8 QoiOpLuma = 0x80;
+    constexpr uint8 QoiOpRun = 0xc0;
+    constexpr uint8 QoiOpRGB = 0xfe;
+    constexpr uint8 QoiOpRGBA = 0xff;
+    constexpr uint8 QoiMask2 = 0xc0;
+    constexpr int32 QoiMaxRun = 62;
+    // A full RGBA op per pixel.
+    constexpr int64 QoiMaxBytesPerPixel = 5;
+    // The spec's limit, so the worst-case file size fits 32 bits.
+    constexpr int64 QoiMaxPixels = 400000000;
+
+    constexpr int64 QoiHeaderBytes = 14;
+    constexpr uint8 QoiMagic[] = { 'q', 'o', 'i', 'f' };
+    constexpr uint8 QoiEndMarker[] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+    constexpr uint8 ChunkIndexTag[] = { 'o', 'q', 'i', 'x' };
+    // Rows per chunk, chunk count and the tag.
+    constexpr int64 ChunkIndexFooterBytes = 12;
+
+    FORCEINLINE uint32 QoiHash(const FColor& Pixel)
+    {
+        return (Pixel.R * 3 + Pixel.G * 5 + Pixel.B * 7 + Pixel.A * 11) & 63;
+    }
+
+    void WriteBigEndian32(uint8* Out, uint32 Value)
+    {
+        Out[0] = static_cast<uint8>(Value >> 24);
+        Out[1] = static_cast<uint8>(Value >> 16);
+        Out[2] = static_cast<uint8>(Value >> 8);
+        Out[3] = static_cast<uint8>(Value);
+    }
+
+    uint32 ReadBigEndian32(const uint8* In)
+    {
+        return (static_cast<uint32>(In[0]) << 24) | (static_cast<uint32>(In[1]) << 16) | (static_cast<uint32>(In[2]) << 8) | static_cast<uint32>(In[3]);
+    }
+
+    /**
+     * Encodes PixelCount pixels as QOI ops into Out, which must hold QoiMaxBytesPerPixel bytes per pixel.
+     * Returns the number of bytes written. Runs never cross the end of the chunk.
+     */
+    int64 EncodeChunk(const FColor* Pixels, int64 PixelCount, bool bFirstChunk, uint8* Out)
+    {
+        FColor Index[64];
+        FMemory::Memzero(Index);
+        // Slots written by this chunk. A reader starting at the chunk shares only these with one that
+        // decoded the chunks before it; at the start of the file both hold zeros everywhere.
+        uint64 ValidSlots = bFirstChunk ? ~0ull : 0ull;
+        FColor Previous(0, 0, 0, 255);
+        uint8* Cursor = Out;
+        int32 Run = 0;
+        int64 PixelIndex = 0;
+
+        if (!bFirstChunk && PixelCount > 0)
+        {
+            // The two readers disagree on the previous pixel, so the first one is spelled out.
+            Previous = Pixels[0];
+            *Cursor++ = QoiOpRGBA;
+            *Cursor++ = Previous.R;
+            *Cursor++ = Previous.G;
+            *Cursor++ = Previous.B;
+            *Cursor++ = Previous.A;
+
+            const uint32 Slot = QoiHash(Previous);
+            Index[Slot] = Previous;
+            ValidSlots |= 1ull << Slot;
+            PixelIndex = 1;
+        }
+
+        for (; PixelIndex < PixelCount; ++PixelIndex)
+        {
+            const FColor Pixel = Pixels[PixelIndex];
+            if (Pixel == Previous)
+            {
+                if (++Run == QoiMaxRun)
+                {
+                    *Cursor++ = static_cast<uint8>(QoiOpRun | (Run - 1));
+                    Run = 0;
+                }
+                continue;
+            }
+
+            if (Run > 0)
+            {
+                *Cursor++ = static_cast<uint8>(QoiOpRun | (Run - 1));
+                Run = 0;
+            }
+
+            const uint32 Slot = QoiHash(Pixel);
+            if (((ValidSlots >> Slot) & 1) != 0 && Index[Slot] == Pixel)
+            {
+                *Cursor++ = static_cast<uint8>(QoiOpIndex | Slot);
+            }
+            else
+            {
+                Index[Slot] = Pixel;
+                ValidSlots |= 1ull << Slot;
+
+                if (Pixel.A == Previous.A)
+                {
+                    const int32 DR = static_cast<int8>(Pixel.R - Previous.R);
+                    const int32 DG = static_cast<int8>(Pixel.G - Previous.G);
+                    const int32 DB = static_cast<int8>(Pixel.B - Previous.B);
+                    const int32 DRG = DR - DG;
+                    const int32 DBG = DB - DG;
+
+                    if (DR >= -2 && DR <= 1 && DG >= -2 && DG <= 1 && DB >= -2 && DB <= 1)
+                    {
+                        *Cursor++ = static_cast<uint8>(QoiOpDiff | ((DR + 2) << 4) | ((DG + 2) << 2) | (DB + 2));
+                    }
+                    else if (DRG >= -8 && DRG <= 7 && DG >= -32 && DG <= 31 && DBG >= -8 && DBG <= 7)
+                    {
+                        *Cursor++ = static_cast<uint8>(QoiOpLuma | (DG + 32));
+                        *Cursor++ = static_cast<uint8>(((DRG + 8) << 4) | (DBG + 8));
+                    }
+                    else
+                    {
+                        *Cursor++ = QoiOpRGB;
+                        *Cursor++ = Pixel.R;
+                        *Cursor++ = Pixel.G;
+                        *Cursor++ = Pixel.B;
+                    }
+                }
+                else
+                {
+                    *Cursor++ = QoiOpRGBA;
+                    *Cursor++ = Pixel.R;
+                    *Cursor++ = Pixel.G;
+                    *Cursor++ = Pixel.B;
+                    *Cursor++ = Pixel.A;
+                }
+            }
+
+            Previous = Pixel;
+        }
+
+        if (Run > 0)
+        {
+            *Cursor++ = static_cast<uint8>(QoiOpRun | (Run - 1));
+        }
+
+        return Cursor - Out;
+    }
+
+    // Decodes PixelCount pixels from a fresh decoder state. False if the ops run past DataSize.
+    bool DecodeChunk(const uint8* Data, int64 DataSize, FColor* Out, int64 PixelCount)
+    {
+        FColor Index[64];
+        FMemory::Memzero(Index);
+        FColor Pixel(0, 0, 0, 255);
+        int64 Cursor = 0;
+        int32 Run = 0;
+
+        for (int64 PixelIndex = 0; PixelIndex < PixelCount; ++PixelIndex)
+        {
+            if (Run > 0)
+            {
+                --Run;
+            }
+            else
+            {
+                if (Cursor >= DataSize)
+                {
+                    return false;
+                }
+
+                const uint8 Op = Data[Cursor++];
+                if (Op == QoiOpRGB || Op == QoiOpRGBA)
+                {
+                    const int64 Needed = Op == QoiOpRGBA ? 4 : 3;
+                    if (Cursor + Needed > DataSize)
+                    {
+                        return false;
+                    }
+                    Pixel.R = Data[Cursor++];
+                    Pixel.G = Data[Cursor++];
+                    Pixel.B = Data[Cursor++];
+                    if (Op == QoiOpRGBA)
+                    {
+                        Pixel.A = Data[Cursor++];
+                    }
+                }
+                else
+                {
+                    switch (Op & QoiMask2)
+                    {
+                    case QoiOpIndex:
+                        Pixel = Index[Op];
+                        break;
+                    case QoiOpDiff:
+                        Pixel.R = static_cast<uint8>(Pixel.R + ((Op >> 4) & 3) - 2);
+                        Pixel.G = static_cast<uint8>(Pixel.G + ((Op >> 2) & 3) - 2);
+                        Pixel.B = static_cast<uint8>(Pixel.B + (Op & 3) - 2);
+                        break;
+                    case QoiOpLuma:
+                    {
+                        if (Cursor >= DataSize)
+                        {
+                            return false;
+                        }
+                        const uint8 Second = Data[Cursor++];
+                        const int32 DG = (Op & 0x3f) - 32;
+                        Pixel.R = static_cast<uint8>(Pixel.R + DG - 8 + ((Second >> 4) & 0x0f));
+                        Pixel.G = static_cast<uint8>(Pixel.G + DG);
+                        Pixel.B = static_cast<uint8>(Pixel.B + DG - 8 + (Second & 0x0f));
+                        break;
+                    }
+                    default:
+                        Run = Op & 0x3f;
+                        break;
+                    }
+                }
+
+                Index[QoiHash(Pixel)] = Pixel;
+            }
+
+            Out[PixelIndex] = Pixel;
+        }
+
+        return true;
+    }
+
+    bool ReadHeader(const uint8* Data, int64 DataSize, FIntPoint& OutSize)
+    {
+        if (!Data || DataSize < QoiHeaderBytes + static_cast<int64>(sizeof(QoiEndMarker)) || FMemory::Memcmp(Data, QoiMagic, sizeof(QoiMagic)) != 0)
+        {
+            return false;
+        }
+
+        const uint32 Width = ReadBigEndian32(Data + 4);
+        const uint32 Height = ReadBigEndian32(Data + 8);
+        const uint8 Channels = Data[12];
+        const uint8 ColorSpace = Data[13];
+        if (Width == 0 || Height == 0 || static_cast<int64>(Width) * Height > QoiMaxPixels || (Channels != 3 && Channels != 4) || ColorSpace > 1)
+        {
+            return false;
+        }
+
+        OutSize = FIntPoint(static_cast<int32>(Width), static_cast<int32>(Height));
+        return true;
+    }
+
+    void ParallelForChunks(int32 NumChunks, int32 NumTasks, TFunctionRef<void(int32 ChunkIndex)> Body)
+    {
+        const int32 Tasks = FMath::Clamp(NumTasks, 1, FMath::Max(1, NumChunks));
+        ParallelFor(Tasks, [&Body, Tasks, NumChunks](int32 TaskIndex)
+        {
+            for (int32 ChunkIndex = TaskIndex; ChunkIndex < NumChunks; ChunkIndex += Tasks)
+            {
+                Body(ChunkIndex);
+            }
+        }, Tasks <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+    }
+}
+
+bool FOmniCaptureQOIEncoder::Encode(const FIntPoint& Size, const FColor* Pixels, const FOmniCaptureQOIEncodeOptions& Options, TArray64<uint8>& OutQOI)
+{
+    OutQOI.Reset();
+    const int64 PixelCount = static_cast<int64>(Size.X) * Size.Y;
+    if (!Pixels || Size.X <= 0 || Size.Y <= 0 || PixelCount > QoiMaxPixels)
+    {
+        return false;
+    }
+
+    const int32 ChunkRows = Options.bChunked ? static_cast<int32>(FMath::Clamp<int64>(Options.ChunkPixels / Size.X, 1, Size.Y)) : Size.Y;
+    const int32 NumChunks = FMath::DivideAndRoundUp(Size.Y, ChunkRows);
+
+    OutQOI.SetNumUninitialized(QoiHeaderBytes);
+    uint8* Header = OutQOI.GetData();
+    FMemory::Memcpy(Header, QoiMagic, sizeof(QoiMagic));
+    WriteBigEndian32(Header + 4, static_cast<uint32>(Size.X));
+    WriteBigEndian32(Header + 8, static_cast<uint32>(Size.Y));
+    Header[12] = 4;
+    // sRGB colour with linear alpha: linear captures are converted to sRGB before they get here.
+    Header[13] = 0;
+
+    TArray<int64> ChunkOffsets;
+    if (NumChunks == 1)
+    {
+        // Encode straight into the file buffer and trim it afterwards.
+        OutQOI.SetNumUninitialized(QoiHeaderBytes + PixelCount * QoiMaxBytesPerPixel);
+        const int64 Written = EncodeChunk(Pixels, PixelCount, true, OutQOI.GetData() + QoiHeaderBytes);
+        OutQOI.SetNum(QoiHeaderBytes + Written, EAllowShrinking::No);
+        ChunkOffsets.Add(QoiHeaderBytes);
+    }
+    else
+    {
+        const int32 ThreadCount = Options.ThreadCount > 0 ? Options.ThreadCount : FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+
+        TArray<TArray64<uint8>> Chunks;
+        Chunks.SetNum(NumChunks);
+        ParallelForChunks(NumChunks, ThreadCount, [&Chunks, Pixels, &Size, ChunkRows](int32 ChunkIndex)
+        {
+            const int32 RowStart = ChunkIndex * ChunkRows;
+            const int64 ChunkPixelCount = static_cast<int64>(FMath::Min(ChunkRows, Size.Y - RowStart)) * Size.X;
+            TArray64<uint8>& Chunk = Chunks[ChunkIndex];
+            Chunk.SetNumUninitialized(ChunkPixelCount * QoiMaxBytesPerPixel);
+            const int64 Written = EncodeChunk(Pixels + static_cast<int64>(RowStart) * Size.X, ChunkPixelCount, ChunkIndex == 0, Chunk.GetData());
+            Chunk.SetNum(Written, EAllowShrinking::No);
+        });
+
+        int64 TotalBytes = QoiHeaderBytes + sizeof(QoiEndMarker) + ChunkIndexFooterBytes + static_cast<int64>(NumChunks) * sizeof(uint64);
+        for (const TArray64<uint8>& Chunk : Chunks)
+        {
+            TotalBytes += Chunk.Num();
+        }
+        OutQOI.Reserve(TotalBytes);
+
+        for (TArray64<uint8>& Chunk : Chunks)
+        {
+            ChunkOffsets.Add(OutQOI.Num());
+            OutQOI.Append(Chunk);
+            Chunk.Empty();
+        }
+    }
+
+    OutQOI.Append(QoiEndMarker, sizeof(QoiEndMarker));
+
+    if (Options.bChunked)
+    {
+        uint8 Field[8];
+        for (const int64 Offset : ChunkOffsets)
+        {
+            WriteBigEndian32(Field, static_cast<uint32>(static_cast<uint64>(Offset) >> 32));
+            WriteBigEndian32(Field + 4, static_cast<uint32>(Offset));
+            OutQOI.Append(Field, 8);
+        }
+
+        WriteBigEndian32(Field, static_cast<uint32>(ChunkRows));
+        WriteBigEndian32(Field + 4, static_cast<uint32>(NumChunks));
+        OutQOI.Append(Field, 8);
+        OutQOI.Append(ChunkIndexTag, sizeof(ChunkIndexTag));
+    }
+
+    return true;
+}
+
+bool FOmniCaptureQOIEncoder::ReadChunkIndex(const uint8* Data, int64 DataSize, int32& OutChunkRows, TArray<int64>& OutChunkOffsets)
+{
+    OutChunkOffsets.Reset();
+
+    FIntPoint Size;
+    // A plain file ends in the end marker, which never matches the tag.
+    if (!ReadHeader(Data, DataSize, Size) || DataSize < QoiHeaderBytes + static_cast<int64>(sizeof(QoiEndMarker)) + ChunkIndexFooterBytes
+        || FMemory::Memcmp(Data + DataSize - sizeof(ChunkIndexTag), ChunkIndexTag, sizeof(ChunkIndexTag)) != 0)
+    {
+        return false;
+    }
+
+    const uint8* Footer = Data + DataSize - ChunkIndexFooterBytes;
+    const uint32 ChunkRows = ReadBigEndian32(Footer);
+    const uint32 NumChunks = ReadBigEndian32(Footer + 4);
+    if (ChunkRows == 0 || ChunkRows > static_cast<uint32>(Size.Y) || NumChunks != static_cast<uint32>(FMath::DivideAndRoundUp(Size.Y, static_cast<int32>(ChunkRows))))
+    {
+        return false;
+    }
+
+    const int64 IndexStart = DataSize - ChunkIndexFooterBytes - static_cast<int64>(NumChunks) * sizeof(uint64);
+    const int64 StreamEnd = IndexStart - sizeof(QoiEndMarker);
+    if (StreamEnd < QoiHeaderBytes)
+    {
+        return false;
+    }
+
+    int64 PreviousOffset = 0;
+    for (uint32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+    {
+        const uint8* Field = Data + IndexStart + static_cast<int64>(ChunkIndex) * sizeof(uint64);
+        const int64 Offset = static_cast<int64>((static_cast<uint64>(ReadBigEndian32(Field)) << 32) | ReadBigEndian32(Field + 4));
+        const bool bValid = ChunkIndex == 0 ? Offset == QoiHeaderBytes : Offset > PreviousOffset;
+        if (!bValid || Offset >= StreamEnd)
+        {
+            OutChunkOffsets.Reset();
+            return false;
+        }
+
+        OutChunkOffsets.Add(Offset);
+        PreviousOffset = Offset;
+    }
+
+    OutChunkRows = static_cast<int32>(ChunkRows);
+    return true;
+}
+
+bool FOmniCaptureQOIEncoder::Decode(const uint8* Data, int64 DataSize, FIntPoint& OutSize, TArray64<FColor>& OutPixels)
+{
+    OutPixels.Reset();
+    if (!ReadHeader(Data, DataSize, OutSize))
+    {
+        return false;
+    }
+
+    OutPixels.SetNumUninitialized(static_cast<int64>(OutSize.X) * OutSize.Y);
+
+    int32 ChunkRows = 0;
+    TArray<int64> ChunkOffsets;
+    if (!ReadChunkIndex(Data, DataSize, ChunkRows, ChunkOffsets))
+    {
+        const int64 StreamBytes = DataSize - QoiHeaderBytes - sizeof(QoiEndMarker);
+        if (!DecodeChunk(Data + QoiHeaderBytes, StreamBytes, OutPixels.GetData(), OutPixels.Num()))
+        {
+            OutPixels.Reset();
+            return false;
+        }
+        return true;
+    }
+
+    const int32 NumChunks = ChunkOffsets.Num();
+    const int64 StreamEnd = DataSize - ChunkIndexFooterBytes - static_cast<int64>(NumChunks) * sizeof(uint64) - sizeof(QoiEndMarker);
+    const FIntPoint Size = OutSize;
+    std::atomic<bool> bFailed{ false };
+
+    ParallelForChunks(NumChunks, FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn()), [&](int32 ChunkIndex)
+    {
+        const int32 RowStart = ChunkIndex * ChunkRows;
+        const int64 ChunkPixelCount = static_cast<int64>(FMath::Min(ChunkRows, Size.Y - RowStart)) * Size.X;
+        const int64 ChunkStart = ChunkOffsets[ChunkIndex];
+        const int64 ChunkEnd = ChunkIndex + 1 < NumChunks ? ChunkOffsets[ChunkIndex + 1] : StreamEnd;
+        if (!DecodeChunk(Data + ChunkStart, ChunkEnd - ChunkStart, OutPixels.GetData() + static_cast<int64>(RowStart) * Size.X, ChunkPixelCount))
+        {
+            bFailed = true;
+        }
+    });
+
+    if (bFailed)
+    {
+        OutPixels.Reset();
+        return false;
+    }
+    return true;
+}
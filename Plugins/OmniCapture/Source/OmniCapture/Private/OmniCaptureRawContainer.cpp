@@ -0,0 +1,479 @@
+#include "OmniCaptureRawContainer.h"
+
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/ScopeLock.h"
+#include "OmniCapturePixelBufferPool.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    constexpr uint8 RawMagic[] = { 'O', 'M', 'N', 'I', 'R', 'A', 'W', 0 };
+    constexpr uint32 RawVersion = 1;
+    // Plane and header alignment. Matches the page and sector size of every drive we write to.
+    constexpr int64 RawAlignment = 4096;
+    // The file is extended at least this far ahead of the write position.
+    constexpr int64 RawReserveStep = 256ll * 1024ll * 1024ll;
+
+    int64 AlignUp(int64 Value)
+    {
+        return (Value + RawAlignment - 1) & ~(RawAlignment - 1);
+    }
+
+    int32 GetBytesPerPixel(EOmniCapturePixelDataType PixelDataType)
+    {
+        switch (PixelDataType)
+        {
+        case EOmniCapturePixelDataType::Color8: return sizeof(FColor);
+        case EOmniCapturePixelDataType::LinearColorFloat16: return sizeof(FFloat16Color);
+        case EOmniCapturePixelDataType::LinearColorFloat32: return sizeof(FLinearColor);
+        case EOmniCapturePixelDataType::ScalarFloat32: return sizeof(float);
+        case EOmniCapturePixelDataType::Vector2Float32: return sizeof(FVector2f);
+        default: return 0;
+        }
+    }
+
+    // Payloads tagged Unknown are named from the pixel type and the bytes each pixel takes.
+    EOmniCapturePixelDataType ResolvePixelDataType(const FImagePixelData& PixelData, EOmniCapturePixelDataType PixelDataType, int64 SizeInBytes)
+    {
+        if (PixelDataType != EOmniCapturePixelDataType::Unknown)
+        {
+            return PixelDataType;
+        }
+
+        const FIntPoint Size = PixelData.GetSize();
+        const int64 PixelCount = static_cast<int64>(Size.X) * Size.Y;
+        const int64 BytesPerPixel = PixelCount > 0 ? SizeInBytes / PixelCount : 0;
+        switch (PixelData.GetType())
+        {
+        case EImagePixelType::Color:
+            return EOmniCapturePixelDataType::Color8;
+        case EImagePixelType::Float16:
+            return EOmniCapturePixelDataType::LinearColorFloat16;
+        case EImagePixelType::Float32:
+            return BytesPerPixel == sizeof(float) ? EOmniCapturePixelDataType::ScalarFloat32
+                : BytesPerPixel == sizeof(FVector2f) ? EOmniCapturePixelDataType::Vector2Float32
+                : EOmniCapturePixelDataType::LinearColorFloat32;
+        default:
+            return EOmniCapturePixelDataType::Unknown;
+        }
+    }
+
+    struct FRawHeader
+    {
+        int64 IndexOffset = 0;
+        int64 IndexSize = 0;
+        int32 FrameCount = 0;
+    };
+
+    void SerializeHeader(FArchive& Ar, FRawHeader& Header, uint32& Version)
+    {
+        uint8 Magic[sizeof(RawMagic)];
+        FMemory::Memcpy(Magic, RawMagic, sizeof(RawMagic));
+        Ar.Serialize(Magic, sizeof(Magic));
+        if (Ar.IsLoading() && FMemory::Memcmp(Magic, RawMagic, sizeof(RawMagic)) != 0)
+        {
+            Ar.SetError();
+            return;
+        }
+
+        uint32 Alignment = static_cast<uint32>(RawAlignment);
+        Ar << Version;
+        Ar << Alignment;
+        Ar << Header.IndexOffset;
+        Ar << Header.IndexSize;
+        Ar << Header.FrameCount;
+        if (Ar.IsLoading() && Alignment != RawAlignment)
+        {
+            Ar.SetError();
+        }
+    }
+
+    void SerializeIndex(FArchive& Ar, FString& SettingsJson, TArray<FOmniCaptureRawFrameEntry>& Frames)
+    {
+        Ar << SettingsJson;
+
+        int32 FrameCount = Frames.Num();
+        Ar << FrameCount;
+        if (Ar.IsLoading())
+        {
+            if (FrameCount < 0)
+            {
+                Ar.SetError();
+                return;
+            }
+            Frames.SetNum(FrameCount);
+        }
+
+        for (FOmniCaptureRawFrameEntry& Entry : Frames)
+        {
+            Ar << Entry.Metadata.FrameIndex;
+            Ar << Entry.Metadata.Timecode;
+            Ar << Entry.Metadata.bKeyFrame;
+
+            int32 PlaneCount = Entry.Planes.Num();
+            Ar << PlaneCount;
+            if (Ar.IsLoading())
+            {
+                if (PlaneCount <= 0 || Ar.IsError())
+                {
+                    Ar.SetError();
+                    return;
+                }
+                Entry.Planes.SetNum(PlaneCount);
+            }
+
+            for (FOmniCaptureRawPlane& Plane : Entry.Planes)
+            {
+                FString LayerName = Plane.LayerName.IsNone() ? FString() : Plane.LayerName.ToString();
+                uint8 PixelDataType = static_cast<uint8>(Plane.PixelDataType);
+                uint8 Precision = static_cast<uint8>(Plane.Precision);
+                Ar << LayerName;
+                Ar << Plane.Size;
+                Ar << PixelDataType;
+                Ar << Precision;
+                Ar << Plane.bLinear;
+                Ar << Plane.Offset;
+                Ar << Plane.SizeInBytes;
+                if (Ar.IsLoading())
+                {
+                    Plane.LayerName = LayerName.IsEmpty() ? NAME_None : FName(*LayerName);
+                    Plane.PixelDataType = static_cast<EOmniCapturePixelDataType>(PixelDataType);
+                    Plane.Precision = static_cast<EOmniCapturePixelPrecision>(Precision);
+                }
+            }
+        }
+    }
+
+    template <typename PixelType>
+    TUniquePtr<FImagePixelData> AcquirePlane(const FIntPoint& Size, void*& OutPixels)
+    {
+        TUniquePtr<TImagePixelData<PixelType>> PixelData = FOmniCapturePixelBufferPool::Get().Acquire<PixelType>(Size);
+        OutPixels = PixelData->Pixels.GetData();
+        return PixelData;
+    }
+
+    TUniquePtr<FImagePixelData> AcquirePlane(const FOmniCaptureRawPlane& Plane, void*& OutPixels)
+    {
+        switch (Plane.PixelDataType)
+        {
+        case EOmniCapturePixelDataType::Color8: return AcquirePlane<FColor>(Plane.Size, OutPixels);
+        case EOmniCapturePixelDataType::LinearColorFloat16: return AcquirePlane<FFloat16Color>(Plane.Size, OutPixels);
+        case EOmniCapturePixelDataType::LinearColorFloat32: return AcquirePlane<FLinearColor>(Plane.Size, OutPixels);
+        case EOmniCapturePixelDataType::ScalarFloat32: return AcquirePlane<float>(Plane.Size, OutPixels);
+        case EOmniCapturePixelDataType::Vector2Float32: return AcquirePlane<FVector2f>(Plane.Size, OutPixels);
+        default: return nullptr;
+        }
+    }
+}
+
+FOmniCaptureRawContainerWriter::~FOmniCaptureRawContainerWriter()
+{
+    Close();
+}
+
+bool FOmniCaptureRawContainerWriter::Open(const FString& InFilePath, const FString& InSettingsJson)
+{
+    Close();
+
+    FScopeLock Lock(&WriteCS);
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.DeleteFile(*InFilePath);
+    FileHandle.Reset(PlatformFile.OpenWrite(*InFilePath, false, false));
+    if (!FileHandle.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to create raw capture container %s"), *InFilePath);
+        return false;
+    }
+
+    FilePath = InFilePath;
+    SettingsJson = InSettingsJson;
+    Frames.Reset();
+    WriteOffset = 0;
+    ReservedBytes = 0;
+    bCanReserve = true;
+    bWriteFailed = false;
+
+    // The real header goes in on Close; until then the page only holds the magic.
+    TArray<uint8> HeaderPage;
+    HeaderPage.SetNumZeroed(RawAlignment);
+    FMemory::Memcpy(HeaderPage.GetData(), RawMagic, sizeof(RawMagic));
+    return WritePadded(HeaderPage.GetData(), HeaderPage.Num());
+}
+
+bool FOmniCaptureRawContainerWriter::AppendFrame(const FOmniCaptureFrame& Frame)
+{
+    FScopeLock Lock(&WriteCS);
+    if (!FileHandle.IsValid() || bWriteFailed || !Frame.PixelData.IsValid())
+    {
+        return false;
+    }
+
+    FOmniCaptureRawFrameEntry Entry;
+    Entry.Metadata = Frame.Metadata;
+
+    const auto AppendPlane = [this, &Entry](FName LayerName, const FImagePixelData& PixelData, EOmniCapturePixelDataType PixelDataType, EOmniCapturePixelPrecision Precision, bool bLinear)
+    {
+        const void* RawData = nullptr;
+        int64 SizeInBytes = 0;
+        PixelData.GetRawData(RawData, SizeInBytes);
+
+        FOmniCaptureRawPlane& Plane = Entry.Planes.AddDefaulted_GetRef();
+        Plane.LayerName = LayerName;
+        Plane.Size = PixelData.GetSize();
+        Plane.PixelDataType = ResolvePixelDataType(PixelData, PixelDataType, SizeInBytes);
+        Plane.Precision = Precision;
+        Plane.bLinear = bLinear;
+        Plane.Offset = WriteOffset;
+        Plane.SizeInBytes = SizeInBytes;
+        return RawData && SizeInBytes > 0 && WritePadded(RawData, SizeInBytes);
+    };
+
+    bool bResult = AppendPlane(NAME_None, *Frame.PixelData, Frame.PixelDataType, Frame.PixelPrecision, Frame.bLinearColor);
+    for (const TPair<FName, FOmniCaptureLayerPayload>& Layer : Frame.AuxiliaryLayers)
+    {
+        if (bResult && Layer.Value.PixelData.IsValid())
+        {
+            bResult = AppendPlane(Layer.Key, *Layer.Value.PixelData, Layer.Value.PixelDataType, Layer.Value.Precision, Layer.Value.bLinear);
+        }
+    }
+
+    if (!bResult)
+    {
+        bWriteFailed = true;
+        return false;
+    }
+
+    Frames.Add(MoveTemp(Entry));
+    return true;
+}
+
+bool FOmniCaptureRawContainerWriter::Close()
+{
+    FScopeLock Lock(&WriteCS);
+    if (!FileHandle.IsValid())
+    {
+        return false;
+    }
+
+    FRawHeader Header;
+    Header.IndexOffset = WriteOffset;
+    Header.FrameCount = Frames.Num();
+
+    TArray<uint8> IndexBytes;
+    FMemoryWriter IndexWriter(IndexBytes);
+    SerializeIndex(IndexWriter, SettingsJson, Frames);
+    Header.IndexSize = IndexBytes.Num();
+
+    bool bResult = !bWriteFailed && WritePadded(IndexBytes.GetData(), IndexBytes.Num());
+    const int64 FinalSize = Header.IndexOffset + Header.IndexSize;
+    if (bResult && ReservedBytes > FinalSize)
+    {
+        FileHandle->Truncate(FinalSize);
+    }
+
+    TArray<uint8> HeaderBytes;
+    FMemoryWriter HeaderWriter(HeaderBytes);
+    uint32 Version = RawVersion;
+    SerializeHeader(HeaderWriter, Header, Version);
+    bResult = bResult && FileHandle->Seek(0) && FileHandle->Write(HeaderBytes.GetData(), HeaderBytes.Num()) && FileHandle->Flush();
+
+    FileHandle.Reset();
+    Frames.Reset();
+    if (!bResult)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to finish raw capture container %s"), *FilePath);
+    }
+    return bResult;
+}
+
+bool FOmniCaptureRawContainerWriter::WritePadded(const void* Data, int64 SizeInBytes)
+{
+    static const uint8 ZeroPage[RawAlignment] = {};
+
+    const int64 PaddedSize = AlignUp(SizeInBytes);
+    if (!EnsureReserved(WriteOffset + PaddedSize))
+    {
+        return false;
+    }
+
+    if (!FileHandle->Write(static_cast<const uint8*>(Data), SizeInBytes)
+        || (PaddedSize > SizeInBytes && !FileHandle->Write(ZeroPage, PaddedSize - SizeInBytes)))
+    {
+        bWriteFailed = true;
+        return false;
+    }
+
+    WriteOffset += PaddedSize;
+    return true;
+}
+
+bool FOmniCaptureRawContainerWriter::EnsureReserved(int64 EndOffset)
+{
+    if (!bCanReserve || EndOffset <= ReservedBytes)
+    {
+        return true;
+    }
+
+    // Extending in big steps lets the file system hand out long contiguous runs.
+    const int64 NewReserved = FMath::Max(EndOffset, ReservedBytes + RawReserveStep);
+    if (!FileHandle->Truncate(NewReserved))
+    {
+        bCanReserve = false;
+        return FileHandle->Seek(WriteOffset);
+    }
+
+    ReservedBytes = NewReserved;
+    return FileHandle->Seek(WriteOffset);
+}
+
+FOmniCaptureRawContainerReader::~FOmniCaptureRawContainerReader()
+{
+    Close();
+}
+
+bool FOmniCaptureRawContainerReader::Open(const FString& InFilePath)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    FileSize = PlatformFile.FileSize(*InFilePath);
+    if (FileSize < RawAlignment)
+    {
+        return false;
+    }
+
+    MappedFile.Reset(PlatformFile.OpenMapped(*InFilePath));
+    if (!MappedFile.IsValid())
+    {
+        FileHandle.Reset(PlatformFile.OpenRead(*InFilePath));
+        if (!FileHandle.IsValid())
+        {
+            return false;
+        }
+    }
+
+    TArray<uint8> HeaderBytes;
+    HeaderBytes.SetNumUninitialized(RawAlignment);
+    if (!ReadBytes(0, HeaderBytes.Num(), HeaderBytes.GetData()))
+    {
+        Close();
+        return false;
+    }
+
+    FRawHeader Header;
+    uint32 Version = 0;
+    FMemoryReader HeaderReader(HeaderBytes);
+    SerializeHeader(HeaderReader, Header, Version);
+    if (HeaderReader.IsError() || Version != RawVersion || Header.IndexOffset < RawAlignment || Header.IndexSize <= 0
+        || Header.IndexOffset + Header.IndexSize > FileSize)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s is not a finished raw capture container"), *InFilePath);
+        Close();
+        return false;
+    }
+
+    TArray<uint8> IndexBytes;
+    IndexBytes.SetNumUninitialized(Header.IndexSize);
+    if (!ReadBytes(Header.IndexOffset, Header.IndexSize, IndexBytes.GetData()))
+    {
+        Close();
+        return false;
+    }
+
+    FMemoryReader IndexReader(IndexBytes);
+    SerializeIndex(IndexReader, SettingsJson, Frames);
+    bool bValid = !IndexReader.IsError() && Frames.Num() == Header.FrameCount;
+    for (const FOmniCaptureRawFrameEntry& Entry : Frames)
+    {
+        for (const FOmniCaptureRawPlane& Plane : Entry.Planes)
+        {
+            const int64 ExpectedBytes = static_cast<int64>(Plane.Size.X) * Plane.Size.Y * GetBytesPerPixel(Plane.PixelDataType);
+            bValid &= ExpectedBytes > 0 && Plane.SizeInBytes == ExpectedBytes && Plane.Offset >= RawAlignment && Plane.Offset + Plane.SizeInBytes <= Header.IndexOffset;
+        }
+    }
+
+    if (!bValid)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Raw capture container %s has a damaged frame index"), *InFilePath);
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void FOmniCaptureRawContainerReader::Close()
+{
+    MappedFile.Reset();
+    FileHandle.Reset();
+    FileSize = 0;
+    SettingsJson.Reset();
+    Frames.Reset();
+}
+
+bool FOmniCaptureRawContainerReader::ReadFrame(int32 Index, FOmniCaptureFrame& OutFrame) const
+{
+    if (!Frames.IsValidIndex(Index))
+    {
+        return false;
+    }
+
+    const FOmniCaptureRawFrameEntry& Entry = Frames[Index];
+    OutFrame.Metadata = Entry.Metadata;
+    OutFrame.AuxiliaryLayers.Reset();
+
+    for (const FOmniCaptureRawPlane& Plane : Entry.Planes)
+    {
+        void* Pixels = nullptr;
+        TUniquePtr<FImagePixelData> PixelData = AcquirePlane(Plane, Pixels);
+        if (!PixelData.IsValid() || !ReadBytes(Plane.Offset, Plane.SizeInBytes, Pixels))
+        {
+            FOmniCapturePixelBufferPool::Get().Release(MoveTemp(PixelData), Plane.PixelDataType);
+            FOmniCapturePixelBufferPool::Get().ReleaseFrame(OutFrame);
+            return false;
+        }
+
+        if (Plane.LayerName.IsNone())
+        {
+            OutFrame.PixelData = MoveTemp(PixelData);
+            OutFrame.PixelDataType = Plane.PixelDataType;
+            OutFrame.PixelPrecision = Plane.Precision;
+            OutFrame.bLinearColor = Plane.bLinear;
+        }
+        else
+        {
+            FOmniCaptureLayerPayload& Layer = OutFrame.AuxiliaryLayers.Add(Plane.LayerName);
+            Layer.PixelData = MoveTemp(PixelData);
+            Layer.PixelDataType = Plane.PixelDataType;
+            Layer.Precision = Plane.Precision;
+            Layer.bLinear = Plane.bLinear;
+        }
+    }
+
+    return OutFrame.PixelData.IsValid();
+}
+
+bool FOmniCaptureRawContainerReader::ReadBytes(int64 Offset, int64 SizeInBytes, void* Dest) const
+{
+    if (Offset < 0 || SizeInBytes <= 0 || Offset + SizeInBytes > FileSize)
+    {
+        return false;
+    }
+
+    if (MappedFile.IsValid())
+    {
+        TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(Offset, SizeInBytes));
+        if (!Region.IsValid() || Region->GetMappedSize() < SizeInBytes)
+        {
+            return false;
+        }
+        FMemory::Memcpy(Dest, Region->GetMappedPtr(), SizeInBytes);
+        return true;
+    }
+
+    FScopeLock Lock(&ReadCS);
+    return FileHandle.IsValid() && FileHandle->Seek(Offset) && FileHandle->Read(static_cast<uint8*>(Dest), SizeInBytes);
+}
@@ -2,6 +2,7 @@
 
 #include "Components/SceneComponent.h"
 #include "Components/SceneCaptureComponent2D.h"
+#include "OmniCaptureEquirectConverter.h"
 #include "OmniCaptureIncludeFixes.h"
 #include "UObject/Package.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -152,6 +153,8 @@ void AOmniCaptureRigActor::Configure(const FOmniCaptureSettings& InSettings)
         ? CachedSettings.GetPlanarResolution()
         : FIntPoint(CachedSettings.Resolution, CachedSettings.Resolution);
 
+    FaceCoverage = FOmniCaptureEquirectConverter::ComputeFaceCoverage(CachedSettings);
+
     const float IPDHalf = CachedSettings.Mode == EOmniCaptureMode::Stereo
         ? CachedSettings.InterPupillaryDistanceCm * 0.5f
         : 0.0f;
@@ -419,6 +422,7 @@ void AOmniCaptureRigActor::CaptureEye(EOmniCaptureEye Eye, FOmniEyeCapture& OutC
     const TArray<USceneCaptureComponent2D*>& CaptureComponents = Eye == EOmniCaptureEye::Left ? LeftEyeCaptures : RightEyeCaptures;
 
     OutCapture.ActiveFaceCount = CaptureComponents.Num();
+    OutCapture.Coverage = FaceCoverage;
 
     for (int32 FaceIndex = 0; FaceIndex < UE_ARRAY_COUNT(OutCapture.Faces); ++FaceIndex)
     {
@@ -430,7 +434,12 @@ void AOmniCaptureRigActor::CaptureEye(EOmniCaptureEye Eye, FOmniEyeCapture& OutC
     {
         if (USceneCaptureComponent2D* CaptureComponent = CaptureComponents[FaceIndex])
         {
-            CaptureComponent->CaptureScene();
+            // Culled faces still hand out their target so the GPU face array
+            // keeps its layout; the projection never samples them.
+            if (FaceCoverage.IsFaceUsed(FaceIndex))
+            {
+                CaptureComponent->CaptureScene();
+            }
 
             UTextureRenderTarget2D* RenderTarget = Cast<UTextureRenderTarget2D>(CaptureComponent->TextureTarget);
             OutCapture.Faces[FaceIndex].RenderTarget = RenderTarget;
@@ -449,7 +458,10 @@ void AOmniCaptureRigActor::CaptureEye(EOmniCaptureEye Eye, FOmniEyeCapture& OutC
             {
                 if (USceneCaptureComponent2D* AuxCapture = AuxCaptures[FaceIndex])
                 {
-                    AuxCapture->CaptureScene();
+                    if (FaceCoverage.IsFaceUsed(FaceIndex))
+                    {
+                        AuxCapture->CaptureScene();
+                    }
                     if (UTextureRenderTarget2D* AuxTarget = Cast<UTextureRenderTarget2D>(AuxCapture->TextureTarget))
                     {
                         OutCapture.Faces[FaceIndex].AuxiliaryTargets.Add(PassType, AuxTarget);
@@ -1,35 +1,158 @@
 #include "OmniCaptureRingBuffer.h"
 
+#include "OmniCapturePixelBufferPool.h"
+
+#include "HAL/Event.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
 #include "Math/UnrealMathUtility.h"
+#include "Misc/ScopeLock.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOmniCaptureRingBuffer, Log, All);
+
+namespace
+{
+    // The ring is fixed-size, so a capacity of 0 ("unbounded") gets this many slots.
+    constexpr int32 DefaultRingBufferCapacity = 64;
+    constexpr int32 MaxRingBufferConsumers = 16;
+
+    FORCEINLINE FVector4f ToAccumulator(const FColor& Pixel) { return FVector4f(Pixel.R, Pixel.G, Pixel.B, Pixel.A); }
+    FORCEINLINE FVector4f ToAccumulator(const FFloat16Color& Pixel) { const FLinearColor Linear(Pixel); return FVector4f(Linear.R, Linear.G, Linear.B, Linear.A); }
+    FORCEINLINE FVector4f ToAccumulator(const FLinearColor& Pixel) { return FVector4f(Pixel.R, Pixel.G, Pixel.B, Pixel.A); }
+    FORCEINLINE FVector4f ToAccumulator(float Pixel) { return FVector4f(Pixel, 0.0f, 0.0f, 0.0f); }
+    FORCEINLINE FVector4f ToAccumulator(const FVector2f& Pixel) { return FVector4f(Pixel.X, Pixel.Y, 0.0f, 0.0f); }
+
+    FORCEINLINE void FromAccumulator(const FVector4f& Value, FColor& OutPixel)
+    {
+        OutPixel = FColor(
+            static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Value.X), 0, 255)),
+            static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Value.Y), 0, 255)),
+            static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Value.Z), 0, 255)),
+            static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(Value.W), 0, 255)));
+    }
+    FORCEINLINE void FromAccumulator(const FVector4f& Value, FFloat16Color& OutPixel) { OutPixel = FFloat16Color(FLinearColor(Value.X, Value.Y, Value.Z, Value.W)); }
+    FORCEINLINE void FromAccumulator(const FVector4f& Value, FLinearColor& OutPixel) { OutPixel = FLinearColor(Value.X, Value.Y, Value.Z, Value.W); }
+    FORCEINLINE void FromAccumulator(const FVector4f& Value, float& OutPixel) { OutPixel = Value.X; }
+    FORCEINLINE void FromAccumulator(const FVector4f& Value, FVector2f& OutPixel) { OutPixel = FVector2f(Value.X, Value.Y); }
+
+    // 2x2 box filter. Odd trailing rows and columns fold into the last output texel.
+    template <typename PixelType>
+    TUniquePtr<FImagePixelData> DownsampleHalf(const FImagePixelData& Source)
+    {
+        const TImagePixelData<PixelType>& Typed = static_cast<const TImagePixelData<PixelType>&>(Source);
+        const FIntPoint SourceSize = Typed.GetSize();
+        const FIntPoint Size(FMath::Max(1, SourceSize.X / 2), FMath::Max(1, SourceSize.Y / 2));
+        if (Typed.Pixels.Num() != static_cast<int64>(SourceSize.X) * SourceSize.Y)
+        {
+            return nullptr;
+        }
+
+        TUniquePtr<TImagePixelData<PixelType>> Result = FOmniCapturePixelBufferPool::Get().Acquire<PixelType>(Size);
+
+        for (int32 Y = 0; Y < Size.Y; ++Y)
+        {
+            const int64 Row0 = static_cast<int64>(FMath::Min(Y * 2, SourceSize.Y - 1)) * SourceSize.X;
+            const int64 Row1 = static_cast<int64>(FMath::Min(Y * 2 + 1, SourceSize.Y - 1)) * SourceSize.X;
+            for (int32 X = 0; X < Size.X; ++X)
+            {
+                const int32 X0 = FMath::Min(X * 2, SourceSize.X - 1);
+                const int32 X1 = FMath::Min(X * 2 + 1, SourceSize.X - 1);
+                const FVector4f Sum = ToAccumulator(Typed.Pixels[Row0 + X0]) + ToAccumulator(Typed.Pixels[Row0 + X1])
+                    + ToAccumulator(Typed.Pixels[Row1 + X0]) + ToAccumulator(Typed.Pixels[Row1 + X1]);
+                FromAccumulator(Sum * 0.25f, Result->Pixels[static_cast<int64>(Y) * Size.X + X]);
+            }
+        }
+
+        return Result;
+    }
+
+    bool DownsamplePixelData(TUniquePtr<FImagePixelData>& PixelData, EOmniCapturePixelDataType PixelDataType)
+    {
+        if (!PixelData.IsValid())
+        {
+            return false;
+        }
+
+        if (PixelDataType == EOmniCapturePixelDataType::Unknown)
+        {
+            switch (PixelData->GetType())
+            {
+            case EImagePixelType::Color: PixelDataType = EOmniCapturePixelDataType::Color8; break;
+            case EImagePixelType::Float16: PixelDataType = EOmniCapturePixelDataType::LinearColorFloat16; break;
+            case EImagePixelType::Float32: PixelDataType = EOmniCapturePixelDataType::LinearColorFloat32; break;
+            default: return false;
+            }
+        }
+
+        TUniquePtr<FImagePixelData> Downsampled;
+        switch (PixelDataType)
+        {
+        case EOmniCapturePixelDataType::Color8: Downsampled = DownsampleHalf<FColor>(*PixelData); break;
+        case EOmniCapturePixelDataType::LinearColorFloat16: Downsampled = DownsampleHalf<FFloat16Color>(*PixelData); break;
+        case EOmniCapturePixelDataType::LinearColorFloat32: Downsampled = DownsampleHalf<FLinearColor>(*PixelData); break;
+        case EOmniCapturePixelDataType::ScalarFloat32: Downsampled = DownsampleHalf<float>(*PixelData); break;
+        case EOmniCapturePixelDataType::Vector2Float32: Downsampled = DownsampleHalf<FVector2f>(*PixelData); break;
+        default: break;
+        }
+
+        if (!Downsampled.IsValid())
+        {
+            return false;
+        }
+
+        FOmniCapturePixelBufferPool::Get().Release(MoveTemp(PixelData), PixelDataType);
+        PixelData = MoveTemp(Downsampled);
+        return true;
+    }
+
+    // Halves the frame and its auxiliary layers in place. Streamed frames have no canvas to shrink.
+    bool DegradeFrame(FOmniCaptureFrame& Frame)
+    {
+        if (Frame.RowSource.IsValid())
+        {
+            return false;
+        }
+
+        bool bChanged = DownsamplePixelData(Frame.PixelData, Frame.PixelDataType);
+        for (TPair<FName, FOmniCaptureLayerPayload>& Layer : Frame.AuxiliaryLayers)
+        {
+            bChanged |= DownsamplePixelData(Layer.Value.PixelData, Layer.Value.PixelDataType);
+        }
+        return bChanged;
+    }
+}
 
 class FOmniCaptureRingBufferWorker final : public FRunnable
 {
 public:
-    FOmniCaptureRingBufferWorker(TQueue<TUniquePtr<FOmniCaptureFrame>, EQueueMode::Mpsc>& InQueue, FEvent* InEvent, const TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)>& InConsumer, FCriticalSection& InQueueCS, TAtomic<bool>& InRunning, TAtomic<int32>& InPending)
-        : Queue(InQueue)
-        , DataEvent(InEvent)
-        , Consumer(InConsumer)
-        , QueueCS(InQueueCS)
-        , bRunning(InRunning)
-        , Pending(InPending)
+    explicit FOmniCaptureRingBufferWorker(FOmniCaptureRingBuffer& InOwner)
+        : Owner(InOwner)
+        , DataEvent(FPlatformProcess::GetSynchEventFromPool())
     {
     }
 
+    virtual ~FOmniCaptureRingBufferWorker() override
+    {
+        FPlatformProcess::ReturnSynchEventToPool(DataEvent);
+    }
+
     virtual uint32 Run() override
     {
-        while (bRunning.Load())
+        while (Owner.bRunning.Load())
         {
-            DataEvent->Wait();
+            Drain();
 
-            if (!bRunning.Load())
+            // Publish the idle flag before the final emptiness check so a producer
+            // either sees it and signals, or its frame is seen here.
+            bIdle.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (Owner.Queue->IsEmpty() && Owner.bRunning.Load())
             {
-                break;
+                DataEvent->Wait();
             }
-
-            Drain();
+            bIdle.store(false, std::memory_order_relaxed);
         }
 
         Drain();
@@ -37,187 +160,510 @@ public:
         return 0;
     }
 
-private:
-    void Drain()
+    // Claims this worker for one wake-up. Fails if it is busy or already claimed.
+    bool TryWake()
     {
-        if (!Consumer)
+        bool bExpected = true;
+        if (!bIdle.compare_exchange_strong(bExpected, false))
         {
-            return;
+            return false;
         }
 
-        for (;;)
+        DataEvent->Trigger();
+        return true;
+    }
+
+    void WakeForShutdown()
+    {
+        DataEvent->Trigger();
+    }
+
+private:
+    void Drain()
+    {
+        FOmniCaptureRingBuffer::FQueuedFrame Queued;
+        while (Owner.DequeueFrame(Queued))
         {
-            TUniquePtr<FOmniCaptureFrame> Frame;
+            // Hand the rest of the backlog to another idle worker before working on this frame.
+            if (!Owner.Queue->IsEmpty())
             {
-                FScopeLock Lock(&QueueCS);
-                if (!Queue.Dequeue(Frame))
-                {
-                    break;
-                }
+                Owner.WakeConsumer();
             }
 
-            if (Frame.IsValid())
-            {
-                Consumer(MoveTemp(Frame));
-                Pending.DecrementExchange();
-            }
+            Owner.ProcessFrame(MoveTemp(Queued));
         }
+
+        // Frames finished while another worker was committing, or behind a dropped
+        // frame, are picked up here.
+        Owner.CommitReadyFrames();
     }
 
 private:
-    TQueue<TUniquePtr<FOmniCaptureFrame>, EQueueMode::Mpsc>& Queue;
+    FOmniCaptureRingBuffer& Owner;
     FEvent* DataEvent = nullptr;
-    TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)> Consumer;
-    FCriticalSection& QueueCS;
-    TAtomic<bool>& bRunning;
-    TAtomic<int32>& Pending;
+    std::atomic<bool> bIdle{ false };
 };
 
 FOmniCaptureRingBuffer::FOmniCaptureRingBuffer()
 {
     bRunning = false;
-    PendingCount = 0;
     DroppedCount = 0;
     BlockedCount = 0;
+    TotalBlockedMicroseconds = 0;
+    MaxBlockedMicroseconds = 0;
+    DegradedCount = 0;
+    QueuedBytes = 0;
+    InFlightBytes = 0;
+    PeakQueuedBytes = 0;
+    SlotFreedEvent = FPlatformProcess::GetSynchEventFromPool();
 }
 
 FOmniCaptureRingBuffer::~FOmniCaptureRingBuffer()
 {
-    StopWorker();
+    StopWorkers();
     Flush();
-
-    if (DataEvent)
-    {
-        FPlatformProcess::ReturnSynchEventToPool(DataEvent);
-        DataEvent = nullptr;
-    }
+    FPlatformProcess::ReturnSynchEventToPool(SlotFreedEvent);
+    SlotFreedEvent = nullptr;
 }
 
 void FOmniCaptureRingBuffer::Initialize(const FOmniCaptureSettings& Settings, const TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)>& InConsumer)
 {
-    Consumer = InConsumer;
-    Capacity = FMath::Max(0, Settings.RingBufferCapacity);
+    Initialize(Settings, TFunction<void(FOmniCaptureFrame&)>(), InConsumer);
+}
+
+void FOmniCaptureRingBuffer::Initialize(const FOmniCaptureSettings& Settings, const TFunction<void(FOmniCaptureFrame&)>& InProcess, const TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)>& InCommit)
+{
+    Process = InProcess;
+    Commit = InCommit;
     Policy = Settings.RingBufferPolicy;
-    StartWorker();
+    BlockTimeoutMs = FMath::Max(0.0, static_cast<double>(Settings.RingBufferBlockTimeoutMs));
+    MemoryBudgetBytes = static_cast<int64>(FMath::Max(0, Settings.RingBufferMemoryBudgetMB)) * 1024 * 1024;
+
+    // Halving a frame cannot free a slot, so Degrade only means something against a byte budget.
+    if (Policy == EOmniCaptureRingBufferPolicy::Degrade && MemoryBudgetBytes <= 0)
+    {
+        UE_LOG(LogOmniCaptureRingBuffer, Warning, TEXT("The Degrade ring buffer policy needs RingBufferMemoryBudgetMB to be set; falling back to BlockProducer."));
+        Policy = EOmniCaptureRingBufferPolicy::BlockProducer;
+    }
+
+    const int32 Capacity = Settings.RingBufferCapacity > 0 ? Settings.RingBufferCapacity : DefaultRingBufferCapacity;
+    Queue = MakeUnique<FFrameQueue>(Capacity);
+
+    StartWorkers(FMath::Clamp(Settings.RingBufferConsumerCount, 1, MaxRingBufferConsumers));
 }
 
 void FOmniCaptureRingBuffer::Enqueue(TUniquePtr<FOmniCaptureFrame>&& Frame)
 {
-    if (!Consumer)
+    if (!Commit || !Queue.IsValid())
     {
         return;
     }
 
-    if (Capacity > 0)
+    FQueuedFrame Queued;
+    Queued.Sequence = NextSequence++;
+    Queued.Bytes = Frame.IsValid() ? Frame->GetAllocatedSize() : 0;
+    Queued.Frame = MoveTemp(Frame);
+
+    if (!TryPush(Queued))
     {
-        for (;;)
+        switch (Policy)
         {
-            const int32 Current = PendingCount.Load();
-            if (Current < Capacity)
+        case EOmniCaptureRingBufferPolicy::BlockProducer:
+            // A push that times out falls back to dropping the oldest frame.
+            if (!WaitForFreeSlot(Queued, BlockTimeoutMs))
             {
-                break;
+                PushDroppingOldest(Queued);
             }
+            break;
+        case EOmniCaptureRingBufferPolicy::DropNewest:
+            DiscardFrame(MoveTemp(Queued));
+            break;
+        case EOmniCaptureRingBufferPolicy::PreserveKeyframes:
+            PushPreservingKeyframes(Queued);
+            break;
+        case EOmniCaptureRingBufferPolicy::Degrade:
+            PushDegraded(Queued);
+            break;
+        case EOmniCaptureRingBufferPolicy::DropOldest:
+        default:
+            PushDroppingOldest(Queued);
+            break;
+        }
+    }
 
-            if (Policy == EOmniCaptureRingBufferPolicy::DropOldest)
-            {
-                TUniquePtr<FOmniCaptureFrame> Discarded;
-                {
-                    FScopeLock Lock(&QueueCriticalSection);
-                    if (Queue.Dequeue(Discarded))
-                    {
-                        PendingCount.DecrementExchange();
-                    }
-                }
-                DroppedCount.IncrementExchange();
-                break;
-            }
-            else
+    WakeConsumer();
+}
+
+bool FOmniCaptureRingBuffer::WaitForFreeSlot(FQueuedFrame& Queued, double TimeoutMs)
+{
+    if (TimeoutMs == 0.0)
+    {
+        return false;
+    }
+
+    BlockedCount.IncrementExchange();
+
+    // A negative timeout waits for as long as the consumers are running.
+    const bool bUnbounded = TimeoutMs < 0.0;
+    const double StartSeconds = FPlatformTime::Seconds();
+    const double DeadlineSeconds = StartSeconds + FMath::Max(TimeoutMs, 0.0) / 1000.0;
+    bool bEnqueued = false;
+
+    for (;;)
+    {
+        // Publish the wait before retrying so a consumer that frees a slot after the retry signals us.
+        bProducerWaiting.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (TryPush(Queued))
+        {
+            bEnqueued = true;
+            break;
+        }
+
+        const double RemainingMs = bUnbounded ? 1000.0 : (DeadlineSeconds - FPlatformTime::Seconds()) * 1000.0;
+        if (RemainingMs <= 0.0 || !bRunning.Load())
+        {
+            break;
+        }
+
+        WakeConsumer();
+        SlotFreedEvent->Wait(static_cast<uint32>(FMath::Clamp(FMath::CeilToDouble(RemainingMs), 1.0, 1000.0)));
+    }
+
+    bProducerWaiting.store(false, std::memory_order_relaxed);
+
+    const int64 StallMicroseconds = static_cast<int64>((FPlatformTime::Seconds() - StartSeconds) * 1000000.0);
+    TotalBlockedMicroseconds.AddExchange(StallMicroseconds);
+    if (StallMicroseconds > MaxBlockedMicroseconds.Load())
+    {
+        // Only the producer writes the maximum.
+        MaxBlockedMicroseconds.Store(StallMicroseconds);
+    }
+
+    return bEnqueued;
+}
+
+bool FOmniCaptureRingBuffer::TryPush(FQueuedFrame& Queued)
+{
+    const int64 Bytes = Queued.Bytes;
+
+    // Frames being processed or waiting to be committed in order count against the budget too.
+    // A frame larger than the whole budget is still accepted into an empty ring.
+    if (MemoryBudgetBytes > 0 && QueuedBytes.Load() + InFlightBytes.Load() + Bytes > MemoryBudgetBytes && !Queue->IsEmpty())
+    {
+        return false;
+    }
+
+    // Charge the bytes first so a consumer that dequeues the frame at once never sees them negative.
+    const int64 NewQueuedBytes = QueuedBytes.AddExchange(Bytes) + Bytes + InFlightBytes.Load();
+    if (!Queue->TryEnqueue(MoveTemp(Queued)))
+    {
+        QueuedBytes.SubExchange(Bytes);
+        return false;
+    }
+
+    if (NewQueuedBytes > PeakQueuedBytes.Load())
+    {
+        // Only the producer writes the peak.
+        PeakQueuedBytes.Store(NewQueuedBytes);
+    }
+    return true;
+}
+
+void FOmniCaptureRingBuffer::PushDroppingOldest(FQueuedFrame& Queued)
+{
+    while (!TryPush(Queued))
+    {
+        FQueuedFrame Discarded;
+        if (Queue->TryDequeue(Discarded))
+        {
+            QueuedBytes.SubExchange(Discarded.Bytes);
+            DiscardFrame(MoveTemp(Discarded));
+        }
+    }
+}
+
+void FOmniCaptureRingBuffer::PushPreservingKeyframes(FQueuedFrame& Queued)
+{
+    const auto IsKeyFrame = [](const FQueuedFrame& Item)
+    {
+        return Item.Frame.IsValid() && Item.Frame->Metadata.bKeyFrame;
+    };
+
+    while (!TryPush(Queued))
+    {
+        bool bDropped = false;
+        ForEachQueuedFrame([&bDropped, &IsKeyFrame](FQueuedFrame& Item)
+        {
+            if (!bDropped && !IsKeyFrame(Item))
             {
-                BlockedCount.IncrementExchange();
-                FPlatformProcess::Sleep(0.001f);
+                bDropped = true;
+                return false;
             }
+            return true;
+        });
+
+        if (bDropped)
+        {
+            continue;
+        }
+
+        // Only keyframes are queued. A non-keyframe gives way; a keyframe is never dropped, so it
+        // waits for a consumer however long that takes.
+        if (!IsKeyFrame(Queued))
+        {
+            DiscardFrame(MoveTemp(Queued));
+            return;
         }
+
+        const int32 FrameIndex = Queued.Frame->Metadata.FrameIndex;
+        const double WaitStartSeconds = FPlatformTime::Seconds();
+        const bool bEnqueued = WaitForFreeSlot(Queued, -1.0);
+        const double StallMs = (FPlatformTime::Seconds() - WaitStartSeconds) * 1000.0;
+        if (StallMs > BlockTimeoutMs)
+        {
+            UE_LOG(LogOmniCaptureRingBuffer, Warning, TEXT("Ring buffer held only keyframes; the capture stalled %.1f ms to queue keyframe %d."), StallMs, FrameIndex);
+        }
+
+        if (!bEnqueued)
+        {
+            // Only reached once the consumers are shutting down and nothing will be committed.
+            UE_LOG(LogOmniCaptureRingBuffer, Error, TEXT("Ring buffer stopped before keyframe %d could be queued."), FrameIndex);
+            DiscardFrame(MoveTemp(Queued));
+        }
+        return;
     }
+}
 
+void FOmniCaptureRingBuffer::PushDegraded(FQueuedFrame& Queued)
+{
+    // Initialize guarantees a byte budget. A ring that is full by count needs a free slot either
+    // way. Only the incoming frame is shrunk, so the producer never filters the backlog.
+    if (!Queued.bDegraded && Queued.Frame.IsValid() && DegradeFrame(*Queued.Frame))
     {
-        FScopeLock Lock(&QueueCriticalSection);
-        Queue.Enqueue(MoveTemp(Frame));
-        PendingCount.IncrementExchange();
+        Queued.bDegraded = true;
+        Queued.Bytes = Queued.Frame->GetAllocatedSize();
+        DegradedCount.IncrementExchange();
+
+        if (TryPush(Queued))
+        {
+            return;
+        }
     }
 
-    if (DataEvent)
+    if (!WaitForFreeSlot(Queued, BlockTimeoutMs))
     {
-        DataEvent->Trigger();
+        PushDroppingOldest(Queued);
     }
 }
 
-void FOmniCaptureRingBuffer::Flush()
+void FOmniCaptureRingBuffer::ForEachQueuedFrame(TFunctionRef<bool(FQueuedFrame&)> Visit)
 {
-    if (!Consumer)
+    // Cycling every entry from the head back to the tail leaves the queue order unchanged.
+    // Only the producer enqueues, so each re-enqueue has a slot, but a consumer that claimed
+    // an earlier position may not have released it yet: retry until it does.
+    const int32 Count = Queue->Num();
+    for (int32 Index = 0; Index < Count; ++Index)
     {
-        return;
+        FQueuedFrame Item;
+        if (!Queue->TryDequeue(Item))
+        {
+            break;
+        }
+        QueuedBytes.SubExchange(Item.Bytes);
+
+        if (!Visit(Item))
+        {
+            DiscardFrame(MoveTemp(Item));
+            continue;
+        }
+
+        QueuedBytes.AddExchange(Item.Bytes);
+        while (!Queue->TryEnqueue(MoveTemp(Item)))
+        {
+            FPlatformProcess::YieldThread();
+        }
+    }
+}
+
+void FOmniCaptureRingBuffer::DiscardFrame(FQueuedFrame&& Discarded)
+{
+    DroppedCount.IncrementExchange();
+
+    if (Discarded.Frame.IsValid())
+    {
+        FOmniCapturePixelBufferPool::Get().ReleaseFrame(*Discarded.Frame);
+    }
+
+    // Leave a gap marker so the commit sequence moves past this frame.
+    FScopeLock Lock(&CommitCS);
+    ReadyFrames.Add(Discarded.Sequence, nullptr);
+}
+
+bool FOmniCaptureRingBuffer::DequeueFrame(FQueuedFrame& OutQueued)
+{
+    if (!Queue->TryDequeue(OutQueued))
+    {
+        return false;
+    }
+    // Move the bytes over before releasing them from the queue so the total never dips.
+    InFlightBytes.AddExchange(OutQueued.Bytes);
+    QueuedBytes.SubExchange(OutQueued.Bytes);
+
+    // Pairs with the fence in WaitForFreeSlot.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (bProducerWaiting.load(std::memory_order_relaxed))
+    {
+        SlotFreedEvent->Trigger();
+    }
+    return true;
+}
+
+void FOmniCaptureRingBuffer::WakeConsumer()
+{
+    // Pairs with the fence in the worker: the frame is published before the idle flags are read.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (FOmniCaptureRingBufferWorker* Worker : Workers)
+    {
+        if (Worker->TryWake())
+        {
+            return;
+        }
+    }
+}
+
+void FOmniCaptureRingBuffer::ProcessFrame(FQueuedFrame&& Queued)
+{
+    if (Process && Queued.Frame.IsValid())
+    {
+        Process(*Queued.Frame);
+    }
+
+    CompleteFrame(Queued.Sequence, MoveTemp(Queued.Frame), Queued.Bytes);
+}
+
+void FOmniCaptureRingBuffer::CompleteFrame(uint64 Sequence, TUniquePtr<FOmniCaptureFrame>&& Frame, int64 ChargedBytes)
+{
+    {
+        FScopeLock Lock(&CommitCS);
+        // Processing may have released or moved the pixels: charge what the parked frame still holds.
+        InFlightBytes.AddExchange((Frame.IsValid() ? Frame->GetAllocatedSize() : 0) - ChargedBytes);
+        ReadyFrames.Add(Sequence, MoveTemp(Frame));
+    }
+
+    CommitReadyFrames();
+}
+
+void FOmniCaptureRingBuffer::CommitReadyFrames()
+{
+    {
+        FScopeLock Lock(&CommitCS);
+        if (bCommitInProgress)
+        {
+            // The active committer re-checks the map before it stops.
+            return;
+        }
+        bCommitInProgress = true;
     }
 
-    TUniquePtr<FOmniCaptureFrame> Frame;
     for (;;)
     {
+        TUniquePtr<FOmniCaptureFrame> Frame;
         {
-            FScopeLock Lock(&QueueCriticalSection);
-            if (!Queue.Dequeue(Frame))
+            FScopeLock Lock(&CommitCS);
+            TUniquePtr<FOmniCaptureFrame>* Ready = ReadyFrames.Find(NextCommitSequence);
+            if (!Ready)
             {
-                break;
+                bCommitInProgress = false;
+                return;
             }
+
+            Frame = MoveTemp(*Ready);
+            ReadyFrames.Remove(NextCommitSequence);
+            InFlightBytes.SubExchange(Frame.IsValid() ? Frame->GetAllocatedSize() : 0);
+            ++NextCommitSequence;
         }
 
-        if (Frame.IsValid())
+        if (Frame.IsValid() && Commit)
         {
-            Consumer(MoveTemp(Frame));
-            PendingCount.DecrementExchange();
+            Commit(MoveTemp(Frame));
         }
     }
 }
 
-void FOmniCaptureRingBuffer::StartWorker()
+void FOmniCaptureRingBuffer::Flush()
+{
+    if (!Queue.IsValid())
+    {
+        return;
+    }
+
+    FQueuedFrame Queued;
+    while (DequeueFrame(Queued))
+    {
+        ProcessFrame(MoveTemp(Queued));
+    }
+
+    CommitReadyFrames();
+}
+
+void FOmniCaptureRingBuffer::StartWorkers(int32 WorkerCount)
 {
-    if (WorkerThread.IsValid())
+    if (WorkerThreads.Num() > 0 || !Queue.IsValid())
     {
         return;
     }
 
-    DataEvent = FPlatformProcess::GetSynchEventFromPool();
     bRunning = true;
 
-    Worker = new FOmniCaptureRingBufferWorker(Queue, DataEvent, Consumer, QueueCriticalSection, bRunning, PendingCount);
-    WorkerThread.Reset(FRunnableThread::Create(Worker, TEXT("OmniCaptureRingBuffer")));
+    for (int32 WorkerIndex = 0; WorkerIndex < WorkerCount; ++WorkerIndex)
+    {
+        FOmniCaptureRingBufferWorker* Worker = new FOmniCaptureRingBufferWorker(*this);
+        Workers.Add(Worker);
+        WorkerThreads.Emplace(FRunnableThread::Create(Worker, *FString::Printf(TEXT("OmniCaptureRingBuffer%d"), WorkerIndex)));
+    }
 }
 
-void FOmniCaptureRingBuffer::StopWorker()
+void FOmniCaptureRingBuffer::StopWorkers()
 {
-    if (!WorkerThread.IsValid())
+    if (WorkerThreads.Num() == 0)
     {
         return;
     }
 
     bRunning = false;
 
-    if (DataEvent)
+    for (FOmniCaptureRingBufferWorker* Worker : Workers)
     {
-        DataEvent->Trigger();
+        Worker->WakeForShutdown();
     }
 
-    WorkerThread->WaitForCompletion();
-    WorkerThread.Reset();
+    for (TUniquePtr<FRunnableThread>& WorkerThread : WorkerThreads)
+    {
+        if (WorkerThread.IsValid())
+        {
+            WorkerThread->WaitForCompletion();
+        }
+    }
+    WorkerThreads.Reset();
 
-    delete Worker;
-    Worker = nullptr;
+    for (FOmniCaptureRingBufferWorker* Worker : Workers)
+    {
+        delete Worker;
+    }
+    Workers.Reset();
 }
 
 FOmniCaptureRingBufferStats FOmniCaptureRingBuffer::GetStats() const
 {
     FOmniCaptureRingBufferStats Stats;
-    Stats.PendingFrames = PendingCount.Load();
+    Stats.PendingFrames = Queue.IsValid() ? Queue->Num() : 0;
     Stats.DroppedFrames = DroppedCount.Load();
     Stats.BlockedPushes = BlockedCount.Load();
+    Stats.TotalBlockedMilliseconds = TotalBlockedMicroseconds.Load() / 1000.0;
+    Stats.MaxBlockedMilliseconds = MaxBlockedMicroseconds.Load() / 1000.0;
+    Stats.DegradedFrames = DegradedCount.Load();
+    Stats.QueuedBytes = QueuedBytes.Load() + InFlightBytes.Load();
+    Stats.PeakQueuedBytes = PeakQueuedBytes.Load();
     return Stats;
 }
-
@@ -5,6 +5,7 @@
 #include "OmniCaptureEquirectConverter.h"
 #include "OmniCaptureNVENCEncoder.h"
 #include "OmniCaptureImageWriter.h"
+#include "OmniCapturePixelBufferPool.h"
 #include "OmniCaptureRigActor.h"
 #include "OmniCaptureRingBuffer.h"
 #include "OmniCapturePreviewActor.h"
@@ -404,9 +405,22 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
         OutputMuxer->BeginRealtimeSession(ActiveSettings);
     }
 
+    FOmniCapturePixelBufferPool::Get().Configure(ActiveSettings.PixelPoolMaxBuffersPerSize, static_cast<int64>(ActiveSettings.PixelPoolMaxMB) * 1024 * 1024);
+
     RingBuffer = MakeUnique<FOmniCaptureRingBuffer>();
-    RingBuffer->Initialize(ActiveSettings, [this](TUniquePtr<FOmniCaptureFrame>&& Frame)
+    RingBuffer->Initialize(ActiveSettings, [this](FOmniCaptureFrame& Frame)
+    {
+        // Runs on any ring buffer worker. Image writes do not depend on each other, so a slow
+        // frame here no longer holds up the frames behind it.
+        if (ActiveSettings.OutputFormat == EOmniOutputFormat::ImageSequence && ImageWriter)
+        {
+            const FString FileName = BuildFrameFileName(Frame.Metadata.FrameIndex, ActiveSettings.GetImageFileExtension());
+            Frame.bSubmittedToImageWriter = ImageWriter->SubmitFrame(Frame, FileName);
+        }
+    },
+    [this](TUniquePtr<FOmniCaptureFrame>&& Frame)
     {
+        // Committed one frame at a time in frame order.
         if (!Frame.IsValid())
         {
             return;
@@ -425,10 +439,10 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
         switch (ActiveSettings.OutputFormat)
         {
         case EOmniOutputFormat::ImageSequence:
-            if (ImageWriter)
+            // Rejected frames wrote nothing, so they get no manifest entry for the muxer to expect.
+            if (ImageWriter && Frame->bSubmittedToImageWriter)
             {
-                const FString FileName = BuildFrameFileName(Frame->Metadata.FrameIndex, ActiveSettings.GetImageFileExtension());
-                ImageWriter->EnqueueFrame(MoveTemp(Frame), FileName);
+                ImageWriter->RecordFrame(Frame->Metadata);
             }
             break;
         case EOmniOutputFormat::NVENCHardware:
@@ -446,14 +460,10 @@ void UOmniCaptureSubsystem::BeginCapture(const FOmniCaptureSettings& InSettings)
             break;
         }
 
-        if (RingBuffer.IsValid())
+        // Buffers no writer took ownership of go straight back to the pool.
+        if (Frame.IsValid())
         {
-            LatestRingBufferStats = RingBuffer->GetStats();
-            if (LatestRingBufferStats.DroppedFrames > DroppedFrameCount)
-            {
-                DroppedFrameCount = LatestRingBufferStats.DroppedFrames;
-                HandleDroppedFrame();
-            }
+            FOmniCapturePixelBufferPool::Get().ReleaseFrame(*Frame);
         }
     });
 
@@ -531,7 +541,10 @@ void UOmniCaptureSubsystem::EndCapture(bool bFinalize)
         RingBuffer.Reset();
     }
 
+    FOmniCaptureEquirectConverter::ReleaseCachedResources();
+
     ShutdownOutputWriters(bFinalize);
+    FOmniCapturePixelBufferPool::Get().Trim();
     if (OutputMuxer)
     {
         OutputMuxer->EndRealtimeSession();
@@ -634,6 +647,13 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
 
     FOmniCaptureSettings StillSettings = InSettings;
     StillSettings.OutputFormat = EOmniOutputFormat::ImageSequence;
+    if (StillSettings.ImageFormat == EOmniCaptureImageFormat::OmniRaw)
+    {
+        // A container holding one frame only postpones the encode; stills go straight to EXR.
+        StillSettings.ImageFormat = EOmniCaptureImageFormat::EXR;
+    }
+    // A still is a single image the user expects to open directly.
+    StillSettings.PackedSequenceFramesPerFile = 0;
 
     {
         TArray<FString> CompatibilityWarnings;
@@ -670,7 +690,7 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
 
     FlushRenderingCommands();
 
-    auto ConvertFrame = [](const FOmniCaptureSettings& CaptureSettings, const FOmniEyeCapture& Left, const FOmniEyeCapture& Right)
+    auto ConvertFrame = [](const FOmniCaptureSettings& CaptureSettings, const FOmniEyeCapture& Left, const FOmniEyeCapture& Right, bool bStreamRows)
     {
         if (CaptureSettings.IsPlanar())
         {
@@ -679,13 +699,13 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
 
         if (CaptureSettings.IsFisheye() && !CaptureSettings.ShouldConvertFisheyeToEquirect())
         {
-            return FOmniCaptureEquirectConverter::ConvertToFisheye(CaptureSettings, Left, Right);
+            return FOmniCaptureEquirectConverter::ConvertToFisheye(CaptureSettings, Left, Right, false, bStreamRows);
         }
 
-        return FOmniCaptureEquirectConverter::ConvertToEquirectangular(CaptureSettings, Left, Right);
+        return FOmniCaptureEquirectConverter::ConvertToEquirectangular(CaptureSettings, Left, Right, false, bStreamRows);
     };
 
-    FOmniCaptureEquirectResult Result = ConvertFrame(StillSettings, LeftEye, RightEye);
+    FOmniCaptureEquirectResult Result = ConvertFrame(StillSettings, LeftEye, RightEye, StillSettings.ShouldStreamCPUReprojection());
 
     TMap<FName, FOmniCaptureLayerPayload> AuxiliaryLayers;
     if (StillSettings.AuxiliaryPasses.Num() > 0)
@@ -694,6 +714,7 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
         {
             FOmniEyeCapture AuxEye;
             AuxEye.ActiveFaceCount = SourceEye.ActiveFaceCount;
+            AuxEye.Coverage = SourceEye.Coverage;
             for (int32 FaceIndex = 0; FaceIndex < AuxEye.ActiveFaceCount && FaceIndex < UE_ARRAY_COUNT(AuxEye.Faces); ++FaceIndex)
             {
                 AuxEye.Faces[FaceIndex].RenderTarget = SourceEye.Faces[FaceIndex].GetAuxiliaryRenderTarget(PassType);
@@ -710,7 +731,7 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
 
             const FOmniEyeCapture AuxLeft = BuildAuxEye(LeftEye, PassType);
             const FOmniEyeCapture AuxRight = BuildAuxEye(RightEye, PassType);
-            FOmniCaptureEquirectResult AuxResult = ConvertFrame(StillSettings, AuxLeft, AuxRight);
+            FOmniCaptureEquirectResult AuxResult = ConvertFrame(StillSettings, AuxLeft, AuxRight, false);
             if (AuxResult.PixelData.IsValid())
             {
                 FOmniCaptureLayerPayload Payload;
@@ -725,7 +746,7 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
 
     World->DestroyActor(TempRig);
 
-    if (!Result.PixelData.IsValid())
+    if (!Result.PixelData.IsValid() && !Result.RowSource.IsValid())
     {
         LogDiagnosticMessage(ELogVerbosity::Warning, TEXT("StillCapture"), TEXT("Still capture did not generate pixel data. Check cubemap rig configuration."));
         return false;
@@ -756,6 +777,7 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
     Frame->Metadata.Timecode = 0.0;
     Frame->Metadata.bKeyFrame = true;
     Frame->PixelData = MoveTemp(Result.PixelData);
+    Frame->RowSource = MoveTemp(Result.RowSource);
     Frame->bLinearColor = Result.bIsLinear;
     Frame->bUsedCPUFallback = Result.bUsedCPUFallback;
     Frame->PixelDataType = Result.PixelDataType;
@@ -764,6 +786,12 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
     Writer.EnqueueFrame(MoveTemp(Frame), FileName);
     Writer.Flush();
 
+    // A one-off still should not leave its canvas pooled between captures.
+    if (!bIsCapturing)
+    {
+        FOmniCapturePixelBufferPool::Get().Trim();
+    }
+
     LastStillImagePath = OutFilePath;
     LastFinalizedOutput = OutFilePath;
 
@@ -772,6 +800,11 @@ bool UOmniCaptureSubsystem::CapturePanoramaStill(const FOmniCaptureSettings& InS
     return true;
 }
 
+FOmniCapturePixelPoolStats UOmniCaptureSubsystem::GetPixelPoolStats() const
+{
+    return FOmniCapturePixelBufferPool::Get().GetStats();
+}
+
 bool UOmniCaptureSubsystem::CanPause() const
 {
     return bIsCapturing && !bIsPaused;
@@ -830,7 +863,7 @@ FString UOmniCaptureSubsystem::GetStatusString() const
         break;
     }
 
-    Status += FString::Printf(TEXT(" | Frames:%d Pending:%d Dropped:%d Blocked:%d"), FrameCounter, LatestRingBufferStats.PendingFrames, LatestRingBufferStats.DroppedFrames, LatestRingBufferStats.BlockedPushes);
+    Status += FString::Printf(TEXT(" | Frames:%d Pending:%d Dropped:%d Blocked:%d (%.1f ms max) Queued:%.1f MB"), FrameCounter, LatestRingBufferStats.PendingFrames, LatestRingBufferStats.DroppedFrames, LatestRingBufferStats.BlockedPushes, LatestRingBufferStats.MaxBlockedMilliseconds, LatestRingBufferStats.QueuedBytes / (1024.0 * 1024.0));
     Status += FString::Printf(TEXT(" | FPS:%.2f"), CurrentCaptureFPS);
     Status += FString::Printf(TEXT(" | Segment:%d"), CurrentSegmentIndex);
 
@@ -1538,22 +1571,27 @@ void UOmniCaptureSubsystem::CaptureFrame()
 
     FlushRenderingCommands();
 
-    auto ConvertActiveFrame = [](const FOmniCaptureSettings& CaptureSettings, const FOmniEyeCapture& Left, const FOmniEyeCapture& Right)
+    auto ConvertActiveFrame = [](const FOmniCaptureSettings& CaptureSettings, const FOmniEyeCapture& Left, const FOmniEyeCapture& Right, bool bGeneratePreview, bool bStreamRows)
     {
         if (CaptureSettings.IsPlanar())
         {
-            return FOmniCaptureEquirectConverter::ConvertToPlanar(CaptureSettings, Left);
+            return FOmniCaptureEquirectConverter::ConvertToPlanar(CaptureSettings, Left, bGeneratePreview);
         }
 
         if (CaptureSettings.IsFisheye() && !CaptureSettings.ShouldConvertFisheyeToEquirect())
         {
-            return FOmniCaptureEquirectConverter::ConvertToFisheye(CaptureSettings, Left, Right);
+            return FOmniCaptureEquirectConverter::ConvertToFisheye(CaptureSettings, Left, Right, bGeneratePreview, bStreamRows);
         }
 
-        return FOmniCaptureEquirectConverter::ConvertToEquirectangular(CaptureSettings, Left, Right);
+        return FOmniCaptureEquirectConverter::ConvertToEquirectangular(CaptureSettings, Left, Right, bGeneratePreview, bStreamRows);
     };
 
-    FOmniCaptureEquirectResult ConversionResult = ConvertActiveFrame(ActiveSettings, LeftEye, RightEye);
+    // Only pay for the preview image on frames where the preview actually refreshes.
+    const double PreviewRequestTime = FPlatformTime::Seconds();
+    const bool bUpdatePreview = PreviewActor.IsValid()
+        && (PreviewFrameInterval <= 0.0 || (PreviewRequestTime - LastPreviewUpdateTime) >= PreviewFrameInterval);
+
+    FOmniCaptureEquirectResult ConversionResult = ConvertActiveFrame(ActiveSettings, LeftEye, RightEye, bUpdatePreview, ActiveSettings.ShouldStreamCPUReprojection());
 
     TMap<FName, FOmniCaptureLayerPayload> AuxiliaryLayers;
     if (ActiveSettings.AuxiliaryPasses.Num() > 0)
@@ -1562,6 +1600,7 @@ void UOmniCaptureSubsystem::CaptureFrame()
         {
             FOmniEyeCapture AuxEye;
             AuxEye.ActiveFaceCount = SourceEye.ActiveFaceCount;
+            AuxEye.Coverage = SourceEye.Coverage;
             for (int32 FaceIndex = 0; FaceIndex < AuxEye.ActiveFaceCount && FaceIndex < UE_ARRAY_COUNT(AuxEye.Faces); ++FaceIndex)
             {
                 AuxEye.Faces[FaceIndex].RenderTarget = SourceEye.Faces[FaceIndex].GetAuxiliaryRenderTarget(PassType);
@@ -1578,7 +1617,7 @@ void UOmniCaptureSubsystem::CaptureFrame()
 
             const FOmniEyeCapture AuxLeft = BuildAuxiliaryEye(LeftEye, PassType);
             const FOmniEyeCapture AuxRight = BuildAuxiliaryEye(RightEye, PassType);
-            FOmniCaptureEquirectResult AuxResult = ConvertActiveFrame(ActiveSettings, AuxLeft, AuxRight);
+            FOmniCaptureEquirectResult AuxResult = ConvertActiveFrame(ActiveSettings, AuxLeft, AuxRight, false, false);
             if (AuxResult.PixelData.IsValid())
             {
                 FOmniCaptureLayerPayload Payload;
@@ -1591,7 +1630,7 @@ void UOmniCaptureSubsystem::CaptureFrame()
         }
     }
     const bool bRequiresGPU = ActiveSettings.OutputFormat == EOmniOutputFormat::NVENCHardware;
-    if (!ConversionResult.PixelData.IsValid())
+    if (!ConversionResult.PixelData.IsValid() && !ConversionResult.RowSource.IsValid())
     {
         HandleDroppedFrame();
         return;
@@ -1624,6 +1663,7 @@ void UOmniCaptureSubsystem::CaptureFrame()
     }
 
     Frame->PixelData = MoveTemp(ConversionResult.PixelData);
+    Frame->RowSource = MoveTemp(ConversionResult.RowSource);
     Frame->GPUSource = ConversionResult.OutputTarget;
     Frame->Texture = ConversionResult.Texture;
     Frame->ReadyFence = ConversionResult.ReadyFence;
@@ -1666,17 +1706,20 @@ void UOmniCaptureSubsystem::CaptureFrame()
 
     if (RingBuffer)
     {
+        // Commits run on the ring buffer workers, so stats and drops are picked up here on the
+        // game thread. Every policy drops frames inside Enqueue, so none are missed.
         LatestRingBufferStats = RingBuffer->GetStats();
+        if (LatestRingBufferStats.DroppedFrames > DroppedFrameCount)
+        {
+            DroppedFrameCount = LatestRingBufferStats.DroppedFrames;
+            HandleDroppedFrame();
+        }
     }
 
-    if (PreviewActor.IsValid())
+    if (bUpdatePreview && PreviewActor.IsValid())
     {
-        const double Now = FPlatformTime::Seconds();
-        if (PreviewFrameInterval <= 0.0 || (Now - LastPreviewUpdateTime) >= PreviewFrameInterval)
-        {
-            PreviewActor->UpdatePreviewTexture(ConversionResult, ActiveSettings);
-            LastPreviewUpdateTime = Now;
-        }
+        PreviewActor->UpdatePreviewTexture(ConversionResult, ActiveSettings);
+        LastPreviewUpdateTime = PreviewRequestTime;
     }
 }
 
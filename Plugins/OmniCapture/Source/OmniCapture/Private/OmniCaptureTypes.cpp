@@ -183,6 +183,36 @@ FIntPoint FOmniCaptureSettings::GetPerEyeOutputResolution() const
     return FIntPoint(Output.X, FMath::Max(1, Output.Y / 2));
 }
 
+FIntPoint FOmniCaptureSettings::GetPreviewResolution(const FIntPoint& OutputSize) const
+{
+    const int32 MaxDimension = FMath::Max(16, FMath::RoundToInt(PreviewMaxDimension * FMath::Max(0.1f, PreviewScreenScale)));
+    const int32 LongestEdge = FMath::Max(OutputSize.X, OutputSize.Y);
+    if (LongestEdge <= MaxDimension)
+    {
+        return OutputSize;
+    }
+
+    const double Scale = static_cast<double>(MaxDimension) / LongestEdge;
+    FIntPoint Preview(
+        FMath::Max(1, FMath::FloorToInt(OutputSize.X * Scale)),
+        FMath::Max(1, FMath::FloorToInt(OutputSize.Y * Scale)));
+
+    // Keep both stereo halves the same size so a single eye can be cropped out.
+    if (IsStereo())
+    {
+        if (StereoLayout == EOmniCaptureStereoLayout::SideBySide)
+        {
+            Preview.X = FMath::Max(2, Preview.X & ~1);
+        }
+        else
+        {
+            Preview.Y = FMath::Max(2, Preview.Y & ~1);
+        }
+    }
+
+    return Preview;
+}
+
 FName GetAuxiliaryLayerName(EOmniCaptureAuxiliaryPassType PassType)
 {
     if (PassType == EOmniCaptureAuxiliaryPassType::None)
@@ -262,6 +292,11 @@ bool FOmniCaptureSettings::ShouldConvertFisheyeToEquirect() const
     return bFisheyeConvertToEquirect && IsFisheye();
 }
 
+bool FOmniCaptureSettings::ShouldStreamCPUReprojection() const
+{
+    return bStreamCPUReprojection && OutputFormat == EOmniOutputFormat::ImageSequence && !IsPlanar();
+}
+
 FString FOmniCaptureSettings::GetStereoModeMetadataTag() const
 {
     if (!IsStereo())
@@ -392,8 +427,46 @@ FString FOmniCaptureSettings::GetImageFileExtension() const
         return TEXT(".exr");
     case EOmniCaptureImageFormat::BMP:
         return TEXT(".bmp");
+    case EOmniCaptureImageFormat::QOI:
+        return TEXT(".qoi");
+    case EOmniCaptureImageFormat::OmniRaw:
+        return TEXT(".omniraw");
     case EOmniCaptureImageFormat::PNG:
     default:
         return TEXT(".png");
     }
 }
+
+int64 FOmniCaptureFrame::GetAllocatedSize() const
+{
+    const auto GetPixelBytes = [](const TUniquePtr<FImagePixelData>& Data) -> int64
+    {
+        if (!Data.IsValid())
+        {
+            return 0;
+        }
+
+        const void* RawData = nullptr;
+        int64 RawSize = 0;
+        Data->GetRawData(RawData, RawSize);
+        return RawSize;
+    };
+
+    int64 Bytes = GetPixelBytes(PixelData);
+    if (RowSource.IsValid())
+    {
+        Bytes += RowSource->GetAllocatedSize();
+    }
+
+    for (const TPair<FName, FOmniCaptureLayerPayload>& Layer : AuxiliaryLayers)
+    {
+        Bytes += GetPixelBytes(Layer.Value.PixelData);
+    }
+
+    for (const FOmniAudioPacket& Packet : AudioPackets)
+    {
+        Bytes += Packet.PCM16.GetAllocatedSize();
+    }
+
+    return Bytes;
+}
@@ -0,0 +1,163 @@
+#include "OmniCaptureWorkerPool.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformAffinity.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+class FOmniCaptureWorkerPool::FWorker final : public FRunnable
+{
+public:
+    explicit FWorker(FOmniCaptureWorkerPool& InOwner)
+        : Owner(InOwner)
+    {
+    }
+
+    virtual uint32 Run() override
+    {
+        for (;;)
+        {
+            TUniqueFunction<void()> Task;
+            if (Owner.TryTakeTask(Task))
+            {
+                Task();
+                Owner.FinishTask();
+                continue;
+            }
+
+            if (Owner.bStopping.load())
+            {
+                // Pass the shutdown signal on to the next sleeping worker.
+                Owner.WorkAvailableEvent->Trigger();
+                break;
+            }
+
+            Owner.WorkAvailableEvent->Wait();
+        }
+
+        return 0;
+    }
+
+private:
+    FOmniCaptureWorkerPool& Owner;
+};
+
+FOmniCaptureWorkerPool::FOmniCaptureWorkerPool(const FString& InName, int32 WorkerCount, EThreadPriority Priority, uint64 AffinityMask)
+{
+    WorkAvailableEvent = FPlatformProcess::GetSynchEventFromPool();
+    TaskFinishedEvent = FPlatformProcess::GetSynchEventFromPool();
+
+    const uint64 ThreadAffinity = AffinityMask != 0 ? AffinityMask : FPlatformAffinity::GetNoAffinityMask();
+    for (int32 WorkerIndex = 0; WorkerIndex < FMath::Max(1, WorkerCount); ++WorkerIndex)
+    {
+        FWorker* Worker = new FWorker(*this);
+        Workers.Add(Worker);
+        WorkerThreads.Emplace(FRunnableThread::Create(Worker, *FString::Printf(TEXT("%s%d"), *InName, WorkerIndex), 0, Priority, ThreadAffinity));
+    }
+}
+
+FOmniCaptureWorkerPool::~FOmniCaptureWorkerPool()
+{
+    WaitUntilIdle();
+
+    bStopping.store(true);
+    WorkAvailableEvent->Trigger();
+
+    for (TUniquePtr<FRunnableThread>& WorkerThread : WorkerThreads)
+    {
+        if (WorkerThread.IsValid())
+        {
+            WorkerThread->WaitForCompletion();
+        }
+    }
+    WorkerThreads.Reset();
+
+    for (FWorker* Worker : Workers)
+    {
+        delete Worker;
+    }
+    Workers.Reset();
+
+    FPlatformProcess::ReturnSynchEventToPool(WorkAvailableEvent);
+    FPlatformProcess::ReturnSynchEventToPool(TaskFinishedEvent);
+}
+
+void FOmniCaptureWorkerPool::Enqueue(TUniqueFunction<void()>&& Task)
+{
+    OutstandingTasks.Increment();
+    {
+        FScopeLock Lock(&QueueCS);
+        PendingTasks.Add(MoveTemp(Task));
+    }
+    WorkAvailableEvent->Trigger();
+}
+
+TFuture<bool> FOmniCaptureWorkerPool::Submit(TUniqueFunction<bool()>&& Task)
+{
+    TSharedRef<TPromise<bool>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<bool>, ESPMode::ThreadSafe>();
+    TFuture<bool> Future = Promise->GetFuture();
+    Enqueue([Promise, Task = MoveTemp(Task)]() mutable
+    {
+        Promise->SetValue(Task());
+    });
+    return Future;
+}
+
+bool FOmniCaptureWorkerPool::TryTakeTask(TUniqueFunction<void()>& OutTask)
+{
+    bool bMoreQueued = false;
+    {
+        FScopeLock Lock(&QueueCS);
+        if (PendingHead >= PendingTasks.Num())
+        {
+            return false;
+        }
+
+        OutTask = MoveTemp(PendingTasks[PendingHead++]);
+        if (PendingHead >= PendingTasks.Num())
+        {
+            PendingTasks.Reset();
+            PendingHead = 0;
+        }
+        else
+        {
+            bMoreQueued = true;
+        }
+    }
+
+    // Enqueue signals coalesce, so hand the rest of the backlog to another worker.
+    if (bMoreQueued)
+    {
+        WorkAvailableEvent->Trigger();
+    }
+    return true;
+}
+
+void FOmniCaptureWorkerPool::FinishTask()
+{
+    OutstandingTasks.Decrement();
+    TaskFinishedEvent->Trigger();
+}
+
+void FOmniCaptureWorkerPool::WaitForBacklogAtMost(int32 MaxOutstanding)
+{
+    BacklogWaiters.fetch_add(1);
+    while (OutstandingTasks.GetValue() > FMath::Max(0, MaxOutstanding))
+    {
+        TaskFinishedEvent->Wait();
+    }
+
+    // Each finished task wakes one waiter and signals that land together coalesce, so pass the
+    // wake-up on to the next waiter, which re-checks its own limit.
+    if (BacklogWaiters.fetch_sub(1) > 1)
+    {
+        TaskFinishedEvent->Trigger();
+    }
+}
+
+void FOmniCaptureWorkerPool::WaitUntilIdle()
+{
+    WaitForBacklogAtMost(0);
+}
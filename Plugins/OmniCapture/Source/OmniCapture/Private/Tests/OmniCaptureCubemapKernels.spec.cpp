@@ -0,0 +1,117 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureCubemapKernels.h"
+
+#include "Math/RandomStream.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureCubemapKernelsMatchScalarTest, "OmniCapture.Converter.CubemapKernelsMatchScalar", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureCubemapKernelsMatchScalarTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 DirectionCount = 4099; // Not a multiple of the vector width so the scalar tail runs too.
+    const int32 FaceResolutions[] = { 1024, 2048, 4097 };
+    const float SeamStrengths[] = { 0.0f, 0.25f, 1.0f };
+
+    FRandomStream Random(0x0C0FFEE);
+
+    TArray<float> DirX;
+    TArray<float> DirY;
+    TArray<float> DirZ;
+    DirX.SetNumUninitialized(DirectionCount);
+    DirY.SetNumUninitialized(DirectionCount);
+    DirZ.SetNumUninitialized(DirectionCount);
+
+    for (int32 Index = 0; Index < DirectionCount; ++Index)
+    {
+        const FVector Direction = Random.GetUnitVector();
+        DirX[Index] = static_cast<float>(Direction.X);
+        DirY[Index] = static_cast<float>(Direction.Y);
+        DirZ[Index] = static_cast<float>(Direction.Z);
+    }
+
+    // Exact axis directions exercise the major-axis tie-breaking.
+    const FVector3f AxisDirections[] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }, { 1, 1, 0 }, { 0, -1, -1 }, { -1, 1, 1 } };
+    for (int32 Index = 0; Index < UE_ARRAY_COUNT(AxisDirections); ++Index)
+    {
+        DirX[Index] = AxisDirections[Index].X;
+        DirY[Index] = AxisDirections[Index].Y;
+        DirZ[Index] = AxisDirections[Index].Z;
+    }
+
+    TArray<uint32> VectorSamples;
+    VectorSamples.SetNumUninitialized(DirectionCount);
+
+    for (const int32 FaceResolution : FaceResolutions)
+    {
+        for (const float SeamStrength : SeamStrengths)
+        {
+            FOmniCaptureCubemapKernels::LookupTexels(DirX.GetData(), DirY.GetData(), DirZ.GetData(), DirectionCount, FaceResolution, SeamStrength, VectorSamples.GetData());
+
+            int32 Mismatches = 0;
+            for (int32 Index = 0; Index < DirectionCount; ++Index)
+            {
+                const uint32 Reference = FOmniCaptureCubemapKernels::LookupTexelScalar(DirX[Index], DirY[Index], DirZ[Index], FaceResolution, SeamStrength);
+                if (Reference != VectorSamples[Index])
+                {
+                    ++Mismatches;
+                }
+            }
+
+            TestEqual(FString::Printf(TEXT("Vector lookup matches scalar reference (face %d, seam %.2f)"), FaceResolution, SeamStrength), Mismatches, 0);
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureCubemapKernelsFaceSelectionTest, "OmniCapture.Converter.CubemapKernelsFaceSelection", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureCubemapKernelsFaceSelectionTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 FaceResolution = 1024;
+
+    const uint32 PosX = FOmniCaptureCubemapKernels::LookupTexelScalar(1.0f, 0.0f, 0.0f, FaceResolution, 0.0f);
+    const uint32 NegY = FOmniCaptureCubemapKernels::LookupTexelScalar(0.1f, -1.0f, 0.2f, FaceResolution, 0.0f);
+    const uint32 NegZ = FOmniCaptureCubemapKernels::LookupTexelScalar(0.3f, 0.2f, -1.0f, FaceResolution, 0.0f);
+
+    TestEqual(TEXT("+X direction selects face 0"), FOmniCaptureCubemapKernels::GetFaceIndex(PosX), 0u);
+    TestEqual(TEXT("-Y direction selects face 3"), FOmniCaptureCubemapKernels::GetFaceIndex(NegY), 3u);
+    TestEqual(TEXT("-Z direction selects face 5"), FOmniCaptureCubemapKernels::GetFaceIndex(NegZ), 5u);
+
+    const uint32 CentreTexel = (FaceResolution / 2 - 1) * FaceResolution + (FaceResolution / 2 - 1);
+    TestEqual(TEXT("Face centre maps to the centre texel"), FOmniCaptureCubemapKernels::GetTexelIndex(PosX), CentreTexel);
+
+    TestTrue(TEXT("16K faces fit in a packed sample"), FOmniCaptureCubemapKernels::SupportsFaceResolution(16384));
+    TestFalse(TEXT("Oversized faces are rejected"), FOmniCaptureCubemapKernels::SupportsFaceResolution(32768));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureCubemapKernelsProjectionTest, "OmniCapture.Converter.CubemapKernelsProjectionMatchesLookup", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureCubemapKernelsProjectionTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 DirectionCount = 1024;
+    constexpr int32 FaceResolution = 2048;
+    constexpr float SeamStrength = 0.25f;
+
+    FRandomStream Random(0x0C0FFEE);
+
+    int32 Mismatches = 0;
+    for (int32 Index = 0; Index < DirectionCount; ++Index)
+    {
+        const FVector3f Direction(Random.GetUnitVector());
+
+        float U = 0.0f;
+        float V = 0.0f;
+        const uint32 FaceIndex = FOmniCaptureCubemapKernels::ProjectToFaceScalar(Direction.X, Direction.Y, Direction.Z, FaceResolution, SeamStrength, U, V);
+        const uint32 TexelX = static_cast<uint32>(U * (FaceResolution - 1));
+        const uint32 TexelY = static_cast<uint32>(V * (FaceResolution - 1));
+
+        const uint32 Projected = FOmniCaptureCubemapKernels::PackSample(FaceIndex, TexelY * FaceResolution + TexelX);
+        if (Projected != FOmniCaptureCubemapKernels::LookupTexelScalar(Direction.X, Direction.Y, Direction.Z, FaceResolution, SeamStrength))
+        {
+            ++Mismatches;
+        }
+    }
+
+    TestEqual(TEXT("Fractional projection lands in the texel the lookup picks"), Mismatches, 0);
+    return true;
+}
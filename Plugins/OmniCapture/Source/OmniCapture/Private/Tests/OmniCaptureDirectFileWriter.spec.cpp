@@ -0,0 +1,76 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureDirectFileWriter.h"
+
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    TArray64<uint8> MakeDirectWriteTestData(int64 Size)
+    {
+        FRandomStream Random(0xD1EC7);
+        TArray64<uint8> Data;
+        Data.SetNumUninitialized(Size);
+        for (uint8& Byte : Data)
+        {
+            Byte = static_cast<uint8>(Random.RandHelper(256));
+        }
+        return Data;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureDirectFileWriterTest, "OmniCapture.ImageWriter.DirectFileWriter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureDirectFileWriterTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("OmniCaptureDirectFileWriter"));
+    IFileManager::Get().MakeDirectory(*Directory, true);
+
+    // Two full blocks and an unaligned tail, in the small odd-sized pieces libpng hands over.
+    const TArray64<uint8> Expected = MakeDirectWriteTestData(FOmniCaptureDirectFileWriter::MaxBlockBytes * 2 + 12345);
+
+    // Underestimated, exact and overestimated sizes must all end up the size actually written.
+    for (const int64 EstimatedSize : { 0ll, 1000ll, Expected.Num(), Expected.Num() * 3 })
+    {
+        const FString FilePath = Directory / FString::Printf(TEXT("Streamed_%lld.bin"), EstimatedSize);
+        {
+            FOmniCaptureDirectFileWriter Writer;
+            if (!TestTrue(TEXT("File opens"), Writer.Open(FilePath, EstimatedSize)))
+            {
+                continue;
+            }
+
+            int64 Offset = 0;
+            int64 PieceSize = 1;
+            while (Offset < Expected.Num())
+            {
+                const int64 Bytes = FMath::Min(PieceSize, Expected.Num() - Offset);
+                Writer.Serialize(const_cast<uint8*>(Expected.GetData() + Offset), Bytes);
+                Offset += Bytes;
+                PieceSize = PieceSize * 3 % 65521 + 1;
+            }
+            TestEqual(TEXT("Tell counts every byte"), Writer.Tell(), Expected.Num());
+            TestTrue(TEXT("File closes"), Writer.Close());
+        }
+
+        TArray64<uint8> Actual;
+        TestTrue(TEXT("File reads back"), FFileHelper::LoadFileToArray(Actual, *FilePath));
+        TestEqual(TEXT("Preallocation and padding are trimmed"), Actual.Num(), Expected.Num());
+        TestTrue(TEXT("Contents survive"), Actual == Expected);
+    }
+
+    const FString SmallPath = Directory / TEXT("Small.bin");
+    const TArray64<uint8> Small = MakeDirectWriteTestData(777);
+    TestTrue(TEXT("Whole-file write succeeds"), FOmniCaptureDirectFileWriter::WriteFile(SmallPath, Small));
+    TArray64<uint8> SmallActual;
+    TestTrue(TEXT("Small file survives"), FFileHelper::LoadFileToArray(SmallActual, *SmallPath) && SmallActual == Small);
+
+    const FString BufferedPath = Directory / TEXT("Buffered.bin");
+    TestTrue(TEXT("Buffered whole-file write succeeds"), FOmniCaptureDirectFileWriter::WriteFile(BufferedPath, Small, false));
+    TestEqual(TEXT("Buffered file has the same size"), IFileManager::Get().FileSize(*BufferedPath), Small.Num());
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
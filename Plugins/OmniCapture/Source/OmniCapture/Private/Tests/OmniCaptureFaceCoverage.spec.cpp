@@ -0,0 +1,51 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureEquirectConverter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFaceCoverageFullSphereTest, "OmniCapture.Converter.FaceCoverageFullSphere", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureFaceCoverageFullSphereTest::RunTest(const FString& Parameters)
+{
+    FOmniCaptureSettings Settings;
+    Settings.Projection = EOmniCaptureProjection::Equirectangular;
+    Settings.Coverage = EOmniCaptureCoverage::FullSphere;
+    Settings.Resolution = 1024;
+
+    const FOmniCaptureFaceCoverage Coverage = FOmniCaptureEquirectConverter::ComputeFaceCoverage(Settings);
+    TestEqual(TEXT("Full sphere samples every face"), Coverage.GetUsedFaceCount(), 6);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFaceCoverageHalfSphereTest, "OmniCapture.Converter.FaceCoverageHalfSphere", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureFaceCoverageHalfSphereTest::RunTest(const FString& Parameters)
+{
+    FOmniCaptureSettings Settings;
+    Settings.Projection = EOmniCaptureProjection::Equirectangular;
+    Settings.Coverage = EOmniCaptureCoverage::HalfSphere;
+    Settings.Resolution = 1024;
+
+    const FOmniCaptureFaceCoverage Coverage = FOmniCaptureEquirectConverter::ComputeFaceCoverage(Settings);
+    TestTrue(TEXT("VR180 samples the front face"), Coverage.IsFaceUsed(0));
+    TestFalse(TEXT("VR180 never samples the rear face"), Coverage.IsFaceUsed(1));
+    TestTrue(TEXT("Side faces are only partially read back"), Coverage.FaceRects[2].Area() < Settings.Resolution * Settings.Resolution);
+
+    Settings.bCullUnusedCubeFaces = false;
+    TestEqual(TEXT("Culling can be disabled"), FOmniCaptureEquirectConverter::ComputeFaceCoverage(Settings).GetUsedFaceCount(), 6);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFaceCoverageNarrowFisheyeTest, "OmniCapture.Converter.FaceCoverageNarrowFisheye", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureFaceCoverageNarrowFisheyeTest::RunTest(const FString& Parameters)
+{
+    FOmniCaptureSettings Settings;
+    Settings.Projection = EOmniCaptureProjection::Fisheye;
+    Settings.bFisheyeConvertToEquirect = false;
+    Settings.FisheyeFOV = 60.0f;
+    Settings.Resolution = 1024;
+
+    const FOmniCaptureFaceCoverage Coverage = FOmniCaptureEquirectConverter::ComputeFaceCoverage(Settings);
+    TestEqual(TEXT("A 60 degree fisheye only samples the front face"), Coverage.FaceMask, static_cast<uint8>(1u << 0));
+
+    return true;
+}
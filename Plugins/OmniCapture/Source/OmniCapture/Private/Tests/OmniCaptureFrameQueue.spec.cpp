@@ -0,0 +1,411 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureFrameQueue.h"
+#include "OmniCaptureRingBuffer.h"
+
+#include "Async/Async.h"
+#include "Containers/Queue.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFrameQueueBoundsTest, "OmniCapture.RingBuffer.QueueEnforcesCapacity", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureFrameQueueBoundsTest::RunTest(const FString& Parameters)
+{
+    TOmniCaptureBoundedQueue<int32> Queue(3);
+
+    int32 Value = 0;
+    TestFalse(TEXT("Empty queue has nothing to dequeue"), Queue.TryDequeue(Value));
+
+    // Several laps around a capacity that is not a power of two.
+    int32 NextIn = 0;
+    int32 NextOut = 0;
+    for (int32 Lap = 0; Lap < 5; ++Lap)
+    {
+        while (Queue.TryEnqueue(int32(NextIn)))
+        {
+            ++NextIn;
+        }
+
+        TestEqual(TEXT("Ring stops accepting at capacity"), Queue.Num(), 3);
+
+        int32 Dequeued = 0;
+        TestTrue(TEXT("Full ring dequeues"), Queue.TryDequeue(Dequeued));
+        TestEqual(TEXT("Entries come out in order"), Dequeued, NextOut++);
+    }
+
+    while (Queue.TryDequeue(Value))
+    {
+        TestEqual(TEXT("Remaining entries come out in order"), Value, NextOut++);
+    }
+
+    TestEqual(TEXT("Every entry was dequeued"), NextOut, NextIn);
+    TestTrue(TEXT("Drained queue is empty"), Queue.IsEmpty());
+
+    TOmniCaptureBoundedQueue<TUniquePtr<int32>> OwningQueue(1);
+    TUniquePtr<int32> First = MakeUnique<int32>(1);
+    TUniquePtr<int32> Second = MakeUnique<int32>(2);
+    TestTrue(TEXT("Owning queue accepts an entry"), OwningQueue.TryEnqueue(MoveTemp(First)));
+    TestFalse(TEXT("Owning queue rejects when full"), OwningQueue.TryEnqueue(MoveTemp(Second)));
+    TestTrue(TEXT("A rejected entry is left with the caller"), Second.IsValid());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFrameQueueContentionTest, "OmniCapture.RingBuffer.QueueMultiProducerDeliversEveryEntry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureFrameQueueContentionTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 ProducerCount = 4;
+    constexpr int32 ItemsPerProducer = 20000;
+
+    TOmniCaptureBoundedQueue<int64, true> Queue(64);
+
+    TArray<TFuture<void>> Producers;
+    for (int32 ProducerIndex = 0; ProducerIndex < ProducerCount; ++ProducerIndex)
+    {
+        Producers.Add(Async(EAsyncExecution::Thread, [&Queue, ProducerIndex]()
+        {
+            for (int32 Item = 0; Item < ItemsPerProducer; ++Item)
+            {
+                const int64 Value = static_cast<int64>(ProducerIndex) * ItemsPerProducer + Item;
+                while (!Queue.TryEnqueue(int64(Value)))
+                {
+                    FPlatformProcess::YieldThread();
+                }
+            }
+        }));
+    }
+
+    // Entries from one producer must stay in that producer's order.
+    TArray<int64> LastSeen;
+    LastSeen.Init(-1, ProducerCount);
+    int64 Sum = 0;
+    int32 Received = 0;
+    int32 OrderViolations = 0;
+    while (Received < ProducerCount * ItemsPerProducer)
+    {
+        int64 Value = 0;
+        if (!Queue.TryDequeue(Value))
+        {
+            FPlatformProcess::YieldThread();
+            continue;
+        }
+
+        const int32 ProducerIndex = static_cast<int32>(Value / ItemsPerProducer);
+        if (Value <= LastSeen[ProducerIndex])
+        {
+            ++OrderViolations;
+        }
+        LastSeen[ProducerIndex] = Value;
+        Sum += Value;
+        ++Received;
+    }
+
+    for (TFuture<void>& Producer : Producers)
+    {
+        Producer.Wait();
+    }
+
+    const int64 Total = static_cast<int64>(ProducerCount) * ItemsPerProducer;
+    TestEqual(TEXT("Every entry arrives exactly once"), Sum, Total * (Total - 1) / 2);
+    TestEqual(TEXT("Per-producer order is preserved"), OrderViolations, 0);
+    TestTrue(TEXT("Queue is empty afterwards"), Queue.IsEmpty());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRingBufferOrderedCommitTest, "OmniCapture.RingBuffer.CommitsInFrameOrderWithConcurrentConsumers", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRingBufferOrderedCommitTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 FrameCount = 200;
+
+    FOmniCaptureSettings Settings;
+    Settings.RingBufferCapacity = 8;
+    Settings.RingBufferPolicy = EOmniCaptureRingBufferPolicy::BlockProducer;
+    Settings.RingBufferConsumerCount = 4;
+    Settings.RingBufferBlockTimeoutMs = 10000.0f;
+
+    TAtomic<int32> ProcessedCount(0);
+    TAtomic<int32> ActiveCommits(0);
+    TAtomic<int32> OverlappingCommits(0);
+    TArray<int32> CommittedIndices;
+
+    {
+        FOmniCaptureRingBuffer RingBuffer;
+        RingBuffer.Initialize(Settings,
+            [&ProcessedCount](FOmniCaptureFrame& Frame)
+            {
+                // Every fourth frame is slow so later frames finish processing first.
+                if (Frame.Metadata.FrameIndex % 4 == 0)
+                {
+                    FPlatformProcess::Sleep(0.002f);
+                }
+                ProcessedCount.IncrementExchange();
+            },
+            [&](TUniquePtr<FOmniCaptureFrame>&& Frame)
+            {
+                if (ActiveCommits.IncrementExchange() != 0)
+                {
+                    OverlappingCommits.IncrementExchange();
+                }
+                CommittedIndices.Add(Frame->Metadata.FrameIndex);
+                ActiveCommits.DecrementExchange();
+            });
+
+        for (int32 FrameIndex = 0; FrameIndex < FrameCount; ++FrameIndex)
+        {
+            TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
+            Frame->Metadata.FrameIndex = FrameIndex;
+            RingBuffer.Enqueue(MoveTemp(Frame));
+        }
+
+        RingBuffer.Flush();
+    }
+
+    TestEqual(TEXT("Every frame is processed"), ProcessedCount.Load(), FrameCount);
+    TestEqual(TEXT("Every frame is committed"), CommittedIndices.Num(), FrameCount);
+    TestEqual(TEXT("Commits never overlap"), OverlappingCommits.Load(), 0);
+
+    bool bInOrder = true;
+    for (int32 Index = 0; Index < CommittedIndices.Num(); ++Index)
+    {
+        bInOrder &= CommittedIndices[Index] == Index;
+    }
+    TestTrue(TEXT("Frames are committed in frame order"), bInOrder);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRingBufferBackpressureTest, "OmniCapture.RingBuffer.BlockProducerWaitsThenDrops", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRingBufferBackpressureTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 FrameCount = 6;
+
+    // Consumer takes 20 ms per frame; the producer pushes as fast as it can into a one-slot ring.
+    auto RunCapture = [](float TimeoutMs, int32& OutCommitted)
+    {
+        FOmniCaptureSettings Settings;
+        Settings.RingBufferCapacity = 1;
+        Settings.RingBufferPolicy = EOmniCaptureRingBufferPolicy::BlockProducer;
+        Settings.RingBufferBlockTimeoutMs = TimeoutMs;
+
+        TAtomic<int32> Committed(0);
+        FOmniCaptureRingBufferStats Stats;
+        {
+            FOmniCaptureRingBuffer RingBuffer;
+            RingBuffer.Initialize(Settings,
+                [](FOmniCaptureFrame&)
+                {
+                    FPlatformProcess::Sleep(0.02f);
+                },
+                [&Committed](TUniquePtr<FOmniCaptureFrame>&&)
+                {
+                    Committed.IncrementExchange();
+                });
+
+            for (int32 FrameIndex = 0; FrameIndex < FrameCount; ++FrameIndex)
+            {
+                TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
+                Frame->Metadata.FrameIndex = FrameIndex;
+                RingBuffer.Enqueue(MoveTemp(Frame));
+            }
+
+            Stats = RingBuffer.GetStats();
+        }
+
+        OutCommitted = Committed.Load();
+        return Stats;
+    };
+
+    int32 Committed = 0;
+    const FOmniCaptureRingBufferStats Patient = RunCapture(10000.0f, Committed);
+    TestEqual(TEXT("A long timeout drops nothing"), Patient.DroppedFrames, 0);
+    TestEqual(TEXT("A long timeout commits every frame"), Committed, FrameCount);
+    TestTrue(TEXT("Blocked pushes are counted once per push"), Patient.BlockedPushes > 0 && Patient.BlockedPushes < FrameCount);
+    TestTrue(TEXT("Blocked time is accumulated"), Patient.TotalBlockedMilliseconds > 0.0);
+    TestTrue(TEXT("The longest stall never exceeds the total"), Patient.MaxBlockedMilliseconds <= Patient.TotalBlockedMilliseconds);
+
+    const FOmniCaptureRingBufferStats Impatient = RunCapture(2.0f, Committed);
+    TestTrue(TEXT("A short timeout falls back to dropping"), Impatient.DroppedFrames > 0);
+    TestEqual(TEXT("Dropped and committed frames account for every push"), Impatient.DroppedFrames + Committed, FrameCount);
+    TestTrue(TEXT("A single stall stays near the timeout"), Impatient.MaxBlockedMilliseconds < 15.0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRingBufferByteBudgetTest, "OmniCapture.RingBuffer.MemoryBudgetLimitsQueuedBytes", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRingBufferByteBudgetTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 FrameCount = 5;
+    // 600 KB of pixels per frame against a 1 MB budget: only one frame fits in the ring at a time.
+    const FIntPoint FrameSize(384, 400);
+
+    FOmniCaptureSettings Settings;
+    Settings.RingBufferCapacity = 64;
+    Settings.RingBufferPolicy = EOmniCaptureRingBufferPolicy::DropOldest;
+    Settings.RingBufferMemoryBudgetMB = 1;
+
+    FEvent* Gate = FPlatformProcess::GetSynchEventFromPool(true);
+    TAtomic<int32> Committed(0);
+    FOmniCaptureRingBufferStats Stats;
+    int64 FrameBytes = 0;
+    {
+        FOmniCaptureRingBuffer RingBuffer;
+        RingBuffer.Initialize(Settings,
+            [Gate](FOmniCaptureFrame&)
+            {
+                Gate->Wait();
+            },
+            [&Committed](TUniquePtr<FOmniCaptureFrame>&&)
+            {
+                Committed.IncrementExchange();
+            });
+
+        for (int32 FrameIndex = 0; FrameIndex < FrameCount; ++FrameIndex)
+        {
+            TUniquePtr<TImagePixelData<FColor>> Pixels = MakeUnique<TImagePixelData<FColor>>(FrameSize);
+            Pixels->Pixels.SetNumZeroed(FrameSize.X * FrameSize.Y);
+
+            TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
+            Frame->Metadata.FrameIndex = FrameIndex;
+            Frame->PixelData = MoveTemp(Pixels);
+            FrameBytes = Frame->GetAllocatedSize();
+            RingBuffer.Enqueue(MoveTemp(Frame));
+        }
+
+        Stats = RingBuffer.GetStats();
+        Gate->Trigger();
+    }
+    FPlatformProcess::ReturnSynchEventToPool(Gate);
+
+    TestEqual(TEXT("Frame footprint covers its pixels"), FrameBytes, static_cast<int64>(FrameSize.X) * FrameSize.Y * sizeof(FColor));
+    TestTrue(TEXT("Peak queued bytes stay within the budget"), Stats.PeakQueuedBytes > 0 && Stats.PeakQueuedBytes <= 1024 * 1024);
+    TestTrue(TEXT("Frames over the budget are dropped"), Stats.DroppedFrames >= FrameCount - 2);
+    TestEqual(TEXT("Dropped and committed frames account for every push"), Stats.DroppedFrames + Committed.Load(), FrameCount);
+
+    return true;
+}
+
+namespace
+{
+    struct FQueueLatencyResult
+    {
+        double MeanMicroseconds = 0.0;
+        double P99Microseconds = 0.0;
+        double ItemsPerSecond = 0.0;
+    };
+
+    // Producers stamp each entry with the enqueue time; the consumer records how long
+    // it waited in the queue. Push/Pop wrap the queue under test.
+    template <typename PushFunc, typename PopFunc>
+    FQueueLatencyResult MeasureQueueLatency(int32 ProducerCount, int32 ItemsPerProducer, PushFunc Push, PopFunc Pop)
+    {
+        TArray<uint64> Latencies;
+        Latencies.Reserve(ProducerCount * ItemsPerProducer);
+
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+
+        TArray<TFuture<void>> Producers;
+        for (int32 ProducerIndex = 0; ProducerIndex < ProducerCount; ++ProducerIndex)
+        {
+            Producers.Add(Async(EAsyncExecution::Thread, [&Push, ItemsPerProducer]()
+            {
+                for (int32 Item = 0; Item < ItemsPerProducer; ++Item)
+                {
+                    while (!Push(FPlatformTime::Cycles64()))
+                    {
+                        FPlatformProcess::YieldThread();
+                    }
+                }
+            }));
+        }
+
+        while (Latencies.Num() < ProducerCount * ItemsPerProducer)
+        {
+            uint64 Stamp = 0;
+            if (Pop(Stamp))
+            {
+                Latencies.Add(FPlatformTime::Cycles64() - Stamp);
+            }
+        }
+
+        const uint64 ElapsedCycles = FPlatformTime::Cycles64() - StartCycles;
+        for (TFuture<void>& Producer : Producers)
+        {
+            Producer.Wait();
+        }
+
+        Latencies.Sort();
+        uint64 TotalCycles = 0;
+        for (const uint64 Latency : Latencies)
+        {
+            TotalCycles += Latency;
+        }
+
+        FQueueLatencyResult Result;
+        Result.MeanMicroseconds = FPlatformTime::ToMilliseconds64(TotalCycles / FMath::Max(1, Latencies.Num())) * 1000.0;
+        Result.P99Microseconds = FPlatformTime::ToMilliseconds64(Latencies[FMath::Min(Latencies.Num() - 1, Latencies.Num() * 99 / 100)]) * 1000.0;
+        Result.ItemsPerSecond = Latencies.Num() / FMath::Max(FPlatformTime::ToSeconds64(ElapsedCycles), 1e-9);
+        return Result;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureFrameQueueBenchmark, "OmniCapture.RingBuffer.QueueLatencyBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FOmniCaptureFrameQueueBenchmark::RunTest(const FString& Parameters)
+{
+    constexpr int32 ItemsPerProducer = 200000;
+    constexpr int32 Capacity = 64;
+
+    for (const int32 ProducerCount : { 1, 2, 4 })
+    {
+        // Baseline: the locked TQueue the ring buffer used before.
+        TQueue<uint64, EQueueMode::Mpsc> LockedQueue;
+        FCriticalSection LockedQueueCS;
+        TAtomic<int32> LockedCount(0);
+        const FQueueLatencyResult Locked = MeasureQueueLatency(ProducerCount, ItemsPerProducer / ProducerCount,
+            [&](uint64 Stamp)
+            {
+                FScopeLock Lock(&LockedQueueCS);
+                if (LockedCount.Load() >= Capacity)
+                {
+                    return false;
+                }
+                LockedQueue.Enqueue(Stamp);
+                LockedCount.IncrementExchange();
+                return true;
+            },
+            [&](uint64& OutStamp)
+            {
+                FScopeLock Lock(&LockedQueueCS);
+                if (!LockedQueue.Dequeue(OutStamp))
+                {
+                    return false;
+                }
+                LockedCount.DecrementExchange();
+                return true;
+            });
+
+        TOmniCaptureBoundedQueue<uint64, true> Ring(Capacity);
+        const FQueueLatencyResult LockFree = MeasureQueueLatency(ProducerCount, ItemsPerProducer / ProducerCount,
+            [&](uint64 Stamp) { return Ring.TryEnqueue(MoveTemp(Stamp)); },
+            [&](uint64& OutStamp) { return Ring.TryDequeue(OutStamp); });
+
+        AddInfo(FString::Printf(TEXT("%d producer(s): locked TQueue mean %.2f us, p99 %.2f us, %.2f M items/s | lock-free ring mean %.2f us, p99 %.2f us, %.2f M items/s"),
+            ProducerCount,
+            Locked.MeanMicroseconds, Locked.P99Microseconds, Locked.ItemsPerSecond / 1.0e6,
+            LockFree.MeanMicroseconds, LockFree.P99Microseconds, LockFree.ItemsPerSecond / 1.0e6));
+
+        if (ProducerCount == 1)
+        {
+            TOmniCaptureBoundedQueue<uint64> SingleProducerRing(Capacity);
+            const FQueueLatencyResult Single = MeasureQueueLatency(1, ItemsPerProducer,
+                [&](uint64 Stamp) { return SingleProducerRing.TryEnqueue(MoveTemp(Stamp)); },
+                [&](uint64& OutStamp) { return SingleProducerRing.TryDequeue(OutStamp); });
+
+            AddInfo(FString::Printf(TEXT("1 producer: single-producer ring mean %.2f us, p99 %.2f us, %.2f M items/s"),
+                Single.MeanMicroseconds, Single.P99Microseconds, Single.ItemsPerSecond / 1.0e6));
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,157 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureImageWriter.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+    const EOmniCapturePNGCompression PNGCompressionPresets[] =
+    {
+        EOmniCapturePNGCompression::StoreOnly,
+        EOmniCapturePNGCompression::Fast,
+        EOmniCapturePNGCompression::Default,
+        EOmniCapturePNGCompression::Max
+    };
+
+    // Reference frame: a smooth sky-like gradient over a band of fine noise, roughly what a
+    // rendered panorama gives the filters and deflate to work with.
+    TUniquePtr<TImagePixelData<FColor>> MakeReferenceFrame(const FIntPoint& Size)
+    {
+        FRandomStream Random(0x0FF1CE);
+        TUniquePtr<TImagePixelData<FColor>> PixelData = MakeUnique<TImagePixelData<FColor>>(Size);
+        PixelData->Pixels.SetNumUninitialized(static_cast<int64>(Size.X) * Size.Y);
+
+        for (int32 Y = 0; Y < Size.Y; ++Y)
+        {
+            const float V = static_cast<float>(Y) / FMath::Max(1, Size.Y - 1);
+            for (int32 X = 0; X < Size.X; ++X)
+            {
+                const float U = static_cast<float>(X) / FMath::Max(1, Size.X - 1);
+                const int32 Noise = V > 0.6f ? Random.RandRange(-24, 24) : 0;
+                PixelData->Pixels[static_cast<int64>(Y) * Size.X + X] = FColor(
+                    static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(60.0f + 120.0f * V) + Noise, 0, 255)),
+                    static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(110.0f + 80.0f * V + 30.0f * U) + Noise, 0, 255)),
+                    static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(230.0f - 150.0f * V) + Noise, 0, 255)),
+                    255);
+            }
+        }
+
+        return PixelData;
+    }
+
+    struct FPresetResult
+    {
+        bool bWritten = false;
+        double Seconds = 0.0;
+        int64 FileBytes = 0;
+        FString FilePath;
+    };
+
+    FPresetResult WriteReferenceFrame(const TImagePixelData<FColor>& Reference, EOmniCapturePNGCompression Preset, EOmniCapturePNGBitDepth BitDepth, const FString& Directory)
+    {
+        FOmniCaptureSettings Settings;
+        Settings.ImageFormat = EOmniCaptureImageFormat::PNG;
+        Settings.PNGBitDepth = BitDepth;
+        Settings.PNGCompression = Preset;
+        // One encode thread writing straight to disk: the figures are per frame, not per pool.
+        Settings.ImageEncodeThreadCount = 1;
+        Settings.ImageFileWriteThreadCount = 0;
+
+        TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
+        Frame->PixelData = Reference.CopyImageData();
+        Frame->PixelDataType = EOmniCapturePixelDataType::Color8;
+
+        const FString FileName = FString::Printf(TEXT("Preset%d_%d.png"), static_cast<int32>(Preset), static_cast<int32>(BitDepth));
+
+        FPresetResult Result;
+        FOmniCaptureImageWriter Writer;
+        Writer.Initialize(Settings, Directory);
+
+        const double StartSeconds = FPlatformTime::Seconds();
+        Writer.EnqueueFrame(MoveTemp(Frame), FileName);
+        Writer.WaitForPendingWrites();
+        Result.Seconds = FPlatformTime::Seconds() - StartSeconds;
+
+        Result.bWritten = Writer.GetFailedWriteCount() == 0;
+        Result.FilePath = Directory / FileName;
+        Result.FileBytes = IFileManager::Get().FileSize(*Result.FilePath);
+        Writer.Flush();
+        return Result;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureImageWriterPNGPresetTest, "OmniCapture.ImageWriter.PNGCompressionPresetsRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureImageWriterPNGPresetTest::RunTest(const FString& Parameters)
+{
+    IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+    const FString Directory = FPaths::AutomationTransientDir() / TEXT("OmniCapturePNGPresets");
+    const TUniquePtr<TImagePixelData<FColor>> Reference = MakeReferenceFrame(FIntPoint(320, 200));
+
+    TMap<EOmniCapturePNGCompression, int64> FileBytes;
+    for (const EOmniCapturePNGCompression Preset : PNGCompressionPresets)
+    {
+        const FPresetResult Result = WriteReferenceFrame(*Reference, Preset, EOmniCapturePNGBitDepth::BitDepth8, Directory);
+        if (!TestTrue(TEXT("Preset writes the frame"), Result.bWritten && Result.FileBytes > 0))
+        {
+            continue;
+        }
+        FileBytes.Add(Preset, Result.FileBytes);
+
+        TArray64<uint8> Compressed;
+        TArray64<uint8> Decoded;
+        const TSharedPtr<IImageWrapper> Reader = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+        const bool bDecoded = FFileHelper::LoadFileToArray(Compressed, *Result.FilePath)
+            && Reader.IsValid()
+            && Reader->SetCompressed(Compressed.GetData(), Compressed.Num())
+            && Reader->GetRaw(ERGBFormat::BGRA, 8, Decoded);
+        TestTrue(TEXT("Preset output decodes"), bDecoded);
+        TestTrue(TEXT("Preset output is lossless"), bDecoded && Decoded.Num() == Reference->Pixels.Num() * static_cast<int64>(sizeof(FColor))
+            && FMemory::Memcmp(Decoded.GetData(), Reference->Pixels.GetData(), Decoded.Num()) == 0);
+    }
+
+    if (FileBytes.Num() == UE_ARRAY_COUNT(PNGCompressionPresets))
+    {
+        TestTrue(TEXT("Store-only is the largest"), FileBytes[EOmniCapturePNGCompression::StoreOnly] > FileBytes[EOmniCapturePNGCompression::Fast]);
+        TestTrue(TEXT("Max is no larger than default"), FileBytes[EOmniCapturePNGCompression::Max] <= FileBytes[EOmniCapturePNGCompression::Default]);
+    }
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureImageWriterPNGPresetBenchmark, "OmniCapture.ImageWriter.PNGCompressionPresetBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FOmniCaptureImageWriterPNGPresetBenchmark::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::AutomationTransientDir() / TEXT("OmniCapturePNGPresetBenchmark");
+    const FIntPoint Size(4096, 2048);
+    const TUniquePtr<TImagePixelData<FColor>> Reference = MakeReferenceFrame(Size);
+
+    for (const EOmniCapturePNGBitDepth BitDepth : { EOmniCapturePNGBitDepth::BitDepth8, EOmniCapturePNGBitDepth::BitDepth16 })
+    {
+        const int32 BytesPerPixel = BitDepth == EOmniCapturePNGBitDepth::BitDepth16 ? 8 : 4;
+        const double RawMegabytes = static_cast<double>(Size.X) * Size.Y * BytesPerPixel / (1024.0 * 1024.0);
+
+        for (const EOmniCapturePNGCompression Preset : PNGCompressionPresets)
+        {
+            const FPresetResult Result = WriteReferenceFrame(*Reference, Preset, BitDepth, Directory);
+            TestTrue(TEXT("Preset writes the frame"), Result.bWritten && Result.FileBytes > 0);
+
+            AddInfo(FString::Printf(TEXT("%s %d-bit %dx%d: %.1f ms, %.1f MB/s raw, ratio %.2f:1"),
+                *StaticEnum<EOmniCapturePNGCompression>()->GetNameStringByValue(static_cast<int64>(Preset)),
+                BytesPerPixel * 2, Size.X, Size.Y, Result.Seconds * 1000.0,
+                RawMegabytes / FMath::Max(Result.Seconds, 1e-9),
+                RawMegabytes * 1024.0 * 1024.0 / FMath::Max<int64>(Result.FileBytes, 1)));
+        }
+    }
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
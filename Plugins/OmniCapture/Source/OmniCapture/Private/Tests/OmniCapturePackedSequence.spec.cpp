@@ -0,0 +1,139 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureImageWriter.h"
+#include "OmniCapturePackedSequence.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    TArray64<uint8> MakePackedTestFile(int32 Seed, int32 Size)
+    {
+        TArray64<uint8> Data;
+        Data.SetNumUninitialized(Size);
+        for (int32 Index = 0; Index < Size; ++Index)
+        {
+            Data[Index] = static_cast<uint8>(Seed * 31 + Index);
+        }
+        return Data;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCapturePackedSequenceRoundTripTest, "OmniCapture.ImageWriter.PackedSequenceRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCapturePackedSequenceRoundTripTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::AutomationTransientDir() / TEXT("OmniCapturePackedSequence");
+    IFileManager::Get().MakeDirectory(*Directory, true);
+
+    // Seven files at three per pack: two full packs and one closed early.
+    {
+        FOmniCapturePackedSequenceWriter Writer(Directory, TEXT("Take"), 3);
+        for (int32 Index = 0; Index < 7; ++Index)
+        {
+            TestTrue(TEXT("File packs"), Writer.AddFile(FString::Printf(TEXT("Take_%06d.png"), Index), MakePackedTestFile(Index, 1000 + Index * 17)));
+        }
+
+        FOmniCapturePackedSequenceReader Unfinished;
+        TestFalse(TEXT("An unfinished pack is rejected"), Unfinished.Open(Directory / FOmniCapturePackedSequenceWriter::GetPackFileName(TEXT("Take"), 2)));
+
+        TestTrue(TEXT("Writer closes"), Writer.Close());
+    }
+
+    const TArray<FString> Packs = FOmniCapturePackedSequenceWriter::FindPacks(Directory, TEXT("Take"));
+    if (!TestEqual(TEXT("Packs rotate every three files"), Packs.Num(), 3))
+    {
+        return false;
+    }
+
+    int32 Expected = 0;
+    for (const FString& PackPath : Packs)
+    {
+        FOmniCapturePackedSequenceReader Reader;
+        if (!TestTrue(TEXT("Pack opens"), Reader.Open(PackPath)))
+        {
+            continue;
+        }
+
+        const TArray<FOmniCapturePackedEntry>& Entries = Reader.GetEntries();
+        for (int32 Index = 0; Index < Entries.Num(); ++Index, ++Expected)
+        {
+            TestEqual(TEXT("Files stay in pack order"), Entries[Index].FileName, FString::Printf(TEXT("Take_%06d.png"), Expected));
+
+            TArray64<uint8> Data;
+            TestTrue(TEXT("File reads back"), Reader.ReadEntry(Index, Data) && Data == MakePackedTestFile(Expected, 1000 + Expected * 17));
+        }
+    }
+    TestEqual(TEXT("Every file is indexed"), Expected, 7);
+
+    // A footer claiming more entries than its index can hold is rejected before they are allocated.
+    {
+        TArray<uint8> Damaged;
+        if (TestTrue(TEXT("Pack loads"), FFileHelper::LoadFileToArray(Damaged, *Packs[0])))
+        {
+            const int32 EntryCount = MAX_int32;
+            FMemory::Memcpy(Damaged.GetData() + Damaged.Num() - 8, &EntryCount, sizeof(EntryCount));
+            const FString DamagedPath = Directory / TEXT("Damaged.omnipack");
+            FFileHelper::SaveArrayToFile(Damaged, *DamagedPath);
+
+            FOmniCapturePackedSequenceReader Reader;
+            TestFalse(TEXT("An oversized entry count is rejected"), Reader.Open(DamagedPath));
+        }
+    }
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCapturePackedSequenceWriterTest, "OmniCapture.ImageWriter.PackedSequenceFromImageWriter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCapturePackedSequenceWriterTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("OmniCapturePackedSequenceWriter"));
+    const FIntPoint Size(48, 24);
+
+    FOmniCaptureSettings Settings;
+    Settings.ImageFormat = EOmniCaptureImageFormat::PNG;
+    Settings.OutputFileName = TEXT("Take");
+    Settings.PackedSequenceFramesPerFile = 2;
+
+    {
+        FOmniCaptureImageWriter Writer;
+        Writer.Initialize(Settings, Directory);
+        for (int32 FrameIndex = 0; FrameIndex < 5; ++FrameIndex)
+        {
+            TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
+            Frame->Metadata.FrameIndex = FrameIndex;
+            Frame->PixelDataType = EOmniCapturePixelDataType::Color8;
+            TUniquePtr<TImagePixelData<FColor>> Pixels = MakeUnique<TImagePixelData<FColor>>(Size);
+            Pixels->Pixels.Init(FColor(FrameIndex * 40, 128, 255 - FrameIndex * 40, 255), Size.X * Size.Y);
+            Frame->PixelData = MoveTemp(Pixels);
+            Writer.EnqueueFrame(MoveTemp(Frame), FString::Printf(TEXT("Take_%06d.png"), FrameIndex));
+        }
+        Writer.WaitForPendingWrites();
+        TestEqual(TEXT("No writes fail"), Writer.GetFailedWriteCount(), 0);
+        Writer.Flush();
+    }
+
+    const TArray<FString> Packs = FOmniCapturePackedSequenceWriter::FindPacks(Directory, TEXT("Take"));
+    TestEqual(TEXT("Two frames per pack"), Packs.Num(), 3);
+    TestFalse(TEXT("No per-frame files are written"), IFileManager::Get().FileExists(*(Directory / TEXT("Take_000000.png"))));
+
+    int32 PackedFrames = 0;
+    for (const FString& PackPath : Packs)
+    {
+        FOmniCapturePackedSequenceReader Reader;
+        if (TestTrue(TEXT("Pack opens"), Reader.Open(PackPath)))
+        {
+            for (int32 Index = 0; Index < Reader.GetEntries().Num(); ++Index, ++PackedFrames)
+            {
+                TArray64<uint8> Data;
+                TestTrue(TEXT("Packed frame is a PNG"), Reader.ReadEntry(Index, Data) && Data.Num() > 8 && Data[1] == 'P' && Data[2] == 'N' && Data[3] == 'G');
+            }
+        }
+    }
+    TestEqual(TEXT("Every frame is packed"), PackedFrames, 5);
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
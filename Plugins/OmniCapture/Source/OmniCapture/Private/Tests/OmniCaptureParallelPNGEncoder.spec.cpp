@@ -0,0 +1,156 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureParallelPNGEncoder.h"
+
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Math/RandomStream.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+    // Gradients with a little noise, so every filter type gets picked somewhere.
+    TArray64<uint8> MakeTestImage(const FIntPoint& Size, int32 BitDepth, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        const int32 BytesPerSample = BitDepth / 8;
+        TArray64<uint8> Pixels;
+        Pixels.SetNumUninitialized(static_cast<int64>(Size.X) * Size.Y * 4 * BytesPerSample);
+
+        for (int32 Y = 0; Y < Size.Y; ++Y)
+        {
+            for (int32 X = 0; X < Size.X; ++X)
+            {
+                const int64 PixelOffset = (static_cast<int64>(Y) * Size.X + X) * 4;
+                const int32 Samples[4] =
+                {
+                    X * 65535 / FMath::Max(1, Size.X - 1),
+                    Y * 65535 / FMath::Max(1, Size.Y - 1),
+                    (X ^ Y) * 257 + Random.RandRange(0, 511),
+                    65535 - Random.RandRange(0, 64)
+                };
+
+                for (int32 Channel = 0; Channel < 4; ++Channel)
+                {
+                    const uint16 Value = static_cast<uint16>(FMath::Clamp(Samples[Channel], 0, 65535));
+                    if (BytesPerSample == 2)
+                    {
+                        reinterpret_cast<uint16*>(Pixels.GetData())[PixelOffset + Channel] = Value;
+                    }
+                    else
+                    {
+                        Pixels[PixelOffset + Channel] = static_cast<uint8>(Value >> 8);
+                    }
+                }
+            }
+        }
+
+        return Pixels;
+    }
+
+    bool EncodeTestImage(const TArray64<uint8>& Pixels, const FIntPoint& Size, const FOmniCapturePNGEncodeOptions& Options, TArray64<uint8>& OutPNG)
+    {
+        const uint8* BasePtr = Pixels.GetData();
+        return FOmniCaptureParallelPNGEncoder::Encode(Size, Options,
+            [BasePtr](int32 RowStart, int32 RowCount, int64 BytesPerRow, TArray64<uint8>&, TArray<uint8*>& RowPointers)
+            {
+                for (int32 Row = 0; Row < RowCount; ++Row)
+                {
+                    RowPointers[Row] = const_cast<uint8*>(BasePtr + static_cast<int64>(RowStart + Row) * BytesPerRow);
+                }
+            },
+            []() { return false; },
+            OutPNG);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureParallelPNGRoundTripTest, "OmniCapture.ImageWriter.ParallelPNGDecodesWithStandardReader", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureParallelPNGRoundTripTest::RunTest(const FString& Parameters)
+{
+    IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+    const FIntPoint Size(301, 257);
+
+    for (const int32 BitDepth : { 8, 16 })
+    {
+        const TArray64<uint8> Pixels = MakeTestImage(Size, BitDepth, 0x5EED + BitDepth);
+
+        FOmniCapturePNGEncodeOptions Options;
+        Options.BitDepth = BitDepth;
+        Options.bBGROrder = true;
+        // Small strips so the stream spans many strips and several batches.
+        Options.StripBytes = 16 * 1024;
+
+        TArray64<uint8> SingleThreaded;
+        Options.ThreadCount = 1;
+        TestTrue(TEXT("Single-threaded encode succeeds"), EncodeTestImage(Pixels, Size, Options, SingleThreaded));
+
+        TArray64<uint8> Encoded;
+        Options.ThreadCount = 3;
+        if (!TestTrue(TEXT("Parallel encode succeeds"), EncodeTestImage(Pixels, Size, Options, Encoded)))
+        {
+            continue;
+        }
+        TestTrue(TEXT("Output does not depend on the thread count"), Encoded == SingleThreaded);
+
+        const TSharedPtr<IImageWrapper> Reader = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+        TArray64<uint8> Decoded;
+        if (!TestTrue(TEXT("Reader accepts the file"), Reader.IsValid() && Reader->SetCompressed(Encoded.GetData(), Encoded.Num())))
+        {
+            continue;
+        }
+
+        TestEqual(TEXT("Width survives"), static_cast<int32>(Reader->GetWidth()), Size.X);
+        TestEqual(TEXT("Height survives"), static_cast<int32>(Reader->GetHeight()), Size.Y);
+        TestEqual(TEXT("Bit depth survives"), Reader->GetBitDepth(), BitDepth);
+        TestTrue(TEXT("Pixels decode"), Reader->GetRaw(ERGBFormat::BGRA, BitDepth, Decoded));
+        TestTrue(TEXT("Pixels round-trip exactly"), Decoded == Pixels);
+    }
+
+    FOmniCapturePNGEncodeOptions Unsupported;
+    Unsupported.BitDepth = 32;
+    TArray64<uint8> Rejected;
+    TestFalse(TEXT("Float samples are rejected"), EncodeTestImage(TArray64<uint8>(), Size, Unsupported, Rejected));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureParallelPNGBenchmark, "OmniCapture.ImageWriter.ParallelPNGScalingBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FOmniCaptureParallelPNGBenchmark::RunTest(const FString& Parameters)
+{
+    // A quarter of an 8K x 8K 16-bit frame keeps the run short while every thread count has plenty of strips.
+    const FIntPoint Size(4096, 4096);
+    const TArray64<uint8> Pixels = MakeTestImage(Size, 16, 0xBE7C);
+
+    TArray<int32> ThreadCounts = { 1, 2, 4, 8 };
+    const int32 MaxThreads = FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+    ThreadCounts.RemoveAll([MaxThreads](int32 Threads) { return Threads > MaxThreads; });
+    ThreadCounts.AddUnique(MaxThreads);
+
+    double BaselineSeconds = 0.0;
+    for (const int32 Threads : ThreadCounts)
+    {
+        FOmniCapturePNGEncodeOptions Options;
+        Options.BitDepth = 16;
+        Options.bBGROrder = true;
+        Options.ThreadCount = Threads;
+
+        TArray64<uint8> Encoded;
+        const double StartSeconds = FPlatformTime::Seconds();
+        const bool bEncoded = EncodeTestImage(Pixels, Size, Options, Encoded);
+        const double Seconds = FPlatformTime::Seconds() - StartSeconds;
+        TestTrue(TEXT("Encode succeeds"), bEncoded);
+
+        if (Threads == 1)
+        {
+            BaselineSeconds = Seconds;
+        }
+
+        AddInfo(FString::Printf(TEXT("%d thread(s): %.1f ms, %.1f MB raw/s, %.2fx vs 1 thread, %.1f MB file"),
+            Threads, Seconds * 1000.0, Pixels.Num() / FMath::Max(Seconds, 1e-9) / (1024.0 * 1024.0),
+            BaselineSeconds / FMath::Max(Seconds, 1e-9), Encoded.Num() / (1024.0 * 1024.0)));
+    }
+
+    return true;
+}
@@ -0,0 +1,90 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCapturePixelBufferPool.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCapturePixelBufferPoolReuseTest, "OmniCapture.PixelPool.ReusesBuffersBySizeAndType", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCapturePixelBufferPoolReuseTest::RunTest(const FString& Parameters)
+{
+    FOmniCapturePixelBufferPool Pool;
+    Pool.Configure(2, 64ll * 1024 * 1024);
+
+    const FIntPoint Size(64, 32);
+    TUniquePtr<TImagePixelData<FColor>> First = Pool.Acquire<FColor>(Size);
+    TestEqual(TEXT("Acquired buffer is sized for the frame"), First->Pixels.Num(), static_cast<int64>(Size.X) * Size.Y);
+    const FColor* FirstAllocation = First->Pixels.GetData();
+
+    Pool.Release(MoveTemp(First), EOmniCapturePixelDataType::Color8);
+    TestEqual(TEXT("Released buffer is pooled"), Pool.GetStats().PooledBuffers, 1);
+
+    TUniquePtr<TImagePixelData<FFloat16Color>> OtherType = Pool.Acquire<FFloat16Color>(Size);
+    TUniquePtr<TImagePixelData<FColor>> OtherSize = Pool.Acquire<FColor>(Size * 2);
+    TUniquePtr<TImagePixelData<FColor>> Reused = Pool.Acquire<FColor>(Size);
+    TestTrue(TEXT("Matching size and type gets the pooled allocation back"), Reused->Pixels.GetData() == FirstAllocation);
+    TestTrue(TEXT("Reused buffer reports its size"), Reused->GetSize() == Size);
+
+    const FOmniCapturePixelPoolStats Stats = Pool.GetStats();
+    TestEqual(TEXT("One hit"), Stats.Hits, 1);
+    TestEqual(TEXT("Three misses"), Stats.Misses, 3);
+    TestEqual(TEXT("Nothing left pooled"), Stats.PooledBuffers, 0);
+
+    // Unknown types are inferred from the pixel data.
+    Pool.Release(MoveTemp(OtherType), EOmniCapturePixelDataType::Unknown);
+    TUniquePtr<TImagePixelData<FFloat16Color>> Inferred = Pool.Acquire<FFloat16Color>(Size);
+    TestEqual(TEXT("Inferred type is reused"), Pool.GetStats().Hits, 2);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCapturePixelBufferPoolLimitsTest, "OmniCapture.PixelPool.EnforcesHighWaterMarks", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCapturePixelBufferPoolLimitsTest::RunTest(const FString& Parameters)
+{
+    const FIntPoint Size(256, 256);
+    const int64 BufferBytes = static_cast<int64>(Size.X) * Size.Y * sizeof(FColor);
+
+    FOmniCapturePixelBufferPool Pool;
+    Pool.Configure(2, BufferBytes * 10);
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        Pool.Release(Pool.Acquire<FColor>(Size), EOmniCapturePixelDataType::Color8);
+    }
+
+    // Three returned at once: only two fit under the per-size count.
+    TArray<TUniquePtr<TImagePixelData<FColor>>> Held;
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        Held.Add(Pool.Acquire<FColor>(Size));
+    }
+    for (TUniquePtr<TImagePixelData<FColor>>& Buffer : Held)
+    {
+        Pool.Release(MoveTemp(Buffer), EOmniCapturePixelDataType::Color8);
+    }
+
+    FOmniCapturePixelPoolStats Stats = Pool.GetStats();
+    TestEqual(TEXT("Per-size count caps the pool"), Stats.PooledBuffers, 2);
+    TestEqual(TEXT("Returns over the cap are freed"), Stats.Discarded, 1);
+    TestEqual(TEXT("Pooled bytes are tracked"), Stats.PooledBytes, BufferBytes * 2);
+
+    Pool.Configure(8, BufferBytes);
+    Held.Reset();
+    for (int32 Index = 0; Index < 2; ++Index)
+    {
+        Held.Add(Pool.Acquire<FColor>(Size));
+    }
+    for (TUniquePtr<TImagePixelData<FColor>>& Buffer : Held)
+    {
+        Pool.Release(MoveTemp(Buffer), EOmniCapturePixelDataType::Color8);
+    }
+
+    Stats = Pool.GetStats();
+    TestEqual(TEXT("Byte budget caps the pool"), Stats.PooledBuffers, 1);
+    TestEqual(TEXT("Peak pooled bytes stay within the budget"), Stats.PeakPooledBytes, BufferBytes);
+
+    Pool.Trim();
+    TestEqual(TEXT("Trim empties the pool"), Pool.GetStats().PooledBytes, static_cast<int64>(0));
+
+    Pool.Configure(0, BufferBytes * 10);
+    Pool.Release(Pool.Acquire<FColor>(Size), EOmniCapturePixelDataType::Color8);
+    TestEqual(TEXT("A count of 0 disables pooling"), Pool.GetStats().PooledBuffers, 0);
+
+    return true;
+}
@@ -0,0 +1,139 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCapturePixelKernels.h"
+
+#include "Math/RandomStream.h"
+
+namespace
+{
+    int32 ChannelDelta(uint32 A, uint32 B)
+    {
+        return FMath::Abs(static_cast<int32>(A) - static_cast<int32>(B));
+    }
+
+    int32 ColorDelta(const FColor& A, const FColor& B)
+    {
+        return FMath::Max(FMath::Max(ChannelDelta(A.R, B.R), ChannelDelta(A.G, B.G)), FMath::Max(ChannelDelta(A.B, B.B), ChannelDelta(A.A, B.A)));
+    }
+
+    // Out-of-range, sub-LSB and sRGB knee values up front, random HDR pixels after them.
+    TArray<FLinearColor> MakePixelKernelTestPixels(int32 Count)
+    {
+        const float EdgeValues[] = { 0.0f, 1.0f, -1.0f, 0.5f, 1.e-4f, 1.e-7f, 0.0031308f, 0.04045f, 0.99999f, 1.5f, 65504.0f, 1.e6f };
+
+        FRandomStream Random(0x5EB6B);
+        TArray<FLinearColor> Pixels;
+        Pixels.SetNumUninitialized(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Pixels[Index] = FLinearColor(Random.FRandRange(-0.25f, 1.5f), Random.FRandRange(-0.25f, 1.5f), Random.FRandRange(-0.25f, 1.5f), Random.FRandRange(-0.25f, 1.5f));
+        }
+        for (int32 Index = 0; Index < UE_ARRAY_COUNT(EdgeValues); ++Index)
+        {
+            const float Value = EdgeValues[Index];
+            Pixels[Index] = FLinearColor(Value, Value * 0.5f, Value * 0.25f, Value);
+        }
+        return Pixels;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCapturePixelKernelsMatchScalarTest, "OmniCapture.ImageWriter.PixelKernelsMatchScalar", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCapturePixelKernelsMatchScalarTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 PixelCount = 4099; // Odd, so the single-pixel tails run too.
+
+    const TArray<FLinearColor> FloatPixels = MakePixelKernelTestPixels(PixelCount);
+    TArray<FFloat16Color> HalfPixels;
+    HalfPixels.SetNumUninitialized(PixelCount);
+    for (int32 Index = 0; Index < PixelCount; ++Index)
+    {
+        HalfPixels[Index] = FFloat16Color(FloatPixels[Index]);
+    }
+
+    TArray<FColor> Colors;
+    Colors.SetNumUninitialized(PixelCount);
+    TArray<uint16> Codes;
+    Codes.SetNumUninitialized(PixelCount * 4);
+
+    // Float sRGB goes through half and may round across a code boundary.
+    {
+        FOmniCapturePixelKernels::LinearToSRGB8(FloatPixels.GetData(), PixelCount, Colors.GetData());
+        int32 MaxDelta = 0;
+        int32 SinglePixelMismatches = 0;
+        for (int32 Index = 0; Index < PixelCount; ++Index)
+        {
+            MaxDelta = FMath::Max(MaxDelta, ColorDelta(Colors[Index], FOmniCapturePixelKernels::ToSRGB8Scalar(FloatPixels[Index])));
+            SinglePixelMismatches += FOmniCapturePixelKernels::ToSRGB8(FloatPixels[Index]) != Colors[Index] ? 1 : 0;
+        }
+        TestTrue(FString::Printf(TEXT("Float sRGB8 within one LSB of ToFColor (max %d)"), MaxDelta), MaxDelta <= 1);
+        TestEqual(TEXT("Single-pixel float sRGB8 matches the row kernel"), SinglePixelMismatches, 0);
+    }
+
+    // Half inputs hit the tables built from the scalar references, so they are exact.
+    {
+        FOmniCapturePixelKernels::LinearToSRGB8(HalfPixels.GetData(), PixelCount, Colors.GetData());
+        int32 Mismatches = 0;
+        int32 SinglePixelMismatches = 0;
+        for (int32 Index = 0; Index < PixelCount; ++Index)
+        {
+            Mismatches += Colors[Index] != FOmniCapturePixelKernels::ToSRGB8Scalar(FLinearColor(HalfPixels[Index])) ? 1 : 0;
+            SinglePixelMismatches += FOmniCapturePixelKernels::ToSRGB8(HalfPixels[Index]) != Colors[Index] ? 1 : 0;
+        }
+        TestEqual(TEXT("Half sRGB8 matches ToFColor"), Mismatches, 0);
+        TestEqual(TEXT("Single-pixel half sRGB8 matches the row kernel"), SinglePixelMismatches, 0);
+    }
+
+    {
+        FOmniCapturePixelKernels::LinearToUNorm16BGRA(FloatPixels.GetData(), PixelCount, Codes.GetData());
+        int32 MaxDelta = 0;
+        for (int32 Index = 0; Index < PixelCount; ++Index)
+        {
+            const FLinearColor& Pixel = FloatPixels[Index];
+            const uint16* Actual = Codes.GetData() + Index * 4;
+            MaxDelta = FMath::Max(MaxDelta, ChannelDelta(Actual[0], FOmniCapturePixelKernels::ToUNorm16Scalar(Pixel.B)));
+            MaxDelta = FMath::Max(MaxDelta, ChannelDelta(Actual[1], FOmniCapturePixelKernels::ToUNorm16Scalar(Pixel.G)));
+            MaxDelta = FMath::Max(MaxDelta, ChannelDelta(Actual[2], FOmniCapturePixelKernels::ToUNorm16Scalar(Pixel.R)));
+            MaxDelta = FMath::Max(MaxDelta, ChannelDelta(Actual[3], FOmniCapturePixelKernels::ToUNorm16Scalar(Pixel.A)));
+        }
+        TestTrue(FString::Printf(TEXT("Float UNorm16 BGRA within one LSB of the scalar path (max %d)"), MaxDelta), MaxDelta <= 1);
+    }
+
+    {
+        FOmniCapturePixelKernels::LinearToUNorm16BGRA(HalfPixels.GetData(), PixelCount, Codes.GetData());
+        int32 Mismatches = 0;
+        for (int32 Index = 0; Index < PixelCount; ++Index)
+        {
+            const FFloat16Color& Pixel = HalfPixels[Index];
+            const uint16* Actual = Codes.GetData() + Index * 4;
+            Mismatches += Actual[0] != FOmniCapturePixelKernels::ToUNorm16Scalar(Pixel.B.GetFloat()) ? 1 : 0;
+            Mismatches += Actual[1] != FOmniCapturePixelKernels::ToUNorm16Scalar(Pixel.G.GetFloat()) ? 1 : 0;
+            Mismatches += Actual[2] != FOmniCapturePixelKernels::ToUNorm16Scalar(Pixel.R.GetFloat()) ? 1 : 0;
+            Mismatches += Actual[3] != FOmniCapturePixelKernels::ToUNorm16Scalar(Pixel.A.GetFloat()) ? 1 : 0;
+        }
+        TestEqual(TEXT("Half UNorm16 BGRA matches the scalar path"), Mismatches, 0);
+    }
+
+    {
+        TArray<FLinearColor> Widened;
+        Widened.SetNumUninitialized(PixelCount);
+        FOmniCapturePixelKernels::HalfToFloat(HalfPixels.GetData(), PixelCount, Widened.GetData());
+        int32 Mismatches = 0;
+        for (int32 Index = 0; Index < PixelCount; ++Index)
+        {
+            Mismatches += Widened[Index] != FLinearColor(HalfPixels[Index]) ? 1 : 0;
+        }
+        TestEqual(TEXT("Half to float is exact"), Mismatches, 0);
+    }
+
+    {
+        const FColor Display(255, 128, 1, 0);
+        uint16 Expanded[4];
+        FOmniCapturePixelKernels::SRGB8ToUNorm16BGRA(&Display, 1, Expanded);
+        TestEqual(TEXT("8-bit expands to 16-bit B"), Expanded[0], static_cast<uint16>(257));
+        TestEqual(TEXT("8-bit expands to 16-bit G"), Expanded[1], static_cast<uint16>(128 * 257));
+        TestEqual(TEXT("8-bit expands to 16-bit R"), Expanded[2], static_cast<uint16>(65535));
+        TestEqual(TEXT("8-bit expands to 16-bit A"), Expanded[3], static_cast<uint16>(0));
+    }
+
+    return true;
+}
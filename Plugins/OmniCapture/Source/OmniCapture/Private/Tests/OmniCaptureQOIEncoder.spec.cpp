@@ -0,0 +1,158 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureParallelPNGEncoder.h"
+#include "OmniCaptureQOIEncoder.h"
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    // Flat bands, gradients, noise and a few translucent columns: every QOI op gets used.
+    TArray64<FColor> MakeTestImage(const FIntPoint& Size, int32 Seed)
+    {
+        FRandomStream Random(Seed);
+        TArray64<FColor> Pixels;
+        Pixels.SetNumUninitialized(static_cast<int64>(Size.X) * Size.Y);
+
+        for (int32 Y = 0; Y < Size.Y; ++Y)
+        {
+            for (int32 X = 0; X < Size.X; ++X)
+            {
+                FColor& Pixel = Pixels[static_cast<int64>(Y) * Size.X + X];
+                switch ((Y / 16) % 3)
+                {
+                case 0:
+                    Pixel = FColor(40, 80, 120, 255);
+                    break;
+                case 1:
+                    Pixel = FColor(static_cast<uint8>(X), static_cast<uint8>(Y), static_cast<uint8>(X + Y + Random.RandRange(0, 3)), 255);
+                    break;
+                default:
+                    Pixel = FColor(static_cast<uint8>(Random.RandRange(0, 255)), static_cast<uint8>(Random.RandRange(0, 255)), static_cast<uint8>(Random.RandRange(0, 255)),
+                        X % 37 < 2 ? static_cast<uint8>(Random.RandRange(0, 255)) : 255);
+                    break;
+                }
+            }
+        }
+
+        return Pixels;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureQOIRoundTripTest, "OmniCapture.ImageWriter.QOIRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureQOIRoundTripTest::RunTest(const FString& Parameters)
+{
+    const FIntPoint Size(301, 257);
+    const TArray64<FColor> Pixels = MakeTestImage(Size, 0x901F);
+
+    FOmniCaptureQOIEncodeOptions Options;
+    TArray64<uint8> Plain;
+    if (!TestTrue(TEXT("Single-stream encode succeeds"), FOmniCaptureQOIEncoder::Encode(Size, Pixels.GetData(), Options, Plain)))
+    {
+        return false;
+    }
+
+    const uint8 EndMarker[] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    TestTrue(TEXT("File opens with the QOI magic"), Plain.Num() > 22 && FMemory::Memcmp(Plain.GetData(), "qoif", 4) == 0);
+    TestTrue(TEXT("Single-stream file ends with the end marker"), FMemory::Memcmp(Plain.GetData() + Plain.Num() - 8, EndMarker, 8) == 0);
+
+    int32 ChunkRows = 0;
+    TArray<int64> ChunkOffsets;
+    TestFalse(TEXT("Single-stream file has no chunk index"), FOmniCaptureQOIEncoder::ReadChunkIndex(Plain.GetData(), Plain.Num(), ChunkRows, ChunkOffsets));
+
+    FIntPoint DecodedSize;
+    TArray64<FColor> Decoded;
+    TestTrue(TEXT("Single-stream file decodes"), FOmniCaptureQOIEncoder::Decode(Plain.GetData(), Plain.Num(), DecodedSize, Decoded));
+    TestTrue(TEXT("Size survives"), DecodedSize == Size);
+    TestTrue(TEXT("Pixels round-trip exactly"), Decoded == Pixels);
+
+    // Small chunks so the image spans many of them.
+    Options.bChunked = true;
+    Options.ChunkPixels = 4000;
+
+    TArray64<uint8> SingleThreaded;
+    Options.ThreadCount = 1;
+    TestTrue(TEXT("Single-threaded chunked encode succeeds"), FOmniCaptureQOIEncoder::Encode(Size, Pixels.GetData(), Options, SingleThreaded));
+
+    TArray64<uint8> Chunked;
+    Options.ThreadCount = 3;
+    if (!TestTrue(TEXT("Chunked encode succeeds"), FOmniCaptureQOIEncoder::Encode(Size, Pixels.GetData(), Options, Chunked)))
+    {
+        return false;
+    }
+    TestTrue(TEXT("Output does not depend on the thread count"), Chunked == SingleThreaded);
+
+    if (TestTrue(TEXT("Chunked file carries an index"), FOmniCaptureQOIEncoder::ReadChunkIndex(Chunked.GetData(), Chunked.Num(), ChunkRows, ChunkOffsets)))
+    {
+        TestEqual(TEXT("Chunk rows follow the pixel budget"), ChunkRows, 4000 / Size.X);
+        TestEqual(TEXT("Every chunk is indexed"), ChunkOffsets.Num(), FMath::DivideAndRoundUp(Size.Y, ChunkRows));
+    }
+
+    TestTrue(TEXT("Chunked file decodes through the index"), FOmniCaptureQOIEncoder::Decode(Chunked.GetData(), Chunked.Num(), DecodedSize, Decoded));
+    TestTrue(TEXT("Chunked pixels round-trip exactly"), Decoded == Pixels);
+
+    // Strip the index: what is left must be a plain QOI stream a standard reader decodes serially.
+    TArray64<uint8> Stripped(Chunked.GetData(), ChunkOffsets.Num() > 0 ? Chunked.Num() - 12 - ChunkOffsets.Num() * 8 : 0);
+    TestTrue(TEXT("Index sits after the end marker"), Stripped.Num() > 8 && FMemory::Memcmp(Stripped.GetData() + Stripped.Num() - 8, EndMarker, 8) == 0);
+    TestTrue(TEXT("Chunks decode back to back without the index"), FOmniCaptureQOIEncoder::Decode(Stripped.GetData(), Stripped.Num(), DecodedSize, Decoded));
+    TestTrue(TEXT("Serially decoded pixels round-trip exactly"), Decoded == Pixels);
+
+    Stripped.SetNum(Stripped.Num() / 2);
+    TestFalse(TEXT("Truncated files are rejected"), FOmniCaptureQOIEncoder::Decode(Stripped.GetData(), Stripped.Num(), DecodedSize, Decoded));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureQOIBenchmark, "OmniCapture.ImageWriter.QOIEncodeBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FOmniCaptureQOIBenchmark::RunTest(const FString& Parameters)
+{
+    const FIntPoint Size(4096, 2048);
+    const TArray64<FColor> Pixels = MakeTestImage(Size, 0xBE7C);
+    const double RawMegabytes = Pixels.Num() * sizeof(FColor) / (1024.0 * 1024.0);
+
+    const auto Report = [this, RawMegabytes](const TCHAR* Label, double Seconds, int64 FileBytes)
+    {
+        AddInfo(FString::Printf(TEXT("%s: %.1f ms, %.1f MB/s raw, ratio %.2f:1"), Label, Seconds * 1000.0,
+            RawMegabytes / FMath::Max(Seconds, 1e-9), RawMegabytes * 1024.0 * 1024.0 / FMath::Max<int64>(FileBytes, 1)));
+    };
+
+    for (const bool bChunked : { false, true })
+    {
+        FOmniCaptureQOIEncodeOptions Options;
+        Options.bChunked = bChunked;
+
+        TArray64<uint8> Encoded;
+        const double StartSeconds = FPlatformTime::Seconds();
+        TestTrue(TEXT("QOI encode succeeds"), FOmniCaptureQOIEncoder::Encode(Size, Pixels.GetData(), Options, Encoded));
+        Report(bChunked ? TEXT("QOI chunked") : TEXT("QOI"), FPlatformTime::Seconds() - StartSeconds, Encoded.Num());
+    }
+
+    // PNG at the Fast and Default presets on one thread, for scale.
+    for (const int32 Level : { 1, 6 })
+    {
+        FOmniCapturePNGEncodeOptions Options;
+        Options.bBGROrder = true;
+        Options.CompressionLevel = Level;
+        Options.FixedFilter = Level == 1 ? 2 : -1;
+        Options.ThreadCount = 1;
+
+        const uint8* BasePtr = reinterpret_cast<const uint8*>(Pixels.GetData());
+        TArray64<uint8> Encoded;
+        const double StartSeconds = FPlatformTime::Seconds();
+        const bool bEncoded = FOmniCaptureParallelPNGEncoder::Encode(Size, Options,
+            [BasePtr](int32 RowStart, int32 RowCount, int64 BytesPerRow, TArray64<uint8>&, TArray<uint8*>& RowPointers)
+            {
+                for (int32 Row = 0; Row < RowCount; ++Row)
+                {
+                    RowPointers[Row] = const_cast<uint8*>(BasePtr + static_cast<int64>(RowStart + Row) * BytesPerRow);
+                }
+            },
+            []() { return false; },
+            Encoded);
+        TestTrue(TEXT("PNG encode succeeds"), bEncoded);
+        Report(Level == 1 ? TEXT("PNG fast") : TEXT("PNG default"), FPlatformTime::Seconds() - StartSeconds, Encoded.Num());
+    }
+
+    return true;
+}
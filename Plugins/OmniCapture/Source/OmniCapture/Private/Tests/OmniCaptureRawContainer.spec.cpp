@@ -0,0 +1,170 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureImageWriter.h"
+#include "OmniCaptureRawContainer.h"
+
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    TUniquePtr<FOmniCaptureFrame> MakeRawTestFrame(int32 FrameIndex, const FIntPoint& Size)
+    {
+        FRandomStream Random(0x0A11 + FrameIndex);
+        const int64 PixelCount = static_cast<int64>(Size.X) * Size.Y;
+
+        TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
+        Frame->Metadata.FrameIndex = FrameIndex;
+        Frame->Metadata.Timecode = FrameIndex / 60.0;
+        Frame->Metadata.bKeyFrame = FrameIndex == 0;
+        Frame->bLinearColor = true;
+        Frame->PixelPrecision = EOmniCapturePixelPrecision::HalfFloat;
+        Frame->PixelDataType = EOmniCapturePixelDataType::LinearColorFloat16;
+
+        TUniquePtr<TImagePixelData<FFloat16Color>> Canvas = MakeUnique<TImagePixelData<FFloat16Color>>(Size);
+        Canvas->Pixels.SetNumUninitialized(PixelCount);
+        for (FFloat16Color& Pixel : Canvas->Pixels)
+        {
+            Pixel = FFloat16Color(FLinearColor(Random.FRand() * 4.0f, Random.FRand(), Random.FRand(), 1.0f));
+        }
+        Frame->PixelData = MoveTemp(Canvas);
+
+        TUniquePtr<TImagePixelData<float>> Depth = MakeUnique<TImagePixelData<float>>(Size);
+        Depth->Pixels.SetNumUninitialized(PixelCount);
+        for (float& Value : Depth->Pixels)
+        {
+            Value = Random.FRandRange(10.0f, 10000.0f);
+        }
+
+        FOmniCaptureLayerPayload& Layer = Frame->AuxiliaryLayers.Add(GetAuxiliaryLayerName(EOmniCaptureAuxiliaryPassType::SceneDepth));
+        Layer.PixelData = MoveTemp(Depth);
+        Layer.bLinear = true;
+        Layer.Precision = EOmniCapturePixelPrecision::FullFloat;
+        Layer.PixelDataType = EOmniCapturePixelDataType::ScalarFloat32;
+        return Frame;
+    }
+
+    bool SamePixels(const FImagePixelData* A, const FImagePixelData* B)
+    {
+        const void* DataA = nullptr;
+        const void* DataB = nullptr;
+        int64 SizeA = 0;
+        int64 SizeB = 0;
+        if (!A || !B)
+        {
+            return false;
+        }
+        A->GetRawData(DataA, SizeA);
+        B->GetRawData(DataB, SizeB);
+        return A->GetSize() == B->GetSize() && SizeA == SizeB && FMemory::Memcmp(DataA, DataB, SizeA) == 0;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRawContainerRoundTripTest, "OmniCapture.ImageWriter.RawContainerRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRawContainerRoundTripTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::AutomationTransientDir() / TEXT("OmniCaptureRawContainer");
+    IFileManager::Get().MakeDirectory(*Directory, true);
+    const FString FilePath = Directory / TEXT("RoundTrip.omniraw");
+    const FIntPoint Size(97, 61);
+
+    // Appended out of order, as several ring buffer consumers would.
+    TArray<TUniquePtr<FOmniCaptureFrame>> Frames;
+    for (const int32 FrameIndex : { 1, 0, 2 })
+    {
+        Frames.Add(MakeRawTestFrame(FrameIndex, Size));
+    }
+
+    {
+        FOmniCaptureRawContainerWriter Writer;
+        if (!TestTrue(TEXT("Container opens for writing"), Writer.Open(FilePath, TEXT("{\"outputFileName\":\"RoundTrip\"}"))))
+        {
+            return false;
+        }
+        for (const TUniquePtr<FOmniCaptureFrame>& Frame : Frames)
+        {
+            TestTrue(TEXT("Frame appends"), Writer.AppendFrame(*Frame));
+        }
+
+        FOmniCaptureRawContainerReader Unfinished;
+        TestFalse(TEXT("An unfinished container is rejected"), Unfinished.Open(FilePath));
+
+        TestTrue(TEXT("Container closes"), Writer.Close());
+    }
+
+    FOmniCaptureRawContainerReader Reader;
+    if (!TestTrue(TEXT("Container opens for reading"), Reader.Open(FilePath)))
+    {
+        return false;
+    }
+
+    TestEqual(TEXT("Settings survive"), Reader.GetSettingsJson(), FString(TEXT("{\"outputFileName\":\"RoundTrip\"}")));
+    if (!TestEqual(TEXT("Every frame is indexed"), Reader.GetFrameCount(), Frames.Num()))
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < Frames.Num(); ++Index)
+    {
+        const FOmniCaptureFrame& Expected = *Frames[Index];
+        const FOmniCaptureRawFrameEntry& Entry = Reader.GetFrameEntry(Index);
+        TestEqual(TEXT("Frame number survives"), Entry.Metadata.FrameIndex, Expected.Metadata.FrameIndex);
+        for (const FOmniCaptureRawPlane& Plane : Entry.Planes)
+        {
+            TestEqual(TEXT("Planes start on a page boundary"), Plane.Offset % 4096, 0ll);
+        }
+
+        FOmniCaptureFrame Read;
+        if (!TestTrue(TEXT("Frame reads back"), Reader.ReadFrame(Index, Read)))
+        {
+            continue;
+        }
+
+        TestEqual(TEXT("Timecode survives"), Read.Metadata.Timecode, Expected.Metadata.Timecode);
+        TestEqual(TEXT("Keyframe flag survives"), Read.Metadata.bKeyFrame, Expected.Metadata.bKeyFrame);
+        TestTrue(TEXT("Canvas type survives"), Read.PixelDataType == Expected.PixelDataType && Read.PixelPrecision == Expected.PixelPrecision && Read.bLinearColor);
+        TestTrue(TEXT("Canvas pixels survive"), SamePixels(Read.PixelData.Get(), Expected.PixelData.Get()));
+
+        const FName DepthName = GetAuxiliaryLayerName(EOmniCaptureAuxiliaryPassType::SceneDepth);
+        const FOmniCaptureLayerPayload* Layer = Read.AuxiliaryLayers.Find(DepthName);
+        TestTrue(TEXT("Auxiliary layer survives"), Layer && Layer->PixelDataType == EOmniCapturePixelDataType::ScalarFloat32
+            && SamePixels(Layer->PixelData.Get(), Expected.AuxiliaryLayers[DepthName].PixelData.Get()));
+    }
+
+    Reader.Close();
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRawContainerWriterTest, "OmniCapture.ImageWriter.RawContainerFromImageWriter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRawContainerWriterTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::AutomationTransientDir() / TEXT("OmniCaptureRawContainerWriter");
+
+    FOmniCaptureSettings Settings;
+    Settings.ImageFormat = EOmniCaptureImageFormat::OmniRaw;
+    Settings.OutputFileName = TEXT("Take");
+
+    {
+        FOmniCaptureImageWriter Writer;
+        Writer.Initialize(Settings, Directory);
+        for (int32 FrameIndex = 0; FrameIndex < 4; ++FrameIndex)
+        {
+            Writer.EnqueueFrame(MakeRawTestFrame(FrameIndex, FIntPoint(64, 32)), FString::Printf(TEXT("Take_%06d.omniraw"), FrameIndex));
+        }
+        Writer.WaitForPendingWrites();
+        TestEqual(TEXT("No writes fail"), Writer.GetFailedWriteCount(), 0);
+        Writer.Flush();
+    }
+
+    FOmniCaptureRawContainerReader Reader;
+    TestTrue(TEXT("The writer leaves one finished container"), Reader.Open(FPaths::ConvertRelativePathToFull(Directory) / TEXT("Take.omniraw")));
+    TestEqual(TEXT("Every frame is in it"), Reader.GetFrameCount(), 4);
+    TestTrue(TEXT("Capture settings are embedded"), Reader.GetSettingsJson().Contains(TEXT("Take")));
+    TestFalse(TEXT("No per-frame files are written"), IFileManager::Get().FileExists(*(Directory / TEXT("Take_000000.omniraw"))));
+
+    Reader.Close();
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
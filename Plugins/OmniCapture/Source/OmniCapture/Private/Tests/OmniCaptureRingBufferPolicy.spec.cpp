@@ -0,0 +1,307 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureRingBuffer.h"
+
+#include "Async/Async.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformTime.h"
+
+#include <atomic>
+
+namespace
+{
+    TUniquePtr<FOmniCaptureFrame> MakeSyntheticFrame(int32 FrameIndex, bool bKeyFrame = false, const FIntPoint& Size = FIntPoint::ZeroValue)
+    {
+        TUniquePtr<FOmniCaptureFrame> Frame = MakeUnique<FOmniCaptureFrame>();
+        Frame->Metadata.FrameIndex = FrameIndex;
+        Frame->Metadata.bKeyFrame = bKeyFrame;
+
+        if (Size.X > 0 && Size.Y > 0)
+        {
+            TUniquePtr<TImagePixelData<FColor>> Pixels = MakeUnique<TImagePixelData<FColor>>(Size);
+            Pixels->Pixels.Init(FColor(static_cast<uint8>(FrameIndex), 0, 0, 255), static_cast<int64>(Size.X) * Size.Y);
+            Frame->PixelData = MoveTemp(Pixels);
+            Frame->PixelDataType = EOmniCapturePixelDataType::Color8;
+        }
+
+        return Frame;
+    }
+
+    // Pushes a plug frame and holds the only consumer inside it, so every later push meets a ring
+    // that nothing drains until the frames have all been offered. Returns the committed frames in order.
+    // A non-negative GateReleaseSeconds releases the consumer from another thread after that delay,
+    // for pushes that block until it runs again.
+    FOmniCaptureRingBufferStats RunStalledRingBuffer(const FOmniCaptureSettings& InSettings, TArray<TUniquePtr<FOmniCaptureFrame>>&& Frames, TArray<TUniquePtr<FOmniCaptureFrame>>& OutCommitted, float GateReleaseSeconds = -1.0f)
+    {
+        FOmniCaptureSettings Settings = InSettings;
+        Settings.RingBufferConsumerCount = 1;
+
+        FEvent* Started = FPlatformProcess::GetSynchEventFromPool();
+        FEvent* Gate = FPlatformProcess::GetSynchEventFromPool(true);
+        FOmniCaptureRingBufferStats Stats;
+        {
+            FOmniCaptureRingBuffer RingBuffer;
+            RingBuffer.Initialize(Settings,
+                [Started, Gate](FOmniCaptureFrame&)
+                {
+                    Started->Trigger();
+                    Gate->Wait();
+                },
+                [&OutCommitted](TUniquePtr<FOmniCaptureFrame>&& Frame)
+                {
+                    OutCommitted.Add(MoveTemp(Frame));
+                });
+
+            RingBuffer.Enqueue(MakeSyntheticFrame(0, true));
+            Started->Wait();
+
+            TFuture<void> Release;
+            if (GateReleaseSeconds >= 0.0f)
+            {
+                Release = Async(EAsyncExecution::Thread, [Gate, GateReleaseSeconds]()
+                {
+                    FPlatformProcess::Sleep(GateReleaseSeconds);
+                    Gate->Trigger();
+                });
+            }
+
+            for (TUniquePtr<FOmniCaptureFrame>& Frame : Frames)
+            {
+                RingBuffer.Enqueue(MoveTemp(Frame));
+            }
+
+            Stats = RingBuffer.GetStats();
+            Gate->Trigger();
+            if (Release.IsValid())
+            {
+                Release.Wait();
+            }
+        }
+
+        FPlatformProcess::ReturnSynchEventToPool(Started);
+        FPlatformProcess::ReturnSynchEventToPool(Gate);
+        return Stats;
+    }
+
+    TArray<int32> GetFrameIndices(const TArray<TUniquePtr<FOmniCaptureFrame>>& Frames)
+    {
+        TArray<int32> Indices;
+        for (const TUniquePtr<FOmniCaptureFrame>& Frame : Frames)
+        {
+            Indices.Add(Frame->Metadata.FrameIndex);
+        }
+        return Indices;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRingBufferDropNewestTest, "OmniCapture.RingBuffer.PolicyDropNewest", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRingBufferDropNewestTest::RunTest(const FString& Parameters)
+{
+    FOmniCaptureSettings Settings;
+    Settings.RingBufferCapacity = 2;
+    Settings.RingBufferPolicy = EOmniCaptureRingBufferPolicy::DropNewest;
+
+    TArray<TUniquePtr<FOmniCaptureFrame>> Frames;
+    for (int32 FrameIndex = 1; FrameIndex <= 4; ++FrameIndex)
+    {
+        Frames.Add(MakeSyntheticFrame(FrameIndex));
+    }
+
+    TArray<TUniquePtr<FOmniCaptureFrame>> Committed;
+    const FOmniCaptureRingBufferStats Stats = RunStalledRingBuffer(Settings, MoveTemp(Frames), Committed);
+
+    TestEqual(TEXT("Frames arriving at a full ring are dropped"), Stats.DroppedFrames, 2);
+    TestTrue(TEXT("The earliest frames are kept, contiguous"), GetFrameIndices(Committed) == TArray<int32>({ 0, 1, 2 }));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRingBufferPreserveKeyframesTest, "OmniCapture.RingBuffer.PolicyPreserveKeyframes", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRingBufferPreserveKeyframesTest::RunTest(const FString& Parameters)
+{
+    FOmniCaptureSettings Settings;
+    Settings.RingBufferCapacity = 2;
+    Settings.RingBufferPolicy = EOmniCaptureRingBufferPolicy::PreserveKeyframes;
+
+    // 1 and 4 are keyframes. 2 and 3 are each evicted by the next push; 5 meets a ring of keyframes.
+    TArray<TUniquePtr<FOmniCaptureFrame>> Frames;
+    Frames.Add(MakeSyntheticFrame(1, true));
+    Frames.Add(MakeSyntheticFrame(2));
+    Frames.Add(MakeSyntheticFrame(3));
+    Frames.Add(MakeSyntheticFrame(4, true));
+    Frames.Add(MakeSyntheticFrame(5));
+
+    TArray<TUniquePtr<FOmniCaptureFrame>> Committed;
+    const FOmniCaptureRingBufferStats Stats = RunStalledRingBuffer(Settings, MoveTemp(Frames), Committed);
+
+    TestEqual(TEXT("Only non-keyframes are dropped"), Stats.DroppedFrames, 3);
+    TestTrue(TEXT("Every keyframe is committed, in order"), GetFrameIndices(Committed) == TArray<int32>({ 0, 1, 4 }));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRingBufferDegradeTest, "OmniCapture.RingBuffer.PolicyDegrade", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRingBufferDegradeTest::RunTest(const FString& Parameters)
+{
+    // 1.5 MB frames against a 2 MB budget. 2 only fits once halved; 3 does not fit even halved,
+    // so after the (zero) block timeout the oldest frame makes room.
+    const FIntPoint FrameSize(768, 512);
+
+    FOmniCaptureSettings Settings;
+    Settings.RingBufferCapacity = 8;
+    Settings.RingBufferPolicy = EOmniCaptureRingBufferPolicy::Degrade;
+    Settings.RingBufferMemoryBudgetMB = 2;
+    Settings.RingBufferBlockTimeoutMs = 0.0f;
+
+    TArray<TUniquePtr<FOmniCaptureFrame>> Frames;
+    for (int32 FrameIndex = 1; FrameIndex <= 3; ++FrameIndex)
+    {
+        Frames.Add(MakeSyntheticFrame(FrameIndex, false, FrameSize));
+    }
+
+    TArray<TUniquePtr<FOmniCaptureFrame>> Committed;
+    const FOmniCaptureRingBufferStats Stats = RunStalledRingBuffer(Settings, MoveTemp(Frames), Committed);
+
+    TestEqual(TEXT("Only the incoming frames are degraded"), Stats.DegradedFrames, 2);
+    TestEqual(TEXT("A frame that does not fit even halved costs the oldest"), Stats.DroppedFrames, 1);
+    TestTrue(TEXT("The rest are committed in order"), GetFrameIndices(Committed) == TArray<int32>({ 0, 2, 3 }));
+
+    for (int32 Index = 1; Index < Committed.Num(); ++Index)
+    {
+        const FImagePixelData* PixelData = Committed[Index]->PixelData.Get();
+        if (!TestNotNull(TEXT("Degraded frame keeps its pixels"), PixelData))
+        {
+            continue;
+        }
+
+        TestTrue(TEXT("Degraded frame is half size"), PixelData->GetSize() == FrameSize / 2);
+        const TImagePixelData<FColor>* Typed = static_cast<const TImagePixelData<FColor>*>(PixelData);
+        TestEqual(TEXT("Box filter keeps a flat colour"), Typed->Pixels[0], FColor(static_cast<uint8>(Committed[Index]->Metadata.FrameIndex), 0, 0, 255));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRingBufferDegradeCountOnlyTest, "OmniCapture.RingBuffer.PolicyDegradeWithoutBudget", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRingBufferDegradeCountOnlyTest::RunTest(const FString& Parameters)
+{
+    // With no byte budget, halving cannot free a slot: Degrade falls back to BlockProducer.
+    const FIntPoint FrameSize(64, 64);
+
+    FOmniCaptureSettings Settings;
+    Settings.RingBufferCapacity = 2;
+    Settings.RingBufferPolicy = EOmniCaptureRingBufferPolicy::Degrade;
+    Settings.RingBufferBlockTimeoutMs = 0.0f;
+
+    TArray<TUniquePtr<FOmniCaptureFrame>> Frames;
+    for (int32 FrameIndex = 1; FrameIndex <= 4; ++FrameIndex)
+    {
+        Frames.Add(MakeSyntheticFrame(FrameIndex, false, FrameSize));
+    }
+
+    TArray<TUniquePtr<FOmniCaptureFrame>> Committed;
+    const FOmniCaptureRingBufferStats Stats = RunStalledRingBuffer(Settings, MoveTemp(Frames), Committed);
+
+    TestEqual(TEXT("Nothing is degraded"), Stats.DegradedFrames, 0);
+    TestEqual(TEXT("Timed-out pushes drop the oldest frame"), Stats.DroppedFrames, 2);
+    TestTrue(TEXT("The newest frames are committed in order"), GetFrameIndices(Committed) == TArray<int32>({ 0, 3, 4 }));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRingBufferKeyframeStallTest, "OmniCapture.RingBuffer.PolicyPreserveKeyframesStalls", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRingBufferKeyframeStallTest::RunTest(const FString& Parameters)
+{
+    FOmniCaptureSettings Settings;
+    Settings.RingBufferCapacity = 2;
+    Settings.RingBufferPolicy = EOmniCaptureRingBufferPolicy::PreserveKeyframes;
+    Settings.RingBufferBlockTimeoutMs = 5.0f;
+
+    // A ring of keyframes and a stalled consumer: keyframe 3 waits well past the timeout for the
+    // consumer to come back rather than evicting 1.
+    TArray<TUniquePtr<FOmniCaptureFrame>> Frames;
+    for (int32 FrameIndex = 1; FrameIndex <= 3; ++FrameIndex)
+    {
+        Frames.Add(MakeSyntheticFrame(FrameIndex, true));
+    }
+
+    TArray<TUniquePtr<FOmniCaptureFrame>> Committed;
+    const FOmniCaptureRingBufferStats Stats = RunStalledRingBuffer(Settings, MoveTemp(Frames), Committed, 0.05f);
+
+    TestEqual(TEXT("The keyframe push blocked once"), Stats.BlockedPushes, 1);
+    TestTrue(TEXT("The keyframe push outlasted the block timeout"), Stats.MaxBlockedMilliseconds >= 40.0);
+    TestEqual(TEXT("No keyframe is dropped"), Stats.DroppedFrames, 0);
+    TestTrue(TEXT("Every keyframe is committed, in order"), GetFrameIndices(Committed) == TArray<int32>({ 0, 1, 2, 3 }));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureRingBufferPolicyStressTest, "OmniCapture.RingBuffer.PoliciesWithConcurrentConsumers", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureRingBufferPolicyStressTest::RunTest(const FString& Parameters)
+{
+    // 256 KB frames against four slots and a 1 MB budget keep the ring full while four consumers
+    // race the producer, which is when the eviction policies cycle entries through the ring.
+    constexpr int32 FrameCount = 300;
+    const FIntPoint FrameSize(256, 256);
+    const EOmniCaptureRingBufferPolicy Policies[] =
+    {
+        EOmniCaptureRingBufferPolicy::DropOldest,
+        EOmniCaptureRingBufferPolicy::BlockProducer,
+        EOmniCaptureRingBufferPolicy::DropNewest,
+        EOmniCaptureRingBufferPolicy::PreserveKeyframes,
+        EOmniCaptureRingBufferPolicy::Degrade
+    };
+
+    for (const EOmniCaptureRingBufferPolicy Policy : Policies)
+    {
+        const FString PolicyName = StaticEnum<EOmniCaptureRingBufferPolicy>()->GetNameStringByValue(static_cast<int64>(Policy));
+
+        FOmniCaptureSettings Settings;
+        Settings.RingBufferCapacity = 4;
+        Settings.RingBufferConsumerCount = 4;
+        Settings.RingBufferMemoryBudgetMB = 1;
+        Settings.RingBufferBlockTimeoutMs = 1.0f;
+        Settings.RingBufferPolicy = Policy;
+
+        std::atomic<int32> CommittedCount{ 0 };
+        std::atomic<int32> OrderViolations{ 0 };
+        int32 LastCommitted = -1;
+
+        FOmniCaptureRingBuffer RingBuffer;
+        RingBuffer.Initialize(Settings,
+            [](FOmniCaptureFrame&)
+            {
+                FPlatformProcess::YieldThread();
+            },
+            [&CommittedCount, &OrderViolations, &LastCommitted](TUniquePtr<FOmniCaptureFrame>&& Frame)
+            {
+                // Commits are serialized, so LastCommitted needs no lock of its own.
+                if (Frame->Metadata.FrameIndex <= LastCommitted)
+                {
+                    OrderViolations.fetch_add(1);
+                }
+                LastCommitted = Frame->Metadata.FrameIndex;
+                CommittedCount.fetch_add(1);
+            });
+
+        for (int32 FrameIndex = 0; FrameIndex < FrameCount; ++FrameIndex)
+        {
+            RingBuffer.Enqueue(MakeSyntheticFrame(FrameIndex, FrameIndex % 3 == 0, FrameSize));
+        }
+
+        // Every frame must either commit or leave a gap marker; a lost frame stalls the commit order.
+        const double DeadlineSeconds = FPlatformTime::Seconds() + 30.0;
+        while (CommittedCount.load() + RingBuffer.GetStats().DroppedFrames < FrameCount && FPlatformTime::Seconds() < DeadlineSeconds)
+        {
+            FPlatformProcess::Sleep(0.001f);
+        }
+
+        const FOmniCaptureRingBufferStats Stats = RingBuffer.GetStats();
+        TestEqual(FString::Printf(TEXT("%s: every frame is committed or dropped"), *PolicyName), CommittedCount.load() + Stats.DroppedFrames, FrameCount);
+        TestEqual(FString::Printf(TEXT("%s: commits stay in frame order"), *PolicyName), OrderViolations.load(), 0);
+        TestEqual(FString::Printf(TEXT("%s: nothing is left queued"), *PolicyName), Stats.PendingFrames, 0);
+        TestEqual(FString::Printf(TEXT("%s: queued bytes return to zero"), *PolicyName), Stats.QueuedBytes, 0ll);
+    }
+
+    return true;
+}
@@ -0,0 +1,85 @@
+#include "Misc/AutomationTest.h"
+
+#include "OmniCaptureWorkerPool.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureWorkerPoolRunsEveryTaskTest, "OmniCapture.WorkerPool.RunsEveryTaskAcrossWorkers", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureWorkerPoolRunsEveryTaskTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 WorkerCount = 3;
+    constexpr int32 TaskCount = 300;
+
+    TAtomic<int32> Completed(0);
+    TAtomic<int32> Active(0);
+    TAtomic<int32> PeakActive(0);
+    TArray<TFuture<bool>> Futures;
+    {
+        FOmniCaptureWorkerPool Pool(TEXT("OmniCaptureWorkerPoolTest"), WorkerCount, TPri_Normal, 0);
+        TestEqual(TEXT("Pool starts the requested workers"), Pool.GetNumWorkers(), WorkerCount);
+
+        for (int32 TaskIndex = 0; TaskIndex < TaskCount; ++TaskIndex)
+        {
+            Futures.Add(Pool.Submit([&, TaskIndex]()
+            {
+                const int32 NowActive = Active.IncrementExchange() + 1;
+                int32 Peak = PeakActive.Load();
+                while (NowActive > Peak && !PeakActive.CompareExchange(Peak, NowActive))
+                {
+                }
+
+                FPlatformProcess::Sleep(0.0005f);
+                Active.DecrementExchange();
+                Completed.IncrementExchange();
+                return TaskIndex % 2 == 0;
+            }));
+        }
+
+        Pool.WaitUntilIdle();
+        TestEqual(TEXT("Idle pool has no outstanding tasks"), Pool.GetOutstandingTaskCount(), 0);
+    }
+
+    TestEqual(TEXT("Every task ran"), Completed.Load(), TaskCount);
+    TestTrue(TEXT("Tasks never exceed the worker count"), PeakActive.Load() <= WorkerCount);
+
+    int32 Mismatched = 0;
+    for (int32 TaskIndex = 0; TaskIndex < Futures.Num(); ++TaskIndex)
+    {
+        Mismatched += Futures[TaskIndex].Get() != (TaskIndex % 2 == 0) ? 1 : 0;
+    }
+    TestEqual(TEXT("Futures carry each task's result"), Mismatched, 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOmniCaptureWorkerPoolBacklogTest, "OmniCapture.WorkerPool.BacklogWaitAndShutdownDrain", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FOmniCaptureWorkerPoolBacklogTest::RunTest(const FString& Parameters)
+{
+    FEvent* Gate = FPlatformProcess::GetSynchEventFromPool(true);
+    TAtomic<int32> Completed(0);
+    {
+        FOmniCaptureWorkerPool Pool(TEXT("OmniCaptureWorkerPoolTest"), 1, TPri_Normal, 0);
+        for (int32 TaskIndex = 0; TaskIndex < 4; ++TaskIndex)
+        {
+            Pool.Enqueue([Gate, &Completed]()
+            {
+                Gate->Wait();
+                Completed.IncrementExchange();
+            });
+        }
+
+        TestEqual(TEXT("Held tasks stay outstanding"), Pool.GetOutstandingTaskCount(), 4);
+        Gate->Trigger();
+        Pool.WaitForBacklogAtMost(2);
+        TestTrue(TEXT("Backlog wait returns once enough tasks finish"), Pool.GetOutstandingTaskCount() <= 2);
+
+        // The rest are run by the destructor.
+        Pool.Enqueue([&Completed]() { Completed.IncrementExchange(); });
+    }
+    FPlatformProcess::ReturnSynchEventToPool(Gate);
+
+    TestEqual(TEXT("Destruction drains the queue"), Completed.Load(), 5);
+
+    return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Cube face lookup kernels shared by the CPU reprojection paths.
+ *
+ * A lookup maps a direction to a packed sample: the top three bits hold the cube face
+ * (0..5, same order as the capture rig) and the remaining bits the texel index inside
+ * that face. The vector path runs four directions per iteration on SSE or NEON; the
+ * scalar path is the reference it is validated against.
+ */
+struct OMNICAPTURE_API FOmniCaptureCubemapKernels
+{
+    static constexpr uint32 FaceShift = 29;
+    static constexpr uint32 TexelMask = (1u << FaceShift) - 1u;
+    static constexpr uint32 InvalidSample = MAX_uint32;
+
+    static FORCEINLINE uint32 PackSample(uint32 FaceIndex, uint32 TexelIndex)
+    {
+        return (FaceIndex << FaceShift) | (TexelIndex & TexelMask);
+    }
+
+    static FORCEINLINE uint32 GetFaceIndex(uint32 Sample)
+    {
+        return Sample >> FaceShift;
+    }
+
+    static FORCEINLINE uint32 GetTexelIndex(uint32 Sample)
+    {
+        return Sample & TexelMask;
+    }
+
+    /** True when every texel index of a face with this edge length fits in a packed sample. */
+    static bool SupportsFaceResolution(int32 FaceResolution);
+
+    /**
+     * Scalar reference lookup for a single direction.
+     *
+     * @param X, Y, Z                  Direction components; need not be normalized.
+     * @param FaceResolution           Edge length of each cube face in texels.
+     * @param SeamStrength             Seam blend (0..1) pulling samples towards texel centres at face edges.
+     * @return                         Packed face / texel sample.
+     */
+    static uint32 LookupTexelScalar(float X, float Y, float Z, int32 FaceResolution, float SeamStrength);
+
+    /**
+     * Projects a direction onto its cube face without quantizing to a texel, for filtered sampling.
+     *
+     * @param X, Y, Z                  Direction components; need not be normalized.
+     * @param FaceResolution           Edge length of each cube face in texels.
+     * @param SeamStrength             Seam blend (0..1), applied as in LookupTexelScalar.
+     * @param OutU, OutV               Receive the face coordinates in [0, 1].
+     * @return                         Cube face index.
+     */
+    static uint32 ProjectToFaceScalar(float X, float Y, float Z, int32 FaceResolution, float SeamStrength, float& OutU, float& OutV);
+
+    /**
+     * Vectorized lookup over structure-of-arrays directions. Matches LookupTexelScalar lane for lane.
+     *
+     * @param DirX, DirY, DirZ         Direction components, Count entries each.
+     * @param Count                    Number of directions.
+     * @param FaceResolution           Edge length of each cube face in texels.
+     * @param SeamStrength             Seam blend (0..1).
+     * @param OutSamples               Receives Count packed samples.
+     */
+    static void LookupTexels(const float* DirX, const float* DirY, const float* DirZ, int32 Count, int32 FaceResolution, float SeamStrength, uint32* OutSamples);
+};
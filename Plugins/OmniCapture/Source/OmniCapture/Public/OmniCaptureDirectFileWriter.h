@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+/**
+ * Writes one file sequentially through large, page-aligned blocks, bypassing the OS page cache
+ * where the platform allows (FILE_FLAG_NO_BUFFERING on Windows, O_DIRECT on Linux, F_NOCACHE on
+ * Mac), so fast NVMe arrays are not held up by cache churn and write-back stalls.
+ *
+ * Small serializes, such as libpng's chunk callbacks, are gathered into the current block and
+ * only whole blocks reach the disk. The file is preallocated from an estimated size and trimmed
+ * to the bytes actually written on Close. If the volume rejects unbuffered I/O or its sector size
+ * does not fit the block alignment, the writer reopens the file buffered and carries on.
+ */
+class OMNICAPTURE_API FOmniCaptureDirectFileWriter final : public FArchive
+{
+public:
+    static constexpr int64 Alignment = 4096;
+    static constexpr int64 MaxBlockBytes = 4ll * 1024ll * 1024ll;
+
+    FOmniCaptureDirectFileWriter();
+    virtual ~FOmniCaptureDirectFileWriter() override;
+
+    // Creates or replaces the file. EstimatedSize preallocates it and sizes the block; 0 skips both.
+    bool Open(const FString& InFilePath, int64 EstimatedSize, bool bUnbuffered = true);
+    // Writes a complete file in one call.
+    static bool WriteFile(const FString& FilePath, const TArray64<uint8>& Data, bool bUnbuffered = true);
+
+    // False once the writer has fallen back to buffered I/O, or was never unbuffered.
+    bool IsUnbuffered() const { return bDirect; }
+
+    virtual void Serialize(void* Data, int64 Length) override;
+    // Blocks reach the file as they fill; the tail is written by Close.
+    virtual void Flush() override {}
+    virtual bool Close() override;
+    virtual int64 Tell() override { return TotalBytes; }
+    virtual int64 TotalSize() override { return TotalBytes; }
+    virtual FString GetArchiveName() const override { return FilePath; }
+
+private:
+    bool OpenHandle(bool bUnbuffered, bool bTruncate);
+    void CloseHandle();
+    bool Preallocate(int64 Size);
+    // Writes the first Bytes of the block at the current file offset.
+    bool WriteBlock(int64 Bytes);
+    bool WriteToHandle(const uint8* Data, int64 Bytes, bool& bOutAlignmentRejected);
+    bool Truncate(int64 Size);
+
+    FString FilePath;
+    uint8* Block = nullptr;
+    int64 BlockBytes = 0;
+    int64 BlockUsed = 0;
+    int64 FileOffset = 0;
+    int64 TotalBytes = 0;
+    bool bDirect = false;
+    bool bOpen = false;
+
+#if PLATFORM_WINDOWS
+    void* FileHandle = nullptr;
+#else
+    int FileDescriptor = -1;
+#endif
+};
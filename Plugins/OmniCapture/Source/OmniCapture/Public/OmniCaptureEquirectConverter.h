@@ -12,7 +12,11 @@ class FTextureRenderTargetResource;
 struct FOmniCaptureEquirectResult
 {
     TUniquePtr<FImagePixelData> PixelData;
+    // Band producer the CPU fallback hands out instead of PixelData when asked to stream.
+    TSharedPtr<IOmniCaptureRowSource, ESPMode::ThreadSafe> RowSource;
+    // Downsampled sRGB preview, only produced when the conversion asks for one.
     TArray<FColor> PreviewPixels;
+    FIntPoint PreviewSize = FIntPoint::ZeroValue;
     FIntPoint Size = FIntPoint::ZeroValue;
     bool bIsLinear = false;
     bool bUsedCPUFallback = false;
@@ -28,8 +32,16 @@ struct FOmniCaptureEquirectResult
 class OMNICAPTURE_API FOmniCaptureEquirectConverter
 {
 public:
-    static FOmniCaptureEquirectResult ConvertToEquirectangular(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye);
-    static FOmniCaptureEquirectResult ConvertToFisheye(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye);
-    static FOmniCaptureEquirectResult ConvertToPlanar(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& SourceEye);
+    // With bStreamRows the CPU fallback returns a RowSource rather than a full canvas.
+    static FOmniCaptureEquirectResult ConvertToEquirectangular(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, bool bGeneratePreview = false, bool bStreamRows = false);
+    static FOmniCaptureEquirectResult ConvertToFisheye(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& LeftEye, const FOmniEyeCapture& RightEye, bool bGeneratePreview = false, bool bStreamRows = false);
+    static FOmniCaptureEquirectResult ConvertToPlanar(const FOmniCaptureSettings& Settings, const FOmniEyeCapture& SourceEye, bool bGeneratePreview = false);
+
+    // Cube faces and face regions the projection in Settings can sample. Everything
+    // else is skipped by the rig and by the CPU readback.
+    static FOmniCaptureFaceCoverage ComputeFaceCoverage(const FOmniCaptureSettings& Settings);
+
+    // Frees the cached CPU reprojection tables; they are rebuilt on demand.
+    static void ReleaseCachedResources();
 };
 
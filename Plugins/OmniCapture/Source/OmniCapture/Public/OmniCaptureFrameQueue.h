@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Fixed-capacity lock-free FIFO built on a ring of sequence-numbered slots.
+ *
+ * Capacity is enforced by the ring itself: TryEnqueue fails once every slot is occupied.
+ * Dequeue is safe from any number of threads, so a producer can evict the oldest entry
+ * while consumers drain. Enqueue assumes a single producer unless bMultiProducer is set,
+ * in which case producers claim slots with a compare-exchange.
+ */
+template <typename ElementType, bool bMultiProducer = false>
+class TOmniCaptureBoundedQueue
+{
+public:
+    explicit TOmniCaptureBoundedQueue(int32 InCapacity)
+        : Capacity(FMath::Max(1, InCapacity))
+        , Slots(MakeUnique<FSlot[]>(Capacity))
+    {
+        for (int32 Index = 0; Index < Capacity; ++Index)
+        {
+            Slots[Index].Sequence.store(static_cast<uint64>(Index), std::memory_order_relaxed);
+        }
+    }
+
+    TOmniCaptureBoundedQueue(const TOmniCaptureBoundedQueue&) = delete;
+    TOmniCaptureBoundedQueue& operator=(const TOmniCaptureBoundedQueue&) = delete;
+
+    int32 GetCapacity() const
+    {
+        return Capacity;
+    }
+
+    /** Moves Item into the queue. Returns false, leaving Item untouched, when the ring is full. */
+    bool TryEnqueue(ElementType&& Item)
+    {
+        FSlot* Slot = nullptr;
+        uint64 Position = EnqueuePosition.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            Slot = &Slots[Position % Capacity];
+            const int64 Difference = static_cast<int64>(Slot->Sequence.load(std::memory_order_acquire) - Position);
+
+            if (Difference == 0)
+            {
+                if constexpr (bMultiProducer)
+                {
+                    if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else
+                {
+                    EnqueuePosition.store(Position + 1, std::memory_order_relaxed);
+                    break;
+                }
+            }
+            else if (Difference < 0)
+            {
+                // The slot still holds an entry from the previous lap.
+                return false;
+            }
+            else
+            {
+                Position = EnqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        Slot->Value = MoveTemp(Item);
+        Slot->Sequence.store(Position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Moves the oldest entry into OutItem. Returns false when nothing is ready. */
+    bool TryDequeue(ElementType& OutItem)
+    {
+        FSlot* Slot = nullptr;
+        uint64 Position = DequeuePosition.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            Slot = &Slots[Position % Capacity];
+            const int64 Difference = static_cast<int64>(Slot->Sequence.load(std::memory_order_acquire) - (Position + 1));
+
+            if (Difference == 0)
+            {
+                if (DequeuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (Difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                Position = DequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        OutItem = MoveTemp(Slot->Value);
+        Slot->Sequence.store(Position + Capacity, std::memory_order_release);
+        return true;
+    }
+
+    /** Entries claimed and not yet dequeued. Exact only while no other thread is mid-operation. */
+    int32 Num() const
+    {
+        const uint64 Dequeued = DequeuePosition.load(std::memory_order_acquire);
+        const uint64 Enqueued = EnqueuePosition.load(std::memory_order_acquire);
+        return Enqueued > Dequeued ? static_cast<int32>(FMath::Min<uint64>(Enqueued - Dequeued, Capacity)) : 0;
+    }
+
+    bool IsEmpty() const
+    {
+        return Num() == 0;
+    }
+
+private:
+    struct FSlot
+    {
+        std::atomic<uint64> Sequence{ 0 };
+        ElementType Value;
+    };
+
+    const int32 Capacity;
+    TUniquePtr<FSlot[]> Slots;
+
+    // Producer and consumer positions live on separate cache lines so they do not false-share.
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePosition{ 0 };
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> DequeuePosition{ 0 };
+};
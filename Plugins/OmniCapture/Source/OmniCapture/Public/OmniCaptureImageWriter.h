@@ -5,6 +5,14 @@
 #include "Async/Future.h"
 #include "Templates/Function.h"
 #include "ImageWriteTypes.h"
+#include "Containers/Queue.h"
+
+#include <atomic>
+
+class FEvent;
+class FOmniCapturePackedSequenceWriter;
+class FOmniCaptureRawContainerWriter;
+class FOmniCaptureWorkerPool;
 
 class OMNICAPTURE_API FOmniCaptureImageWriter
 {
@@ -14,8 +22,17 @@ public:
 
     void Initialize(const FOmniCaptureSettings& Settings, const FString& InOutputDirectory);
     void EnqueueFrame(TUniquePtr<FOmniCaptureFrame>&& Frame, const FString& FrameFileName);
+    // EnqueueFrame split in two so writes can be dispatched out of order: SubmitFrame takes the
+    // frame's pixels and starts the write (safe from several threads), RecordFrame appends the
+    // manifest entry and should be called in frame order.
+    bool SubmitFrame(FOmniCaptureFrame& Frame, const FString& FrameFileName);
+    void RecordFrame(const FOmniCaptureFrameMetadata& Metadata);
     void Flush();
+    // Blocks until every submitted frame has been written, without stopping the writer.
+    void WaitForPendingWrites();
     const TArray<FOmniCaptureFrameMetadata>& GetCapturedFrames() const { return CapturedMetadata; }
+    // Frames or layers that failed to encode or reach disk so far.
+    int32 GetFailedWriteCount() const { return FailedWriteCount.Load(); }
     TArray<FOmniCaptureFrameMetadata> ConsumeCapturedFrames();
 
 private:
@@ -28,7 +45,15 @@ private:
         EOmniCapturePixelDataType PixelDataType = EOmniCapturePixelDataType::Unknown;
     };
 
+    // OmniRaw: appends the frame to the capture's container instead of writing a file per frame.
+    bool SubmitRawFrame(FOmniCaptureFrame& Frame);
     bool WritePixelDataToDisk(TUniquePtr<FImagePixelData> PixelData, const FString& FilePath, EOmniCaptureImageFormat Format, bool bIsLinear, EOmniCapturePixelPrecision PixelPrecision, EOmniCapturePixelDataType PixelDataType) const;
+    // File-write stage: hands an encoded image to the file threads, or writes it in place when there are none.
+    bool SaveEncodedFile(TArray64<uint8>&& EncodedData, const FString& FilePath) const;
+    // Writes an encoded image to its own file, or appends it to the packed sequence.
+    bool WriteEncodedFile(const TArray64<uint8>& EncodedData, const FString& FilePath) const;
+    // Archive for encoders that stream straight to disk; EstimatedSize lets unbuffered writers preallocate.
+    TUniquePtr<FArchive> CreateImageFileWriter(const FString& FilePath, int64 EstimatedSize) const;
     bool WritePNGRaw(const FString& FilePath, const FIntPoint& Size, const void* RawData, int64 RawSizeInBytes, ERGBFormat Format, int32 BitDepth) const;
     bool WritePNGWithRowSource(const FString& FilePath, const FIntPoint& Size, ERGBFormat Format, int32 BitDepth, TFunctionRef<void(int32 RowStart, int32 RowCount, int64 BytesPerRow, TArray64<uint8>& TempBuffer, TArray<uint8*>& RowPointers)> PrepareRows) const;
     bool WritePNG(const TImagePixelData<FColor>& PixelData, const FString& FilePath) const;
@@ -40,17 +65,24 @@ private:
     bool WriteJPEG(const TImagePixelData<FColor>& PixelData, const FString& FilePath) const;
     bool WriteJPEGFromLinear(const TImagePixelData<FFloat16Color>& PixelData, const FString& FilePath) const;
     bool WriteJPEGFromLinearFloat32(const TImagePixelData<FLinearColor>& PixelData, const FString& FilePath) const;
+    bool WriteQOI(const TImagePixelData<FColor>& PixelData, const FString& FilePath) const;
+    bool WriteQOIFromLinear(const TImagePixelData<FFloat16Color>& PixelData, const FString& FilePath) const;
+    bool WriteQOIFromLinearFloat32(const TImagePixelData<FLinearColor>& PixelData, const FString& FilePath) const;
     bool WriteEXR(TUniquePtr<FImagePixelData> PixelData, const FString& FilePath, EOmniCapturePixelPrecision PixelPrecision, EOmniCapturePixelDataType PixelDataType) const;
     bool WriteEXRFromColor(const TImagePixelData<FColor>& PixelData, const FString& FilePath) const;
     bool WriteEXRInternal(TUniquePtr<FImagePixelData> PixelData, const FString& FilePath, EImagePixelType PixelType) const;
     bool WriteEXRFrame(const FString& FilePath, bool bIsLinear, TUniquePtr<FImagePixelData> PixelData, EOmniCapturePixelPrecision PixelPrecision, EOmniCapturePixelDataType PixelDataType, TMap<FName, FOmniCaptureLayerPayload>&& AuxiliaryLayers, const FString& LayerDirectory, const FString& LayerBaseName, const FString& LayerExtension) const;
     bool WriteCombinedEXR(const FString& FilePath, TArray<FExrLayerRequest>& Layers) const;
+    bool CanStreamRows(EOmniCaptureImageFormat Format, bool bHasAuxiliaryLayers) const;
+    bool WritePNGFromRowSource(const IOmniCaptureRowSource& Source, const FString& FilePath, bool bIsLinear) const;
+    bool WriteEXRFromRowSource(const IOmniCaptureRowSource& Source, const FString& FilePath, bool bIsLinear, EOmniCapturePixelDataType PixelDataType) const;
     void RequestStop();
     bool IsStopRequested() const;
-    void WaitForAvailableTaskSlot();
-    void TrackPendingTask(TFuture<bool>&& TaskFuture);
-    void PruneCompletedTasks();
-    void EnforcePendingTaskLimit();
+    // Counting semaphore over MaxPendingTasks: any finished task frees a slot, whatever its age.
+    bool AcquireTaskSlot();
+    void ReleaseTaskSlot();
+    void ReportFailedWrite(const FString& FilePath) const;
+    void DrainFailedWrites();
     void WaitForAllTasks();
 
     bool bInitialized = false;
@@ -58,16 +90,33 @@ private:
     FString SequenceBaseName;
     EOmniCaptureImageFormat TargetFormat = EOmniCaptureImageFormat::PNG;
     EOmniCapturePNGBitDepth TargetPNGBitDepth = EOmniCapturePNGBitDepth::BitDepth32;
+    EOmniCapturePNGCompression TargetPNGCompression = EOmniCapturePNGCompression::Default;
     int32 MaxPendingTasks = 8;
+    bool bParallelPNGCompression = false;
+    int32 ParallelPNGThreadCount = 0;
+    bool bParallelQOIEncoding = false;
+    int32 ParallelQOIThreadCount = 0;
     bool bPackEXRAuxiliaryLayers = true;
     bool bUseEXRMultiPart = false;
+    bool bUnbufferedWrites = false;
     EOmniCaptureEXRCompression TargetEXRCompression = EOmniCaptureEXRCompression::Zip;
 
     TArray<FOmniCaptureFrameMetadata> CapturedMetadata;
     FCriticalSection MetadataCS;
 
-    TArray<TFuture<bool>> PendingTasks;
-    FCriticalSection PendingTasksCS;
+    std::atomic<int32> FreeTaskSlots{ 0 };
+    FEvent* TaskSlotFreedEvent = nullptr;
     TAtomic<bool> bStopRequested;
+
+    // Workers push the paths they failed to write; producers drain and log them.
+    mutable TQueue<FString, EQueueMode::Mpsc> FailedWrites;
+    FCriticalSection FailedWritesCS;
+    TAtomic<int32> FailedWriteCount;
+
+    // Encode tasks compress frames; they hand finished files to the file-write pool when there is one.
+    TUniquePtr<FOmniCaptureWorkerPool> EncodePool;
+    TUniquePtr<FOmniCaptureWorkerPool> FileWritePool;
+    TUniquePtr<FOmniCaptureRawContainerWriter> RawContainer;
+    TUniquePtr<FOmniCapturePackedSequenceWriter> PackedSequence;
 };
 
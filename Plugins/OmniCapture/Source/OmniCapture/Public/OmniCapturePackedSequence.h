@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+
+struct FOmniCapturePackedEntry
+{
+    // File name the frame or layer would have had on its own, e.g. "Take_000042.png".
+    FString FileName;
+    int64 Offset = 0;
+    int64 Size = 0;
+};
+
+/**
+ * Packs encoded image files (PNG, JPEG, EXR, ...) into .omnipack chunk files, so an image sequence
+ * creates one file per FilesPerPack frames and layers instead of one per image.
+ *
+ * A pack is the tag "OPAK", the files back to back, then an index: per file its name, offset and
+ * size, followed by a 16-byte footer holding the index offset, the entry count and the tag "OPKX".
+ * Packs are numbered "<BaseName>_pack<NNNN>.omnipack" in the order they fill; files land in the
+ * order they are added. Thread-safe.
+ */
+class OMNICAPTURE_API FOmniCapturePackedSequenceWriter
+{
+public:
+    FOmniCapturePackedSequenceWriter(const FString& InDirectory, const FString& InBaseName, int32 InFilesPerPack);
+    ~FOmniCapturePackedSequenceWriter();
+
+    bool AddFile(const FString& FileName, const TArray64<uint8>& Data);
+    // Finishes the open pack. Later files start a new one.
+    bool Close();
+
+    static FString GetPackFileName(const FString& BaseName, int32 PackIndex);
+    // Packs of one sequence in a directory, in pack order.
+    static TArray<FString> FindPacks(const FString& Directory, const FString& BaseName);
+
+private:
+    bool FinishPack();
+
+    FCriticalSection PackCS;
+    FString Directory;
+    FString BaseName;
+    int32 FilesPerPack = 1;
+    int32 NextPackIndex = 0;
+    TUniquePtr<IFileHandle> PackFile;
+    FString PackPath;
+    TArray<FOmniCapturePackedEntry> Entries;
+    int64 WriteOffset = 0;
+    // Set when a file write failed part-way; FinishPack then trims the pack back to WriteOffset.
+    bool bPackFailed = false;
+};
+
+/** Reads the index of a finished .omnipack and the files stored in it. ReadEntry is thread-safe. */
+class OMNICAPTURE_API FOmniCapturePackedSequenceReader
+{
+public:
+    bool Open(const FString& InPackPath);
+
+    const TArray<FOmniCapturePackedEntry>& GetEntries() const { return Entries; }
+    const FString& GetPackPath() const { return PackPath; }
+    bool ReadEntry(int32 Index, TArray64<uint8>& OutData) const;
+
+private:
+    mutable FCriticalSection ReadCS;
+    TUniquePtr<IFileHandle> PackFile;
+    FString PackPath;
+    TArray<FOmniCapturePackedEntry> Entries;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+struct FOmniCapturePNGEncodeOptions
+{
+    // 1 (grey), 2 (grey + alpha), 3 (RGB) or 4 (RGBA).
+    int32 Channels = 4;
+    // 8 or 16. 16-bit samples are supplied in native byte order.
+    int32 BitDepth = 8;
+    // Rows hold B, G, R(, A) rather than R, G, B(, A).
+    bool bBGROrder = false;
+    // zlib level, 0-9.
+    int32 CompressionLevel = 6;
+    // -1 picks a filter per row with libpng's heuristic; 0-4 forces that PNG filter type on every row.
+    int32 FixedFilter = -1;
+    // 0 uses every task graph worker.
+    int32 ThreadCount = 0;
+    // Filtered bytes per strip. Smaller strips spread better over threads but each one
+    // ends in a flush marker and restarts the match search.
+    int64 StripBytes = 512 * 1024;
+};
+
+/**
+ * PNG encoder that filters and deflates horizontal strips of the image concurrently.
+ *
+ * Each strip is compressed as an independent raw deflate block sequence, primed with the last
+ * 32 KB of the strip before it and ended on a byte boundary, so the strips concatenate into one
+ * zlib stream. Per-strip Adler-32 sums are combined for the stream trailer. The result is a
+ * plain PNG any decoder reads.
+ */
+struct OMNICAPTURE_API FOmniCaptureParallelPNGEncoder
+{
+    // Same contract as the libpng row writer: fill RowPointers[0, RowCount) for rows starting at
+    // RowStart, using TempBuffer as scratch if needed. Only called from the encoding thread.
+    using FPrepareRows = TFunctionRef<void(int32 RowStart, int32 RowCount, int64 BytesPerRow, TArray64<uint8>& TempBuffer, TArray<uint8*>& RowPointers)>;
+
+    static bool SupportsFormat(int32 Channels, int32 BitDepth);
+
+    /**
+     * Encodes a complete PNG file into OutPNG.
+     *
+     * @param Size                     Image size in pixels.
+     * @param Options                  Pixel layout, compression level and parallelism.
+     * @param PrepareRows              Supplies source rows, a strip at a time, in order.
+     * @param ShouldAbort              Polled between batches of strips; returning true abandons the encode.
+     * @param OutPNG                   Receives the file contents.
+     * @return                         False if the layout is unsupported, zlib fails or the encode was abandoned.
+     */
+    static bool Encode(const FIntPoint& Size, const FOmniCapturePNGEncodeOptions& Options, FPrepareRows PrepareRows, TFunctionRef<bool()> ShouldAbort, TArray64<uint8>& OutPNG);
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+
+template <typename PixelType> struct TOmniCapturePixelDataTypeOf;
+template <> struct TOmniCapturePixelDataTypeOf<FColor> { static constexpr EOmniCapturePixelDataType Value = EOmniCapturePixelDataType::Color8; };
+template <> struct TOmniCapturePixelDataTypeOf<FFloat16Color> { static constexpr EOmniCapturePixelDataType Value = EOmniCapturePixelDataType::LinearColorFloat16; };
+template <> struct TOmniCapturePixelDataTypeOf<FLinearColor> { static constexpr EOmniCapturePixelDataType Value = EOmniCapturePixelDataType::LinearColorFloat32; };
+template <> struct TOmniCapturePixelDataTypeOf<float> { static constexpr EOmniCapturePixelDataType Value = EOmniCapturePixelDataType::ScalarFloat32; };
+template <> struct TOmniCapturePixelDataTypeOf<FVector2f> { static constexpr EOmniCapturePixelDataType Value = EOmniCapturePixelDataType::Vector2Float32; };
+
+/**
+ * Recycles frame-sized pixel allocations between captures of the same resolution.
+ *
+ * Converters acquire buffers here instead of allocating; writers and encoders hand them back
+ * once the pixels are on disk or in the encoder. Free buffers are keyed by size and pixel type
+ * and capped by a per-key count and a total byte budget, past which returns are simply freed.
+ * Thread-safe.
+ */
+class OMNICAPTURE_API FOmniCapturePixelBufferPool
+{
+public:
+    static FOmniCapturePixelBufferPool& Get();
+
+    // Frees the pooled buffers and resets the stats. A count of 0 disables pooling.
+    void Configure(int32 InMaxBuffersPerKey, int64 InMaxPooledBytes);
+
+    // Returns a buffer of Size.X * Size.Y uninitialized pixels.
+    template <typename PixelType>
+    TUniquePtr<TImagePixelData<PixelType>> Acquire(const FIntPoint& Size)
+    {
+        TArray64<PixelType> Pixels;
+        TUniquePtr<FImagePixelData> Pooled = TakeFreeBuffer(Size, TOmniCapturePixelDataTypeOf<PixelType>::Value);
+        if (Pooled.IsValid())
+        {
+            Pixels = MoveTemp(static_cast<TImagePixelData<PixelType>*>(Pooled.Get())->Pixels);
+        }
+
+        Pixels.SetNumUninitialized(static_cast<int64>(Size.X) * Size.Y, EAllowShrinking::No);
+        return MakeUnique<TImagePixelData<PixelType>>(Size, MoveTemp(Pixels));
+    }
+
+    // Takes back a finished buffer. Unknown types are inferred from the pixel data.
+    void Release(TUniquePtr<FImagePixelData>&& PixelData, EOmniCapturePixelDataType PixelDataType);
+    // Releases the frame's canvas and auxiliary layers.
+    void ReleaseFrame(FOmniCaptureFrame& Frame);
+    // Frees every pooled buffer.
+    void Trim();
+
+    FOmniCapturePixelPoolStats GetStats() const;
+
+private:
+    struct FPoolKey
+    {
+        FIntPoint Size = FIntPoint::ZeroValue;
+        EOmniCapturePixelDataType PixelDataType = EOmniCapturePixelDataType::Unknown;
+
+        bool operator==(const FPoolKey& Other) const
+        {
+            return Size == Other.Size && PixelDataType == Other.PixelDataType;
+        }
+
+        friend uint32 GetTypeHash(const FPoolKey& Key)
+        {
+            return HashCombine(GetTypeHash(Key.Size), GetTypeHash(static_cast<uint8>(Key.PixelDataType)));
+        }
+    };
+
+    struct FPooledBuffer
+    {
+        TUniquePtr<FImagePixelData> PixelData;
+        int64 Bytes = 0;
+    };
+
+    TUniquePtr<FImagePixelData> TakeFreeBuffer(const FIntPoint& Size, EOmniCapturePixelDataType PixelDataType);
+
+    mutable FCriticalSection PoolCS;
+    TMap<FPoolKey, TArray<FPooledBuffer>> FreeBuffers;
+    int32 MaxBuffersPerKey = 4;
+    int64 MaxPooledBytes = 1024ll * 1024 * 1024;
+    FOmniCapturePixelPoolStats Stats;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Row kernels that turn linear float or half pixels into the 8 and 16 bit layouts the image
+ * writers hand to libpng, libjpeg and the BMP/QOI encoders.
+ *
+ * Half inputs are resolved through 64K-entry tables indexed by the raw half bits, built once
+ * from the scalar references below, so they match those references exactly. Float inputs are
+ * narrowed to half first (F16C where the build allows it) and share the same tables for sRGB,
+ * which keeps them within one LSB of FLinearColor::ToFColor(true). Output is BGRA, the memory
+ * layout of FColor, so 8-bit rows can be written straight into FColor buffers.
+ */
+struct OMNICAPTURE_API FOmniCapturePixelKernels
+{
+    /** Scalar sRGB reference the 8-bit kernels are validated against. */
+    static FORCEINLINE FColor ToSRGB8Scalar(const FLinearColor& Linear)
+    {
+        return Linear.ToFColor(true);
+    }
+
+    /** Scalar 16-bit reference: clamps to [0, 1] and rounds to the nearest code. */
+    static FORCEINLINE uint16 ToUNorm16Scalar(float Value)
+    {
+        const float Clamped = FMath::Clamp(Value, 0.0f, 1.0f);
+        return static_cast<uint16>(FMath::RoundToInt(Clamped * 65535.0f));
+    }
+
+    /** Single-pixel sRGB encode through the half tables, for callers that sample one texel at a time. */
+    static FColor ToSRGB8(const FFloat16Color& Pixel);
+    static FColor ToSRGB8(const FLinearColor& Pixel);
+
+    /** Widens Count half pixels to float. Exact. */
+    static void HalfToFloat(const FFloat16Color* Src, int64 Count, FLinearColor* Dst);
+
+    /** Encodes Count linear pixels to 8-bit sRGB colour with linear alpha. */
+    static void LinearToSRGB8(const FLinearColor* Src, int64 Count, FColor* Dst);
+    static void LinearToSRGB8(const FFloat16Color* Src, int64 Count, FColor* Dst);
+
+    /** Quantizes Count linear pixels to 16 bits per channel, written as B, G, R, A (4 * Count values). */
+    static void LinearToUNorm16BGRA(const FLinearColor* Src, int64 Count, uint16* Dst);
+    static void LinearToUNorm16BGRA(const FFloat16Color* Src, int64 Count, uint16* Dst);
+
+    /** Expands Count 8-bit pixels to 16 bits per channel (x * 257), written as B, G, R, A. */
+    static void SRGB8ToUNorm16BGRA(const FColor* Src, int64 Count, uint16* Dst);
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FOmniCaptureQOIEncodeOptions
+{
+    // Encode bands of rows independently and append a chunk index after the end marker.
+    bool bChunked = false;
+    // Pixels per chunk, rounded to whole rows. Fixed so the file does not depend on the thread count.
+    int64 ChunkPixels = 256 * 1024;
+    // 0 uses every task graph worker.
+    int32 ThreadCount = 0;
+};
+
+/**
+ * Encoder and decoder for the QOI ("Quite OK Image") format, 8-bit RGBA.
+ *
+ * Chunked files stay plain QOI: every chunk but the first opens with a full RGBA pixel and only
+ * indexes colours it has seen itself, so a standard reader decodes the chunks back to back while
+ * a reader that knows the index can start at any chunk from a fresh decoder state. The index sits
+ * after the end marker, where standard readers stop: a big-endian 64-bit file offset per chunk,
+ * then the rows per chunk and the chunk count as 32-bit values, then the tag "oqix".
+ */
+struct OMNICAPTURE_API FOmniCaptureQOIEncoder
+{
+    /**
+     * Encodes a complete QOI file into OutQOI.
+     *
+     * @param Size                     Image size in pixels.
+     * @param Pixels                   Size.X * Size.Y pixels, row-major, top row first.
+     * @param Options                  Chunking and parallelism.
+     * @param OutQOI                   Receives the file contents.
+     * @return                         False if the size is empty or too large for the header.
+     */
+    static bool Encode(const FIntPoint& Size, const FColor* Pixels, const FOmniCaptureQOIEncodeOptions& Options, TArray64<uint8>& OutQOI);
+
+    /** Decodes a QOI file, chunks in parallel when it carries an index. False if the data is malformed. */
+    static bool Decode(const uint8* Data, int64 DataSize, FIntPoint& OutSize, TArray64<FColor>& OutPixels);
+
+    /** Reads the chunk index of a chunked file. False for plain single-stream files. */
+    static bool ReadChunkIndex(const uint8* Data, int64 DataSize, int32& OutChunkRows, TArray<int64>& OutChunkOffsets);
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OmniCaptureTypes.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+
+// One pixel plane stored in the container: the frame's canvas or an auxiliary layer.
+struct FOmniCaptureRawPlane
+{
+    // NAME_None for the frame's own canvas.
+    FName LayerName;
+    FIntPoint Size = FIntPoint::ZeroValue;
+    EOmniCapturePixelDataType PixelDataType = EOmniCapturePixelDataType::Unknown;
+    EOmniCapturePixelPrecision Precision = EOmniCapturePixelPrecision::Unknown;
+    bool bLinear = false;
+    // Page-aligned file offset of the raw pixels.
+    int64 Offset = 0;
+    int64 SizeInBytes = 0;
+};
+
+struct FOmniCaptureRawFrameEntry
+{
+    FOmniCaptureFrameMetadata Metadata;
+    TArray<FOmniCaptureRawPlane, TInlineAllocator<1>> Planes;
+};
+
+/**
+ * Appends frames to an .omniraw container, uncompressed.
+ *
+ * Layout: a one-page header, then every plane's pixels exactly as they sit in memory, each starting
+ * on a page boundary, then the frame index and the capture settings as JSON. The header points at
+ * the index, so a container is only readable once Close has written it. The file is extended ahead
+ * of the write position in large steps, keeping it contiguous on disk, and trimmed on close.
+ * Thread-safe; frames land in the order AppendFrame is called, the index keeps their frame numbers.
+ */
+class OMNICAPTURE_API FOmniCaptureRawContainerWriter
+{
+public:
+    ~FOmniCaptureRawContainerWriter();
+
+    bool Open(const FString& InFilePath, const FString& InSettingsJson);
+    // Writes the frame's canvas and auxiliary layers. The frame keeps its buffers.
+    bool AppendFrame(const FOmniCaptureFrame& Frame);
+    // Writes the index and header. Returns false if any write failed.
+    bool Close();
+
+    bool IsOpen() const { return FileHandle.IsValid(); }
+    const FString& GetFilePath() const { return FilePath; }
+
+private:
+    bool WritePadded(const void* Data, int64 SizeInBytes);
+    bool EnsureReserved(int64 EndOffset);
+
+    FCriticalSection WriteCS;
+    TUniquePtr<IFileHandle> FileHandle;
+    FString FilePath;
+    FString SettingsJson;
+    TArray<FOmniCaptureRawFrameEntry> Frames;
+    int64 WriteOffset = 0;
+    int64 ReservedBytes = 0;
+    bool bCanReserve = true;
+    bool bWriteFailed = false;
+};
+
+/**
+ * Reads frames back from a finished .omniraw container. The file is memory-mapped when the
+ * platform allows, so ReadFrame is safe to call from several threads at once.
+ */
+class OMNICAPTURE_API FOmniCaptureRawContainerReader
+{
+public:
+    ~FOmniCaptureRawContainerReader();
+
+    bool Open(const FString& InFilePath);
+    void Close();
+
+    int32 GetFrameCount() const { return Frames.Num(); }
+    const FOmniCaptureRawFrameEntry& GetFrameEntry(int32 Index) const { return Frames[Index]; }
+    // The FOmniCaptureSettings the capture ran with, as written by FJsonObjectConverter.
+    const FString& GetSettingsJson() const { return SettingsJson; }
+
+    // Fills the frame's metadata, canvas and auxiliary layers. Buffers come from the pixel pool.
+    bool ReadFrame(int32 Index, FOmniCaptureFrame& OutFrame) const;
+
+private:
+    bool ReadBytes(int64 Offset, int64 SizeInBytes, void* Dest) const;
+
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    // Used instead of the mapping where the platform cannot map files.
+    TUniquePtr<IFileHandle> FileHandle;
+    mutable FCriticalSection ReadCS;
+    int64 FileSize = 0;
+    FString SettingsJson;
+    TArray<FOmniCaptureRawFrameEntry> Frames;
+};
@@ -51,6 +51,9 @@ struct FOmniEyeCapture
     FOmniCaptureFaceResources Faces[6];
     int32 ActiveFaceCount = 0;
 
+    // Culled faces keep their render target but are not re-rendered.
+    FOmniCaptureFaceCoverage Coverage;
+
     UTextureRenderTarget2D* GetPrimaryRenderTarget() const
     {
         return ActiveFaceCount > 0 ? Faces[0].RenderTarget : nullptr;
@@ -108,5 +111,6 @@ private:
     TArray<UTextureRenderTarget2D*> RenderTargets;
 
     FOmniCaptureSettings CachedSettings;
+    FOmniCaptureFaceCoverage FaceCoverage;
 };
 
@@ -1,38 +1,91 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OmniCaptureFrameQueue.h"
 #include "OmniCaptureTypes.h"
 
+#include <atomic>
+
 class FRunnableThread;
 class FOmniCaptureRingBufferWorker;
 
 class OMNICAPTURE_API FOmniCaptureRingBuffer
 {
 public:
+    struct FQueuedFrame
+    {
+        uint64 Sequence = 0;
+        int64 Bytes = 0;
+        bool bDegraded = false;
+        TUniquePtr<FOmniCaptureFrame> Frame;
+    };
+
+    using FFrameQueue = TOmniCaptureBoundedQueue<FQueuedFrame>;
+
     FOmniCaptureRingBuffer();
     ~FOmniCaptureRingBuffer();
 
     void Initialize(const FOmniCaptureSettings& Settings, const TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)>& InConsumer);
+    // InProcess runs concurrently on the consumer workers. InCommit then receives every
+    // frame exactly once, one at a time, in the order the frames were enqueued.
+    void Initialize(const FOmniCaptureSettings& Settings, const TFunction<void(FOmniCaptureFrame&)>& InProcess, const TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)>& InCommit);
+    // Single producer: frames must be enqueued from one thread at a time.
     void Enqueue(TUniquePtr<FOmniCaptureFrame>&& Frame);
     void Flush();
     FOmniCaptureRingBufferStats GetStats() const;
 
 private:
-    void StartWorker();
-    void StopWorker();
+    friend class FOmniCaptureRingBufferWorker;
+
+    void StartWorkers(int32 WorkerCount);
+    void StopWorkers();
+    void WakeConsumer();
+    bool TryPush(FQueuedFrame& Queued);
+    bool DequeueFrame(FQueuedFrame& OutQueued);
+    bool WaitForFreeSlot(FQueuedFrame& Queued, double TimeoutMs);
+    void PushDroppingOldest(FQueuedFrame& Queued);
+    void PushPreservingKeyframes(FQueuedFrame& Queued);
+    void PushDegraded(FQueuedFrame& Queued);
+    // Producer only. Visits every queued frame once, oldest first; returning false drops it.
+    void ForEachQueuedFrame(TFunctionRef<bool(FQueuedFrame&)> Visit);
+    void DiscardFrame(FQueuedFrame&& Discarded);
+    void ProcessFrame(FQueuedFrame&& Queued);
+    void CompleteFrame(uint64 Sequence, TUniquePtr<FOmniCaptureFrame>&& Frame, int64 ChargedBytes);
+    void CommitReadyFrames();
 
-    TQueue<TUniquePtr<FOmniCaptureFrame>, EQueueMode::Mpsc> Queue;
-    TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)> Consumer;
+    TUniquePtr<FFrameQueue> Queue;
+    TFunction<void(FOmniCaptureFrame&)> Process;
+    TFunction<void(TUniquePtr<FOmniCaptureFrame>&&)> Commit;
 
-    TUniquePtr<FRunnableThread> WorkerThread;
-    FOmniCaptureRingBufferWorker* Worker = nullptr;
-    FEvent* DataEvent = nullptr;
-    FCriticalSection QueueCriticalSection;
+    TArray<TUniquePtr<FRunnableThread>> WorkerThreads;
+    TArray<FOmniCaptureRingBufferWorker*> Workers;
     TAtomic<bool> bRunning;
-    TAtomic<int32> PendingCount;
     TAtomic<int32> DroppedCount;
     TAtomic<int32> BlockedCount;
-    int32 Capacity = 0;
+    TAtomic<int32> DegradedCount;
+    TAtomic<int64> TotalBlockedMicroseconds;
+    TAtomic<int64> MaxBlockedMicroseconds;
     EOmniCaptureRingBufferPolicy Policy = EOmniCaptureRingBufferPolicy::DropOldest;
-};
+    double BlockTimeoutMs = 100.0;
+
+    // 0 disables the byte budget. InFlightBytes covers frames taken off the queue until they are
+    // committed. Consumers only move bytes from QueuedBytes to InFlightBytes or release them, so
+    // the sum only grows on the producer and checking it before a push cannot race past the budget.
+    int64 MemoryBudgetBytes = 0;
+    TAtomic<int64> QueuedBytes;
+    TAtomic<int64> InFlightBytes;
+    TAtomic<int64> PeakQueuedBytes;
 
+    // Signalled by consumers when they free a slot while the producer is blocked.
+    FEvent* SlotFreedEvent = nullptr;
+    std::atomic<bool> bProducerWaiting{ false };
+    // Only touched by the producer.
+    uint64 NextSequence = 0;
+
+    // Reorder stage: processed frames wait here until every earlier sequence has been
+    // committed. Dropped frames leave a null entry so the sequence keeps advancing.
+    FCriticalSection CommitCS;
+    TMap<uint64, TUniquePtr<FOmniCaptureFrame>> ReadyFrames;
+    uint64 NextCommitSequence = 0;
+    bool bCommitInProgress = false;
+};
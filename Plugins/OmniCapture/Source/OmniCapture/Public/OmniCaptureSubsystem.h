@@ -75,6 +75,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "OmniCapture")
     FOmniCaptureRingBufferStats GetRingBufferStats() const { return LatestRingBufferStats; }
 
+    UFUNCTION(BlueprintCallable, Category = "OmniCapture")
+    FOmniCapturePixelPoolStats GetPixelPoolStats() const;
+
     UFUNCTION(BlueprintCallable, Category = "OmniCapture")
     FOmniAudioSyncStats GetAudioSyncStats() const;
 
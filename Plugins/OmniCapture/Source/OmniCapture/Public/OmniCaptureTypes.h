@@ -59,7 +59,15 @@ enum class EOmniOutputFormat : uint8
 };
 
 UENUM(BlueprintType)
-enum class EOmniCaptureImageFormat : uint8 { PNG, JPG, EXR, BMP };
+enum class EOmniCaptureImageFormat : uint8
+{
+    PNG,
+    JPG,
+    EXR,
+    BMP,
+    QOI,
+    OmniRaw UMETA(DisplayName = "Raw Container", ToolTip = "Uncompressed frames appended to one .omniraw file. Convert offline with the OmniCaptureRawConvert commandlet.")
+};
 
 UENUM(BlueprintType)
 enum class EOmniCaptureEXRCompression : uint8
@@ -80,6 +88,13 @@ enum class EOmniCaptureHDRPrecision : uint8
     FullFloat UMETA(DisplayName = "32-bit Float")
 };
 
+UENUM(BlueprintType)
+enum class EOmniCaptureCPUSamplingQuality : uint8
+{
+    Point UMETA(DisplayName = "Point"),
+    Prefiltered UMETA(DisplayName = "Prefiltered Mips")
+};
+
 enum class EOmniCapturePixelPrecision : uint8
 {
     Unknown,
@@ -108,6 +123,15 @@ enum class EOmniCapturePNGBitDepth : uint8
         BitDepth8 = 2 UMETA(DisplayName = "8-bit Color")
 };
 
+UENUM(BlueprintType)
+enum class EOmniCapturePNGCompression : uint8
+{
+        StoreOnly UMETA(DisplayName = "Store Only", ToolTip = "No compression or filtering. Largest files, least CPU."),
+        Fast UMETA(ToolTip = "zlib level 1 with every row Up-filtered."),
+        Default UMETA(ToolTip = "zlib level 6 with adaptive filtering, as libpng does by default."),
+        Max UMETA(DisplayName = "Smallest", ToolTip = "zlib level 9 with adaptive filtering. Slowest.")
+};
+
 UENUM(BlueprintType)
 enum class EOmniCaptureColorSpace : uint8 { BT709, BT2020, HDR10 };
 
@@ -124,7 +148,10 @@ UENUM(BlueprintType)
 enum class EOmniCaptureState : uint8 { Idle, Recording, Paused, DroppedFrames, Finalizing };
 
 UENUM(BlueprintType)
-enum class EOmniCaptureRingBufferPolicy : uint8 { DropOldest, BlockProducer };
+enum class EOmniCaptureRingBufferPolicy : uint8 { DropOldest, BlockProducer, DropNewest, PreserveKeyframes, Degrade };
+
+UENUM(BlueprintType)
+enum class EOmniCaptureThreadPriority : uint8 { Lowest, BelowNormal, Normal, AboveNormal, Highest };
 
 UENUM(BlueprintType)
 enum class EOmniCapturePreviewView : uint8 { StereoComposite, LeftEye, RightEye };
@@ -218,6 +245,7 @@ struct OMNICAPTURE_API FOmniCaptureSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture") bool bEnablePreviewWindow = true;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0.1, UIMin = 0.1)) float PreviewScreenScale = 1.0f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 1.0, UIMin = 5.0, ClampMax = 240.0)) float PreviewFrameRate = 30.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 64, UIMin = 64, ToolTip = "Longest edge of the preview image in pixels, scaled by PreviewScreenScale.")) int32 PreviewMaxDimension = 1024;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture") bool bRecordAudio = true;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture") float AudioGain = 1.0f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture") TSoftObjectPtr<class USoundSubmix> SubmixToRecord;
@@ -233,6 +261,7 @@ struct OMNICAPTURE_API FOmniCaptureSettings
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") EOmniCaptureImageFormat ImageFormat = EOmniCaptureImageFormat::PNG;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") EOmniCaptureHDRPrecision HDRPrecision = EOmniCaptureHDRPrecision::HalfFloat;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") EOmniCapturePNGBitDepth PNGBitDepth = EOmniCapturePNGBitDepth::BitDepth32;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ToolTip = "PNG speed/size trade-off. Fast suits high frame rates where disk is cheaper than CPU.")) EOmniCapturePNGCompression PNGCompression = EOmniCapturePNGCompression::Default;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") FString OutputDirectory;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") FString OutputFileName = TEXT("OmniCapture");
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") EOmniCaptureColorSpace ColorSpace = EOmniCaptureColorSpace::BT709;
@@ -243,17 +272,37 @@ struct OMNICAPTURE_API FOmniCaptureSettings
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") bool bForceConstantFrameRate = true;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") bool bAllowNVENCFallback = true;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = 1, UIMin = 1)) int32 MaxPendingImageTasks = 8;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = 0, UIMin = 0, ToolTip = "Finished frame buffers kept for reuse per resolution and pixel type. 0 disables pooling.")) int32 PixelPoolMaxBuffersPerSize = 4;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = 0, UIMin = 0, ToolTip = "Total memory, in MB, the frame buffer pool may keep for reuse.")) int32 PixelPoolMaxMB = 2048;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = 0, ClampMax = 64, UIMin = 0, UIMax = 64, ToolTip = "Threads compressing image sequence frames. 0 picks one per pending task, up to the core count minus one.")) int32 ImageEncodeThreadCount = 0;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = 0, ClampMax = 16, UIMin = 0, UIMax = 16, ToolTip = "Threads writing compressed frames to disk, so a slow drive does not hold up compression. Encoded files waiting for these threads stay in memory, up to Max Pending Image Tasks of them. 0 writes from the encode threads.")) int32 ImageFileWriteThreadCount = 0;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ToolTip = "Core mask for the image writer threads. 0 lets the OS schedule them anywhere.")) int64 ImageWriterThreadAffinityMask = 0;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") EOmniCaptureThreadPriority ImageWriterThreadPriority = EOmniCaptureThreadPriority::BelowNormal;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ToolTip = "Compress each PNG in row strips on several threads. Files are standard PNGs, slightly larger than single-threaded output.")) bool bParallelPNGCompression = false;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = 0, ClampMax = 64, UIMin = 0, UIMax = 64, EditCondition = "bParallelPNGCompression", ToolTip = "Threads compressing one PNG. 0 uses every task graph worker.")) int32 ParallelPNGThreadCount = 0;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ToolTip = "Encode each QOI frame in row chunks on several threads and append a chunk index. Standard QOI readers still decode the files.")) bool bParallelQOIEncoding = false;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = 0, ClampMax = 64, UIMin = 0, UIMax = 64, EditCondition = "bParallelQOIEncoding", ToolTip = "Threads encoding one QOI frame. 0 uses every task graph worker.")) int32 ParallelQOIThreadCount = 0;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = 0, UIMin = 0, UIMax = 1000, ToolTip = "Pack this many encoded frames, with their layer files, into one .omnipack file instead of writing a file per image. Cuts file creation on network storage. 0 writes individual files.")) int32 PackedSequenceFramesPerFile = 0;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ToolTip = "Write image files in large aligned blocks that bypass the OS file cache, with space reserved up front. Helps fast NVMe arrays; falls back to normal writes where the volume does not support it.")) bool bUnbufferedImageWrites = false;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Diagnostics", meta = (ClampMin = 0)) int32 MinimumFreeDiskSpaceGB = 2;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Diagnostics", meta = (ClampMin = 0.1, ClampMax = 1.0)) float LowFrameRateWarningRatio = 0.85f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") FString PreferredFFmpegPath;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0.0, ClampMax = 1.0)) float SeamBlend = 0.25f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ClampMin = 0.0, ClampMax = 1.0)) float PolarDampening = 0.5f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture", meta = (ToolTip = "Skip rendering and CPU readback of cube faces (and face regions) the projection never samples, e.g. the rear faces of VR180 or dome captures.")) bool bCullUnusedCubeFaces = true;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|CPU Fallback", meta = (ClampMin = 0, UIMin = 0, ToolTip = "Worker threads used by the CPU reprojection fallback. 0 uses every task graph worker.")) int32 CPUReprojectionWorkerCount = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|CPU Fallback", meta = (ToolTip = "Point sampling reads one face texel per sample. Prefiltered picks a box-filtered face mip from the pixel footprint and samples it bilinearly.")) EOmniCaptureCPUSamplingQuality CPUSamplingQuality = EOmniCaptureCPUSamplingQuality::Point;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|CPU Fallback", meta = (ClampMin = 1, ClampMax = 16, UIMin = 1, UIMax = 16, ToolTip = "Rotated-grid samples per output pixel for the CPU reprojection. Square counts (4, 9, 16) cover the pixel most evenly.")) int32 CPUSupersampleCount = 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capture|CPU Fallback", meta = (ToolTip = "Reproject image sequence frames band by band while the PNG or EXR encoder writes them, so a frame in flight never holds a full canvas. Only used when the CPU fallback runs.")) bool bStreamCPUReprojection = false;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") FOmniCaptureQuality Quality;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") EOmniCaptureCodec Codec = EOmniCaptureCodec::HEVC;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") EOmniCaptureColorFormat NVENCColorFormat = EOmniCaptureColorFormat::NV12;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") bool bZeroCopy = true;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC", meta = (ClampMin = 0, UIMin = 0)) int32 RingBufferCapacity = 6;
-        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") EOmniCaptureRingBufferPolicy RingBufferPolicy = EOmniCaptureRingBufferPolicy::DropOldest;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC", meta = (ClampMin = 0, UIMin = 0, ToolTip = "Memory the queued frames may hold, in MB. The ring buffer policy applies when either this or the frame capacity is exceeded. 0 limits by frame count only.")) int32 RingBufferMemoryBudgetMB = 0;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC", meta = (ToolTip = "What happens when the ring buffer is full. DropOldest and DropNewest lose a frame, BlockProducer stalls the game thread up to the block timeout, PreserveKeyframes drops the oldest non-keyframe, and Degrade halves the resolution of the incoming frame to fit the memory budget. When only keyframes are queued, PreserveKeyframes drops an incoming non-keyframe and stalls for an incoming keyframe until a slot frees. Degrade requires a memory budget (without one it falls back to BlockProducer) and waits like BlockProducer when halving is not enough.")) EOmniCaptureRingBufferPolicy RingBufferPolicy = EOmniCaptureRingBufferPolicy::DropOldest;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC", meta = (ClampMin = 1, ClampMax = 16, UIMin = 1, UIMax = 16, ToolTip = "Worker threads draining the ring buffer. Frames are written concurrently; audio stats, encoder submission and manifest entries are still committed in frame order.")) int32 RingBufferConsumerCount = 1;
+        UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC", meta = (ClampMin = 0, UIMin = 0, UIMax = 1000, ToolTip = "Longest the BlockProducer and Degrade policies stall the game thread waiting for a free slot before they drop the oldest queued frame instead. 0 drops without waiting. PreserveKeyframes never drops a keyframe and logs a warning when it stalls longer than this.")) float RingBufferBlockTimeoutMs = 100.0f;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") FString AVEncoderModulePathOverride;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NVENC") FString NVENCDllPathOverride;
         UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output") bool bOpenPreviewOnFinalize = false;
@@ -274,6 +323,7 @@ struct OMNICAPTURE_API FOmniCaptureSettings
         FIntPoint GetFisheyeResolution() const;
         FIntPoint GetOutputResolution() const;
         FIntPoint GetPerEyeOutputResolution() const;
+        FIntPoint GetPreviewResolution(const FIntPoint& OutputSize) const;
         bool IsStereo() const;
         bool IsVR180() const;
         bool IsFisheye() const;
@@ -284,6 +334,7 @@ struct OMNICAPTURE_API FOmniCaptureSettings
         bool SupportsSphericalMetadata() const;
         bool UseDualFisheyeLayout() const;
         bool ShouldConvertFisheyeToEquirect() const;
+        bool ShouldStreamCPUReprojection() const;
         FString GetStereoModeMetadataTag() const;
         int32 GetEncoderAlignmentRequirement() const;
         float GetHorizontalFOVDegrees() const;
@@ -312,6 +363,17 @@ struct FOmniCaptureFrameMetadata
         UPROPERTY() bool bKeyFrame = false;
 };
 
+// Cube faces, and the texel rectangle inside each, that the active projection
+// can sample. An empty rectangle stands for the whole face.
+struct FOmniCaptureFaceCoverage
+{
+        uint8 FaceMask = 0x3F;
+        FIntRect FaceRects[6];
+
+        bool IsFaceUsed(int32 FaceIndex) const { return (FaceMask & (1u << FaceIndex)) != 0; }
+        int32 GetUsedFaceCount() const { return FMath::CountBits(FaceMask); }
+};
+
 struct FOmniCaptureLayerPayload
 {
         TUniquePtr<FImagePixelData> PixelData;
@@ -320,20 +382,44 @@ struct FOmniCaptureLayerPayload
         EOmniCapturePixelDataType PixelDataType = EOmniCapturePixelDataType::Unknown;
 };
 
+// Produces a frame one horizontal band at a time. Image writers pull bands
+// straight into the encoder, so the full canvas never has to be allocated.
+class IOmniCaptureRowSource
+{
+public:
+        virtual ~IOmniCaptureRowSource() = default;
+
+        virtual FIntPoint GetSize() const = 0;
+
+        // Fills OutPixels with RowCount full rows starting at RowStart. Values are
+        // linear, already quantized to the frame's storage precision.
+        virtual void ReadRows(int32 RowStart, int32 RowCount, TArray64<FLinearColor>& OutPixels) const = 0;
+
+        // Memory the source keeps alive until its rows have been read.
+        virtual int64 GetAllocatedSize() const { return 0; }
+};
+
 struct FOmniCaptureFrame
 {
         FOmniCaptureFrameMetadata Metadata;
         TUniquePtr<FImagePixelData> PixelData;
+        // Set instead of PixelData when the CPU fallback streams rows to the writer.
+        TSharedPtr<IOmniCaptureRowSource, ESPMode::ThreadSafe> RowSource;
         TRefCountPtr<IPooledRenderTarget> GPUSource;
         FTextureRHIRef Texture;
         FGPUFenceRHIRef ReadyFence;
         bool bLinearColor = false;
         bool bUsedCPUFallback = false;
+        // Set by the ring buffer's process stage once the image writer has accepted the frame.
+        bool bSubmittedToImageWriter = false;
         EOmniCapturePixelPrecision PixelPrecision = EOmniCapturePixelPrecision::Unknown;
         EOmniCapturePixelDataType PixelDataType = EOmniCapturePixelDataType::Unknown;
         TArray<FOmniAudioPacket> AudioPackets;
         TArray<FTextureRHIRef> EncoderTextures;
         TMap<FName, FOmniCaptureLayerPayload> AuxiliaryLayers;
+
+        // CPU memory held by the frame: pixels, row source, auxiliary layers and audio.
+        int64 GetAllocatedSize() const;
 };
 
 USTRUCT(BlueprintType)
@@ -343,6 +429,24 @@ struct FOmniCaptureRingBufferStats
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int32 PendingFrames = 0;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int32 DroppedFrames = 0;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int32 BlockedPushes = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") double TotalBlockedMilliseconds = 0.0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") double MaxBlockedMilliseconds = 0.0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int32 DegradedFrames = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int64 QueuedBytes = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int64 PeakQueuedBytes = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FOmniCapturePixelPoolStats
+{
+	GENERATED_BODY()
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int32 Hits = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int32 Misses = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int32 Returned = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int32 Discarded = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int32 PooledBuffers = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int64 PooledBytes = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats") int64 PeakPooledBytes = 0;
 };
 
 USTRUCT(BlueprintType)
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Templates/Function.h"
+
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+
+/**
+ * Fixed set of worker threads draining a FIFO of tasks.
+ *
+ * Owned by the writer that uses it, so its work never queues behind streaming, shader
+ * compilation or anything else on the engine's shared pools, and its threads can be given
+ * their own priority and affinity. Destruction runs every queued task before joining.
+ */
+class OMNICAPTURE_API FOmniCaptureWorkerPool
+{
+public:
+    // An AffinityMask of 0 leaves the threads unpinned.
+    FOmniCaptureWorkerPool(const FString& InName, int32 WorkerCount, EThreadPriority Priority, uint64 AffinityMask);
+    ~FOmniCaptureWorkerPool();
+
+    FOmniCaptureWorkerPool(const FOmniCaptureWorkerPool&) = delete;
+    FOmniCaptureWorkerPool& operator=(const FOmniCaptureWorkerPool&) = delete;
+
+    void Enqueue(TUniqueFunction<void()>&& Task);
+    TFuture<bool> Submit(TUniqueFunction<bool()>&& Task);
+
+    // Blocks until no more than MaxOutstanding tasks are queued or running. Waiters are woken one
+    // at a time as tasks finish, so concurrent waiters with different limits are released in turn.
+    void WaitForBacklogAtMost(int32 MaxOutstanding);
+    void WaitUntilIdle();
+
+    int32 GetNumWorkers() const { return WorkerThreads.Num(); }
+    int32 GetOutstandingTaskCount() const { return OutstandingTasks.GetValue(); }
+
+private:
+    class FWorker;
+
+    bool TryTakeTask(TUniqueFunction<void()>& OutTask);
+    void FinishTask();
+
+    FCriticalSection QueueCS;
+    TArray<TUniqueFunction<void()>> PendingTasks;
+    int32 PendingHead = 0;
+
+    FThreadSafeCounter OutstandingTasks;
+    FEvent* WorkAvailableEvent = nullptr;
+    FEvent* TaskFinishedEvent = nullptr;
+    std::atomic<int32> BacklogWaiters{ 0 };
+    std::atomic<bool> bStopping{ false };
+
+    TArray<FWorker*> Workers;
+    TArray<TUniquePtr<FRunnableThread>> WorkerThreads;
+};
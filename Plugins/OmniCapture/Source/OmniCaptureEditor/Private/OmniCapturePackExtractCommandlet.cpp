@@ -0,0 +1,95 @@
+#include "OmniCapturePackExtractCommandlet.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "OmniCapturePackedSequence.h"
+
+UOmniCapturePackExtractCommandlet::UOmniCapturePackExtractCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UOmniCapturePackExtractCommandlet::Main(const FString& Params)
+{
+    FString InputPath;
+    if (!FParse::Value(*Params, TEXT("Input="), InputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("OmniCapturePackExtract: -Input=<file.omnipack|dir> is required."));
+        return 1;
+    }
+    InputPath = FPaths::ConvertRelativePathToFull(InputPath);
+
+    FString BaseName;
+    FParse::Value(*Params, TEXT("BaseName="), BaseName);
+
+    TArray<FString> PackPaths;
+    FString OutputDirectory;
+    if (IFileManager::Get().DirectoryExists(*InputPath))
+    {
+        OutputDirectory = InputPath;
+        if (!BaseName.IsEmpty())
+        {
+            PackPaths = FOmniCapturePackedSequenceWriter::FindPacks(InputPath, BaseName);
+        }
+        else
+        {
+            TArray<FString> FileNames;
+            IFileManager::Get().FindFiles(FileNames, *(InputPath / TEXT("*.omnipack")), true, false);
+            FileNames.Sort();
+            for (const FString& FileName : FileNames)
+            {
+                PackPaths.Add(InputPath / FileName);
+            }
+        }
+    }
+    else
+    {
+        OutputDirectory = FPaths::GetPath(InputPath);
+        PackPaths.Add(InputPath);
+    }
+
+    FParse::Value(*Params, TEXT("Output="), OutputDirectory);
+    OutputDirectory = FPaths::ConvertRelativePathToFull(OutputDirectory);
+    IFileManager::Get().MakeDirectory(*OutputDirectory, true);
+
+    if (PackPaths.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("OmniCapturePackExtract: no .omnipack files found at %s."), *InputPath);
+        return 1;
+    }
+
+    int32 Extracted = 0;
+    int32 Failures = 0;
+    TArray64<uint8> Data;
+    for (const FString& PackPath : PackPaths)
+    {
+        FOmniCapturePackedSequenceReader Reader;
+        if (!Reader.Open(PackPath))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("OmniCapturePackExtract: could not open %s."), *PackPath);
+            ++Failures;
+            continue;
+        }
+
+        const TArray<FOmniCapturePackedEntry>& Entries = Reader.GetEntries();
+        for (int32 Index = 0; Index < Entries.Num(); ++Index)
+        {
+            // Names come from the pack; never let one step outside the output directory.
+            const FString FilePath = OutputDirectory / FPaths::GetCleanFilename(Entries[Index].FileName);
+            if (!Reader.ReadEntry(Index, Data) || !FFileHelper::SaveArrayToFile(Data, *FilePath))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("OmniCapturePackExtract: failed to extract %s from %s."), *Entries[Index].FileName, *PackPath);
+                ++Failures;
+                continue;
+            }
+            ++Extracted;
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("OmniCapturePackExtract: extracted %d files from %d packs to %s (%d failures)."), Extracted, PackPaths.Num(), *OutputDirectory, Failures);
+    return Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+#include "OmniCaptureRawConvertCommandlet.h"
+
+#include "HAL/PlatformMisc.h"
+#include "JsonObjectConverter.h"
+#include "Misc/Paths.h"
+#include "OmniCaptureImageWriter.h"
+#include "OmniCaptureMuxer.h"
+#include "OmniCaptureRawContainer.h"
+
+namespace
+{
+    bool ParseTargetFormat(const FString& Name, EOmniCaptureImageFormat& OutFormat, bool& bOutVideo)
+    {
+        bOutVideo = Name.Equals(TEXT("Video"), ESearchCase::IgnoreCase);
+        if (bOutVideo || Name.IsEmpty())
+        {
+            OutFormat = EOmniCaptureImageFormat::PNG;
+            return true;
+        }
+
+        const UEnum* Enum = StaticEnum<EOmniCaptureImageFormat>();
+        const int64 Value = Enum ? Enum->GetValueByNameString(Name) : INDEX_NONE;
+        if (Value == INDEX_NONE || Value == static_cast<int64>(EOmniCaptureImageFormat::OmniRaw))
+        {
+            return false;
+        }
+
+        OutFormat = static_cast<EOmniCaptureImageFormat>(Value);
+        return true;
+    }
+}
+
+UOmniCaptureRawConvertCommandlet::UOmniCaptureRawConvertCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UOmniCaptureRawConvertCommandlet::Main(const FString& Params)
+{
+    FString InputPath;
+    if (!FParse::Value(*Params, TEXT("Input="), InputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("OmniCaptureRawConvert: -Input=<file.omniraw> is required."));
+        return 1;
+    }
+    InputPath = FPaths::ConvertRelativePathToFull(InputPath);
+
+    FString OutputDirectory = FPaths::GetPath(InputPath);
+    FParse::Value(*Params, TEXT("Output="), OutputDirectory);
+
+    FString FormatName;
+    FParse::Value(*Params, TEXT("Format="), FormatName);
+    EOmniCaptureImageFormat TargetFormat = EOmniCaptureImageFormat::PNG;
+    bool bMuxVideo = false;
+    if (!ParseTargetFormat(FormatName, TargetFormat, bMuxVideo))
+    {
+        UE_LOG(LogTemp, Error, TEXT("OmniCaptureRawConvert: unknown -Format=%s."), *FormatName);
+        return 1;
+    }
+
+    int32 ThreadCount = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+    FParse::Value(*Params, TEXT("Threads="), ThreadCount);
+    ThreadCount = FMath::Clamp(ThreadCount, 1, 64);
+
+    FString AudioPath;
+    FParse::Value(*Params, TEXT("Audio="), AudioPath);
+
+    int32 FramesPerPack = 0;
+    FParse::Value(*Params, TEXT("Pack="), FramesPerPack);
+    const bool bUnbuffered = FParse::Param(*Params, TEXT("Unbuffered"));
+
+    FOmniCaptureRawContainerReader Reader;
+    if (!Reader.Open(InputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("OmniCaptureRawConvert: could not open %s."), *InputPath);
+        return 1;
+    }
+
+    FOmniCaptureSettings Settings;
+    if (!FJsonObjectConverter::JsonObjectStringToUStruct(Reader.GetSettingsJson(), &Settings))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("OmniCaptureRawConvert: %s carries no readable capture settings; using defaults."), *InputPath);
+        Settings.OutputFileName = FPaths::GetBaseFilename(InputPath);
+    }
+
+    // Offline there is no frame budget: every core encodes and nothing is written from a separate stage.
+    Settings.OutputFormat = EOmniOutputFormat::ImageSequence;
+    Settings.ImageFormat = TargetFormat;
+    Settings.OutputDirectory = FPaths::ConvertRelativePathToFull(OutputDirectory);
+    Settings.ImageEncodeThreadCount = ThreadCount;
+    Settings.ImageFileWriteThreadCount = 0;
+    Settings.MaxPendingImageTasks = ThreadCount * 2;
+    Settings.ImageWriterThreadPriority = EOmniCaptureThreadPriority::Normal;
+    Settings.ImageWriterThreadAffinityMask = 0;
+    // The capture's output layout belongs to the capture volume; convert to plain files unless asked.
+    Settings.PackedSequenceFramesPerFile = FMath::Max(0, FramesPerPack);
+    Settings.bUnbufferedImageWrites = bUnbuffered;
+
+    // The writer records manifest entries in frame order; concurrent capture consumers may have appended out of order.
+    TArray<int32> Order;
+    Order.Reserve(Reader.GetFrameCount());
+    for (int32 Index = 0; Index < Reader.GetFrameCount(); ++Index)
+    {
+        Order.Add(Index);
+    }
+    Order.StableSort([&Reader](int32 A, int32 B)
+    {
+        return Reader.GetFrameEntry(A).Metadata.FrameIndex < Reader.GetFrameEntry(B).Metadata.FrameIndex;
+    });
+
+    FOmniCaptureImageWriter Writer;
+    Writer.Initialize(Settings, Settings.OutputDirectory);
+    const FString Extension = Settings.GetImageFileExtension();
+
+    int32 ReadFailures = 0;
+    for (const int32 Index : Order)
+    {
+        FOmniCaptureFrame Frame;
+        if (!Reader.ReadFrame(Index, Frame))
+        {
+            ++ReadFailures;
+            continue;
+        }
+
+        const FString FileName = FString::Printf(TEXT("%s_%06d%s"), *Settings.OutputFileName, Frame.Metadata.FrameIndex, *Extension);
+        if (Writer.SubmitFrame(Frame, FileName))
+        {
+            Writer.RecordFrame(Frame.Metadata);
+        }
+    }
+
+    Writer.WaitForPendingWrites();
+    const int32 WriteFailures = Writer.GetFailedWriteCount();
+    const TArray<FOmniCaptureFrameMetadata> Frames = Writer.ConsumeCapturedFrames();
+    Writer.Flush();
+
+    UE_LOG(LogTemp, Display, TEXT("OmniCaptureRawConvert: wrote %d of %d frames from %s to %s (%d read, %d write failures)."),
+        Frames.Num() - WriteFailures, Reader.GetFrameCount(), *InputPath, *Settings.OutputDirectory, ReadFailures, WriteFailures);
+
+    bool bSuccess = ReadFailures == 0 && WriteFailures == 0;
+    if (bMuxVideo && Frames.Num() > 0)
+    {
+        FOmniCaptureMuxer Muxer;
+        Muxer.Initialize(Settings, Settings.OutputDirectory);
+        bSuccess &= Muxer.FinalizeCapture(Settings, Frames, AudioPath, FString(), 0);
+    }
+
+    return bSuccess ? 0 : 1;
+}
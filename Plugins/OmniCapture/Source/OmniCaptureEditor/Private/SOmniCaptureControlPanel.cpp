@@ -126,6 +126,10 @@ namespace
             return LOCTEXT("ImageFormatEXR", "EXR Sequence");
         case EOmniCaptureImageFormat::BMP:
             return LOCTEXT("ImageFormatBMP", "BMP Sequence");
+        case EOmniCaptureImageFormat::QOI:
+            return LOCTEXT("ImageFormatQOI", "QOI Sequence");
+        case EOmniCaptureImageFormat::OmniRaw:
+            return LOCTEXT("ImageFormatOmniRaw", "Raw Container (.omniraw)");
         case EOmniCaptureImageFormat::PNG:
         default:
             return LOCTEXT("ImageFormatPNG", "PNG Sequence");
@@ -276,6 +280,8 @@ void SOmniCaptureControlPanel::Construct(const FArguments& InArgs)
     ImageFormatOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureImageFormat>>(EOmniCaptureImageFormat::JPG));
     ImageFormatOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureImageFormat>>(EOmniCaptureImageFormat::EXR));
     ImageFormatOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureImageFormat>>(EOmniCaptureImageFormat::BMP));
+    ImageFormatOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureImageFormat>>(EOmniCaptureImageFormat::QOI));
+    ImageFormatOptions.Add(MakeShared<TEnumOptionValue<EOmniCaptureImageFormat>>(EOmniCaptureImageFormat::OmniRaw));
 
     PNGBitDepthOptions.Reset();
     PNGBitDepthOptions.Add(MakeShared<TEnumOptionValue<EOmniCapturePNGBitDepth>>(EOmniCapturePNGBitDepth::BitDepth8));
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "OmniCapturePackExtractCommandlet.generated.h"
+
+/**
+ * Unpacks .omnipack files back into the individual images they hold.
+ *
+ * -run=OmniCapturePackExtract -Input=<file.omnipack|dir> [-Output=<dir>] [-BaseName=<name>]
+ *
+ * Given a directory, every pack in it is extracted, or only the packs of -BaseName's sequence.
+ * Images keep the file names the capture would have given them unpacked.
+ */
+UCLASS()
+class OMNICAPTUREEDITOR_API UOmniCapturePackExtractCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UOmniCapturePackExtractCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "OmniCaptureRawConvertCommandlet.generated.h"
+
+/**
+ * Converts an .omniraw container into an image sequence, or into a video through FFmpeg.
+ *
+ * -run=OmniCaptureRawConvert -Input=<file.omniraw> [-Output=<dir>] [-Format=PNG|JPG|EXR|BMP|QOI|Video]
+ *     [-Threads=<n>] [-Audio=<file.wav>] [-Pack=<n>] [-Unbuffered]
+ *
+ * Frames are encoded with the capture's own settings, stored in the container, on every core
+ * unless -Threads says otherwise. Video writes a PNG sequence and muxes it like a live capture.
+ * Output is one buffered file per image; -Pack and -Unbuffered opt back into .omnipack files and
+ * unbuffered writes, whatever the capture used.
+ */
+UCLASS()
+class OMNICAPTUREEDITOR_API UOmniCaptureRawConvertCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UOmniCaptureRawConvertCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};